@@ -0,0 +1,314 @@
+/// A ColumnarResult holds the values fetched by a query, column by column, in
+/// contiguous buffers.
+///
+/// Unlike `Row.fetchAll` and `FetchableRecord.fetchAll`, a columnar fetch
+/// does not create any object per fetched row. This makes it suitable for
+/// aggregating large numbers of rows in Swift:
+///
+///     let result = try ColumnarResult.fetch(db, sql: "SELECT score, name FROM player")
+///     let totalScore = result[0].integers?.reduce(0, +)
+///     let names = result["name"]?.texts?.strings
+///
+/// Each column is stored according to the SQLite storage class of its first
+/// non-NULL value (see https://www.sqlite.org/datatype3.html):
+///
+/// - INTEGER values are stored as `[Int64]`
+/// - REAL values are stored as `[Double]`
+/// - TEXT and BLOB values are stored as contiguous bytes and offsets
+///
+/// When a column contains values of different storage classes, the other
+/// values are converted by SQLite, as documented at
+/// https://www.sqlite.org/c3ref/column_blob.html. A column that only contains
+/// NULL values is stored as integers.
+///
+/// Row adapters of fetch requests are ignored: columns are the columns of the
+/// SQL query.
+public struct ColumnarResult {
+    /// The column names, ordered from left to right.
+    public let columnNames: [String]
+    
+    /// The fetched columns, ordered from left to right.
+    public let columns: [ColumnarColumn]
+    
+    /// The number of fetched rows.
+    public let rowCount: Int
+    
+    /// The column at the given index.
+    public subscript(_ index: Int) -> ColumnarColumn {
+        columns[index]
+    }
+    
+    /// The leftmost column with the given name, in a case-insensitive way, or
+    /// nil if no such column exists.
+    public subscript(_ name: String) -> ColumnarColumn? {
+        let lowercaseName = name.lowercased()
+        guard let index = columnNames.firstIndex(where: { $0.lowercased() == lowercaseName }) else {
+            return nil
+        }
+        return columns[index]
+    }
+}
+
+extension ColumnarResult {
+    
+    // MARK: Fetching From SelectStatement
+    
+    /// Returns the columnar result of a prepared statement.
+    ///
+    ///     let statement = try db.makeSelectStatement(sql: "SELECT score FROM player")
+    ///     let result = try ColumnarResult.fetch(statement)
+    ///
+    /// - parameters:
+    ///     - statement: The statement to run.
+    ///     - arguments: Optional statement arguments.
+    /// - returns: A ColumnarResult.
+    /// - throws: A DatabaseError is thrown whenever an SQLite error occurs.
+    public static func fetch(
+        _ statement: SelectStatement,
+        arguments: StatementArguments? = nil)
+    throws -> ColumnarResult
+    {
+        let sqliteStatement = statement.sqliteStatement
+        let columnCount = statement.columnCount
+        var builders = Array(repeating: ColumnBuilder(), count: columnCount)
+        var rowCount = 0
+        let cursor = try statement.makeCursor(arguments: arguments)
+        while try cursor.next() != nil {
+            for index in 0..<columnCount {
+                builders[index].append(from: sqliteStatement, at: Int32(index))
+            }
+            rowCount += 1
+        }
+        return ColumnarResult(
+            columnNames: statement.columnNames,
+            columns: builders.map { $0.makeColumn() },
+            rowCount: rowCount)
+    }
+    
+    // MARK: Fetching From SQL
+    
+    /// Returns the columnar result of an SQL query.
+    ///
+    ///     let result = try ColumnarResult.fetch(db, sql: "SELECT score FROM player")
+    ///
+    /// - parameters:
+    ///     - db: A database connection.
+    ///     - sql: An SQL query.
+    ///     - arguments: Statement arguments.
+    /// - returns: A ColumnarResult.
+    /// - throws: A DatabaseError is thrown whenever an SQLite error occurs.
+    public static func fetch(
+        _ db: Database,
+        sql: String,
+        arguments: StatementArguments = StatementArguments())
+    throws -> ColumnarResult
+    {
+        try fetch(db, SQLRequest<Void>(sql: sql, arguments: arguments))
+    }
+    
+    // MARK: Fetching From FetchRequest
+    
+    /// Returns the columnar result of a fetch request.
+    ///
+    ///     let request = Player.select(Column("score"))
+    ///     let result = try ColumnarResult.fetch(db, request)
+    ///
+    /// - parameters:
+    ///     - db: A database connection.
+    ///     - request: A FetchRequest.
+    /// - returns: A ColumnarResult.
+    /// - throws: A DatabaseError is thrown whenever an SQLite error occurs.
+    public static func fetch<R: FetchRequest>(_ db: Database, _ request: R) throws -> ColumnarResult {
+        let request = try request.makePreparedRequest(db, forSingleResult: false)
+        return try fetch(request.statement)
+    }
+}
+
+/// A column of a `ColumnarResult`.
+public struct ColumnarColumn {
+    /// The storage of column values
+    public enum Values {
+        /// Values stored as 64-bit integers
+        case integers([Int64])
+        
+        /// Values stored as doubles
+        case doubles([Double])
+        
+        /// Values stored as UTF-8 bytes
+        case texts(ColumnarBytes)
+        
+        /// Values stored as bytes
+        case blobs(ColumnarBytes)
+    }
+    
+    /// The column values. NULL values are stored as zero, or empty
+    /// byte sequences.
+    public let values: Values
+    
+    /// The NULL flags of column values, or nil if the column does not contain
+    /// any NULL value.
+    public let nullFlags: [Bool]?
+    
+    /// Returns whether the value at the given row index is NULL.
+    public func isNull(atIndex index: Int) -> Bool {
+        nullFlags?[index] ?? false
+    }
+    
+    /// The integer values, or nil if the column is not stored as integers.
+    public var integers: [Int64]? {
+        if case let .integers(integers) = values { return integers }
+        return nil
+    }
+    
+    /// The double values, or nil if the column is not stored as doubles.
+    public var doubles: [Double]? {
+        if case let .doubles(doubles) = values { return doubles }
+        return nil
+    }
+    
+    /// The text values, or nil if the column is not stored as text.
+    public var texts: ColumnarBytes? {
+        if case let .texts(bytes) = values { return bytes }
+        return nil
+    }
+    
+    /// The blob values, or nil if the column is not stored as blobs.
+    public var blobs: ColumnarBytes? {
+        if case let .blobs(bytes) = values { return bytes }
+        return nil
+    }
+}
+
+/// Variable-length values stored in a single contiguous buffer.
+///
+/// The bytes of the value at index `i` are `bytes[offsets[i]..<offsets[i+1]]`.
+public struct ColumnarBytes: RandomAccessCollection {
+    /// The offsets of values in `bytes`. It contains one more element than
+    /// the number of values.
+    public let offsets: [Int]
+    
+    /// The concatenated bytes of all values.
+    public let bytes: [UInt8]
+    
+    /// :nodoc:
+    public var startIndex: Int { 0 }
+    
+    /// :nodoc:
+    public var endIndex: Int { offsets.count - 1 }
+    
+    /// The bytes of the value at the given index.
+    public subscript(_ index: Int) -> ArraySlice<UInt8> {
+        bytes[offsets[index]..<offsets[index + 1]]
+    }
+    
+    /// Returns the value at the given index, decoded as an UTF-8 string.
+    public func string(atIndex index: Int) -> String {
+        String(decoding: self[index], as: UTF8.self)
+    }
+    
+    /// All values, decoded as UTF-8 strings.
+    public var strings: [String] {
+        indices.map(string(atIndex:))
+    }
+}
+
+// MARK: - ColumnBuilder
+
+/// Accumulates the values of a column.
+private struct ColumnBuilder {
+    private enum Kind {
+        case undetermined
+        case integer
+        case double
+        case text
+        case blob
+    }
+    
+    private var kind = Kind.undetermined
+    private var count = 0
+    private var integers: [Int64] = []
+    private var doubles: [Double] = []
+    private var offsets: [Int] = [0]
+    private var bytes: [UInt8] = []
+    private var nullFlags: [Bool]?
+    
+    mutating func append(from sqliteStatement: SQLiteStatement, at index: Int32) {
+        let type = sqlite3_column_type(sqliteStatement, index)
+        if type == SQLITE_NULL {
+            if nullFlags == nil {
+                nullFlags = Array(repeating: false, count: count)
+            }
+            nullFlags!.append(true)
+            appendPlaceholders(count: 1)
+            count += 1
+            return
+        }
+        
+        if kind == .undetermined {
+            switch type {
+            case SQLITE_INTEGER: kind = .integer
+            case SQLITE_FLOAT: kind = .double
+            case SQLITE_TEXT: kind = .text
+            default: kind = .blob
+            }
+            // Values for previous NULL rows
+            appendPlaceholders(count: count)
+        }
+        
+        nullFlags?.append(false)
+        switch kind {
+        case .integer:
+            integers.append(sqlite3_column_int64(sqliteStatement, index))
+        case .double:
+            doubles.append(sqlite3_column_double(sqliteStatement, index))
+        case .text:
+            // sqlite3_column_text must be called before sqlite3_column_bytes
+            if let text = sqlite3_column_text(sqliteStatement, index) {
+                let length = Int(sqlite3_column_bytes(sqliteStatement, index))
+                bytes.append(contentsOf: UnsafeBufferPointer(start: text, count: length))
+            }
+            offsets.append(bytes.count)
+        case .blob:
+            // sqlite3_column_blob must be called before sqlite3_column_bytes
+            if let blob = sqlite3_column_blob(sqliteStatement, index) {
+                let length = Int(sqlite3_column_bytes(sqliteStatement, index))
+                bytes.append(contentsOf: UnsafeRawBufferPointer(start: blob, count: length))
+            }
+            offsets.append(bytes.count)
+        case .undetermined:
+            fatalError("Unexpected undetermined column kind")
+        }
+        count += 1
+    }
+    
+    private mutating func appendPlaceholders(count: Int) {
+        switch kind {
+        case .undetermined:
+            // Placeholders are appended when the kind is determined.
+            break
+        case .integer:
+            integers.append(contentsOf: repeatElement(0, count: count))
+        case .double:
+            doubles.append(contentsOf: repeatElement(0, count: count))
+        case .text, .blob:
+            offsets.append(contentsOf: repeatElement(bytes.count, count: count))
+        }
+    }
+    
+    func makeColumn() -> ColumnarColumn {
+        let values: ColumnarColumn.Values
+        switch kind {
+        case .undetermined:
+            values = .integers(Array(repeating: 0, count: count))
+        case .integer:
+            values = .integers(integers)
+        case .double:
+            values = .doubles(doubles)
+        case .text:
+            values = .texts(ColumnarBytes(offsets: offsets, bytes: bytes))
+        case .blob:
+            values = .blobs(ColumnarBytes(offsets: offsets, bytes: bytes))
+        }
+        return ColumnarColumn(values: values, nullFlags: nullFlags)
+    }
+}
@@ -137,6 +137,47 @@ public struct Configuration {
         setups.append(setup)
     }
     
+    // MARK: - Statement Cache
+    
+    /// The maximum number of prepared statements retained by each statement
+    /// cache of a database connection, or nil for no limit.
+    ///
+    /// Database connections cache the statements returned by
+    /// `Database.cachedSelectStatement(sql:)` and
+    /// `Database.cachedUpdateStatement(sql:)`, as well as statements used
+    /// internally by GRDB (persistence methods, for example). When a cache is
+    /// full, the least recently used statement is evicted.
+    ///
+    /// Applications that run many different SQL queries on long-lived
+    /// connections can use this property in order to bound memory usage. Use
+    /// `Database.statementCacheStatistics` in order to pick a capacity that
+    /// fits your application.
+    ///
+    /// Default: nil
+    public var statementCacheCapacity: Int? = nil
+    
+    // MARK: - Memory Budget
+    
+    /// The memory budget, or nil for no budget.
+    ///
+    /// When the memory used by SQLite exceeds the limits of the budget,
+    /// database connections progressively release memory. See `MemoryBudget`.
+    ///
+    /// Default: nil
+    public var memoryBudget: MemoryBudget? = nil
+    
+    // MARK: - Profiling
+    
+    /// If true, database connections collect profiling statistics about
+    /// executed statements and transactions.
+    ///
+    /// Profiling has a small cost on each statement execution. Statistics
+    /// are available from `Database.profilingStatistics` and
+    /// `DatabasePool.profilingStatistics`.
+    ///
+    /// Default: false
+    public var profilingEnabled = false
+    
     // MARK: - Transactions
     
     /// The default kind of transaction.
@@ -177,6 +218,45 @@ public struct Configuration {
     /// Default: false
     public var allowsUnsafeTransactions: Bool = false
     
+    // MARK: - Group Commit
+    
+    /// The maximum number of asynchronous writes that are committed together,
+    /// or nil for committing each asynchronous write in its own transaction.
+    ///
+    /// When set, writes scheduled with `DatabaseWriter.asyncWrite(_:completion:)`
+    /// are grouped in a single transaction, so that they share the cost of the
+    /// commit (syncing the database file to disk, notably). Each write runs in
+    /// its own savepoint: a write that throws an error does not prevent other
+    /// writes from being committed. Completion closures are called after the
+    /// shared transaction has completed.
+    ///
+    /// Grouped writes may run after writes that were scheduled later with
+    /// other methods, such as `DatabaseWriter.write(_:)`.
+    ///
+    /// Default: nil
+    public var groupCommitMaximumCount: Int? = nil
+    
+    /// The maximum duration an asynchronous write waits for other writes
+    /// before it is committed. This property only applies when
+    /// `groupCommitMaximumCount` is not nil.
+    ///
+    /// With the default value, zero, writes are grouped only when they are
+    /// scheduled while the database is busy.
+    ///
+    /// Default: 0
+    public var groupCommitMaximumDelay: TimeInterval = 0
+    
+    // MARK: - WAL Checkpoints
+    
+    /// The automatic checkpoint policy (applies to database pools only).
+    ///
+    /// When nil, SQLite runs automatic checkpoints on the writer connection.
+    /// Otherwise, checkpoints run on a dedicated connection, according to
+    /// the policy. See `DatabasePool.CheckpointPolicy`.
+    ///
+    /// Default: nil
+    public var checkpointPolicy: DatabasePool.CheckpointPolicy? = nil
+    
     // MARK: - Concurrency
     
     /// The behavior in case of SQLITE_BUSY error. See https://www.sqlite.org/rescode.html#busy
@@ -194,6 +274,16 @@ public struct Configuration {
     /// Default: 5
     public var maximumReaderCount: Int = 5
     
+    /// The duration after which an unused read-only connection is closed
+    /// (applies to database pools only).
+    ///
+    /// When nil, read-only connections are kept open until the database pool
+    /// is deallocated, `releaseMemory()` is called, or the application enters
+    /// the background on iOS. See `DatabasePool.readerStatistics`.
+    ///
+    /// Default: nil
+    public var readerIdleTimeout: TimeInterval? = nil
+    
     /// The quality of service class for the work performed by the database.
     ///
     /// The quality of service is ignored if you supply a target queue.
@@ -53,8 +53,21 @@ extension Database {
     ///
     /// You may need to clear the cache manually if the database schema is
     /// modified by another connection.
+    ///
+    /// When the database connection belongs to a `DatabasePool`, the schema
+    /// cache of all connections of the pool is cleared.
     public func clearSchemaCache() {
         SchedulingWatchdog.preconditionValidQueue(self)
+        schemaCache.shared?.clear()
+        clearLocalSchemaCache()
+    }
+    
+    /// Clears the schema cache of this connection only.
+    ///
+    /// The shared schema cache of a database pool does not need to be
+    /// cleared after schema changes, because it is versioned by
+    /// `PRAGMA schema_version`.
+    func clearLocalSchemaCache() {
         schemaCache.clear()
         
         // We also clear updateStatementCache and selectStatementCache despite
@@ -63,15 +76,31 @@ extension Database {
         // limited number of times.
         internalStatementCache.clear()
         publicStatementCache.clear()
+        
+        // The SQL generated by query interface requests depends on the
+        // schema (primary keys, unique indexes).
+        sqlQueryCache.clear()
     }
     
     /// Clears the database schema cache if the database schema has changed
     /// since this method was last called.
+    ///
+    /// When the connection uses a shared schema cache, this method also
+    /// clears the cache if the shared cache was cleared, and enables the
+    /// shared cache for the current schema version.
+    ///
+    /// This method must be called at the beginning of each read access, so
+    /// that the schema cache matches the schema of the current snapshot.
     func clearSchemaCacheIfNeeded() throws {
         let schemaVersion = try Int32.fetchOne(internalCachedSelectStatement(sql: "PRAGMA schema_version"))
-        if _lastSchemaVersion != schemaVersion {
+        if _lastSchemaVersion != schemaVersion
+            || schemaCache.sharedGeneration != schemaCache.shared?.generation
+        {
             _lastSchemaVersion = schemaVersion
-            clearSchemaCache()
+            clearLocalSchemaCache()
+        }
+        if schemaCache.shared != nil {
+            schemaCache.sharedSchemaVersion = schemaVersion
         }
     }
     
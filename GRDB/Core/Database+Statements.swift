@@ -84,6 +84,18 @@ extension Database {
         try internalStatementCache.selectStatement(sql)
     }
     
+    /// Statistics about the statement caches of the database connection.
+    ///
+    /// The returned value aggregates the cache used by
+    /// `cachedSelectStatement(sql:)` and `cachedUpdateStatement(sql:)`, and the
+    /// cache used internally by GRDB.
+    ///
+    /// See `Configuration.statementCacheCapacity`.
+    public var statementCacheStatistics: StatementCacheStatistics {
+        SchedulingWatchdog.preconditionValidQueue(self)
+        return publicStatementCache.statistics + internalStatementCache.statistics
+    }
+    
     /// Returns a new prepared statement that can be reused.
     ///
     ///     let statement = try db.makeUpdateStatement(sql: "INSERT INTO player (name) VALUES (?)")
@@ -328,9 +340,11 @@ extension Database {
     
     private func updateStatementDidExecute(_ statement: UpdateStatement) throws {
         if statement.invalidatesDatabaseSchemaCache {
-            clearSchemaCache()
+            clearLocalSchemaCache()
         }
         
+        profiler?.updateStatementDidExecute(isInsideTransaction: isInsideTransaction)
+        
         try observationBroker.updateStatementDidExecute(statement)
     }
     
@@ -343,6 +357,8 @@ extension Database {
         internalStatementCache.remove(statement)
         publicStatementCache.remove(statement)
         
+        profiler?.updateStatementDidExecute(isInsideTransaction: isInsideTransaction)
+        
         try observationBroker.updateStatementDidFail(statement)
     }
     
@@ -366,22 +382,93 @@ extension Database {
         // So make sure we clear this statement from the cache.
         internalStatementCache.remove(statement)
         publicStatementCache.remove(statement)
+        sqlQueryCache.remove(statement)
+    }
+}
+
+/// Statistics about the statement caches of a database connection.
+///
+/// See `Database.statementCacheStatistics` and
+/// `Configuration.statementCacheCapacity`.
+public struct StatementCacheStatistics {
+    /// The number of statements that were found in the cache.
+    public var hitCount = 0
+    
+    /// The number of statements that had to be prepared because they were not
+    /// found in the cache.
+    public var missCount = 0
+    
+    /// The number of statements that were removed from the cache in order to
+    /// honor `Configuration.statementCacheCapacity`.
+    public var evictionCount = 0
+    
+    /// The total time spent preparing statements on cache misses.
+    public var prepareDuration: TimeInterval = 0
+    
+    /// The number of statements currently held by the cache.
+    public var statementCount = 0
+    
+    static func + (lhs: Self, rhs: Self) -> Self {
+        var result = lhs
+        result.hitCount += rhs.hitCount
+        result.missCount += rhs.missCount
+        result.evictionCount += rhs.evictionCount
+        result.prepareDuration += rhs.prepareDuration
+        result.statementCount += rhs.statementCount
+        return result
     }
 }
 
-/// A thread-unsafe statement cache
+/// A thread-unsafe statement cache.
+///
+/// When the capacity is not nil, the least recently used statements are
+/// evicted when the cache is full.
 struct StatementCache {
+    /// A cache entry. It is a class so that a cache hit can update its last
+    /// usage without hashing the sql string a second time.
+    private final class Entry<S: Statement> {
+        let statement: S
+        var lastUse: UInt64
+        
+        init(statement: S, lastUse: UInt64) {
+            self.statement = statement
+            self.lastUse = lastUse
+        }
+    }
+    
     unowned let db: Database
-    private var selectStatements: [String: SelectStatement] = [:]
-    private var updateStatements: [String: UpdateStatement] = [:]
+    private let capacity: Int?
+    private var selectStatements: [String: Entry<SelectStatement>] = [:]
+    private var updateStatements: [String: Entry<UpdateStatement>] = [:]
+    
+    /// Incremented on each cache access, and used to sort entries by
+    /// last usage.
+    private var clock: UInt64 = 0
+    
+    /// The clock of the last call to evictColdStatements()
+    private var coldClock: UInt64 = 0
+    private var _statistics = StatementCacheStatistics()
+    
+    var statistics: StatementCacheStatistics {
+        var statistics = _statistics
+        statistics.statementCount = selectStatements.count + updateStatements.count
+        return statistics
+    }
     
     init(database: Database) {
         self.db = database
+        self.capacity = database.configuration.statementCacheCapacity
+        if let capacity = capacity {
+            GRDBPrecondition(capacity >= 0, "Invalid negative statement cache capacity")
+        }
     }
     
     mutating func selectStatement(_ sql: String) throws -> SelectStatement {
-        if let statement = selectStatements[sql] {
-            return statement
+        clock += 1
+        if let entry = selectStatements[sql] {
+            _statistics.hitCount += 1
+            entry.lastUse = clock
+            return entry.statement
         }
         
         // http://www.sqlite.org/c3ref/c_prepare_persistent.html#sqlitepreparepersistent
@@ -393,6 +480,7 @@ struct StatementCache {
         //
         // However SQLITE_PREPARE_PERSISTENT was only introduced in
         // SQLite 3.20.0 http://www.sqlite.org/changes.html#version_3_20
+        let start = DispatchTime.now()
         #if GRDBCUSTOMSQLITE || GRDBCIPHER
         let statement = try db.makeSelectStatement(sql: sql, prepFlags: SQLITE_PREPARE_PERSISTENT)
         #else
@@ -405,13 +493,19 @@ struct StatementCache {
             statement = try db.makeSelectStatement(sql: sql)
         }
         #endif
-        selectStatements[sql] = statement
+        statementDidPrepare(since: start)
+        if makeRoom() {
+            selectStatements[sql] = Entry(statement: statement, lastUse: clock)
+        }
         return statement
     }
     
     mutating func updateStatement(_ sql: String) throws -> UpdateStatement {
-        if let statement = updateStatements[sql] {
-            return statement
+        clock += 1
+        if let entry = updateStatements[sql] {
+            _statistics.hitCount += 1
+            entry.lastUse = clock
+            return entry.statement
         }
         
         // http://www.sqlite.org/c3ref/c_prepare_persistent.html#sqlitepreparepersistent
@@ -423,6 +517,7 @@ struct StatementCache {
         //
         // However SQLITE_PREPARE_PERSISTENT was only introduced in
         // SQLite 3.20.0 http://www.sqlite.org/changes.html#version_3_20
+        let start = DispatchTime.now()
         #if GRDBCUSTOMSQLITE || GRDBCIPHER
         let statement = try db.makeUpdateStatement(sql: sql, prepFlags: SQLITE_PREPARE_PERSISTENT)
         #else
@@ -435,7 +530,10 @@ struct StatementCache {
             statement = try db.makeUpdateStatement(sql: sql)
         }
         #endif
-        updateStatements[sql] = statement
+        statementDidPrepare(since: start)
+        if makeRoom() {
+            updateStatements[sql] = Entry(statement: statement, lastUse: clock)
+        }
         return statement
     }
     
@@ -444,11 +542,59 @@ struct StatementCache {
         selectStatements = [:]
     }
     
+    /// Evicts the statements that were not used since the previous call to
+    /// this method.
+    mutating func evictColdStatements() {
+        let coldClock = self.coldClock
+        let count = selectStatements.count + updateStatements.count
+        selectStatements = selectStatements.filter { $0.value.lastUse > coldClock }
+        updateStatements = updateStatements.filter { $0.value.lastUse > coldClock }
+        _statistics.evictionCount += count - selectStatements.count - updateStatements.count
+        self.coldClock = clock
+    }
+    
     mutating func remove(_ statement: SelectStatement) {
-        selectStatements.removeFirst { $0.value === statement }
+        selectStatements.removeFirst { $0.value.statement === statement }
     }
     
     mutating func remove(_ statement: UpdateStatement) {
-        updateStatements.removeFirst { $0.value === statement }
+        updateStatements.removeFirst { $0.value.statement === statement }
+    }
+    
+    private mutating func statementDidPrepare(since start: DispatchTime) {
+        let nanoseconds = DispatchTime.now().uptimeNanoseconds - start.uptimeNanoseconds
+        _statistics.missCount += 1
+        _statistics.prepareDuration += TimeInterval(nanoseconds) / 1.0e9
+    }
+    
+    /// Evicts least recently used statements until there is room for a new
+    /// one, and returns whether the new statement can be cached.
+    private mutating func makeRoom() -> Bool {
+        guard let capacity = capacity else {
+            return true
+        }
+        while selectStatements.count + updateStatements.count >= capacity {
+            // Eviction only happens on cache misses, when the cost of the
+            // linear scan below is dwarfed by the cost of sqlite3_prepare.
+            let oldestSelect = selectStatements.min { $0.value.lastUse < $1.value.lastUse }
+            let oldestUpdate = updateStatements.min { $0.value.lastUse < $1.value.lastUse }
+            switch (oldestSelect, oldestUpdate) {
+            case let (select?, update?):
+                if select.value.lastUse < update.value.lastUse {
+                    selectStatements.removeValue(forKey: select.key)
+                } else {
+                    updateStatements.removeValue(forKey: update.key)
+                }
+            case let (select?, nil):
+                selectStatements.removeValue(forKey: select.key)
+            case let (nil, update?):
+                updateStatements.removeValue(forKey: update.key)
+            case (nil, nil):
+                // Capacity is zero
+                return false
+            }
+            _statistics.evictionCount += 1
+        }
+        return true
     }
 }
@@ -123,6 +123,15 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
     /// The last error message
     public var lastErrorMessage: String? { String(cString: sqlite3_errmsg(sqliteConnection)) }
     
+    /// The maximum depth of the parse tree of an expression, or nil if there
+    /// is no limit.
+    ///
+    /// See `SQLITE_LIMIT_EXPR_DEPTH` at https://www.sqlite.org/limits.html
+    var maximumExpressionDepth: Int? {
+        let depth = Int(sqlite3_limit(sqliteConnection, SQLITE_LIMIT_EXPR_DEPTH, -1))
+        return depth > 0 ? depth : nil
+    }
+    
     // MARK: - Internal properties
     
     // Caches
@@ -130,11 +139,38 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
         var schemaIdentifiers: [SchemaIdentifier]?
         fileprivate var schemas: [SchemaIdentifier: DatabaseSchemaCache] = [:]
         
+        /// The cache of the main schema shared by all connections of a
+        /// database pool.
+        var shared: SharedDatabaseSchemaCache?
+        
+        /// The generation of the shared cache when this cache was
+        /// last cleared.
+        var sharedGeneration: Int?
+        
+        /// The schema version read by the connection, when it is allowed to
+        /// use the shared cache.
+        var sharedSchemaVersion: Int32?
+        
         subscript(schemaID: SchemaIdentifier) -> DatabaseSchemaCache { // internal so that it can be tested
             get {
-                schemas[schemaID] ?? DatabaseSchemaCache()
+                if schemaID == .main,
+                   let shared = shared,
+                   let schemaVersion = sharedSchemaVersion,
+                   let cache = shared.cache(forSchemaVersion: schemaVersion)
+                {
+                    return cache
+                }
+                return schemas[schemaID] ?? DatabaseSchemaCache()
             }
             set {
+                if schemaID == .main,
+                   let shared = shared,
+                   let schemaVersion = sharedSchemaVersion,
+                   shared.cache(forSchemaVersion: schemaVersion) != nil
+                {
+                    shared.merge(newValue, forSchemaVersion: schemaVersion)
+                    return
+                }
                 schemas[schemaID] = newValue
             }
         }
@@ -142,6 +178,7 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
         mutating func clear() {
             schemaIdentifiers = nil
             schemas.removeAll()
+            sharedGeneration = shared?.generation
         }
     }
     
@@ -149,6 +186,7 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
     var schemaCache = SchemaCache()
     lazy var internalStatementCache = StatementCache(database: self)
     lazy var publicStatementCache = StatementCache(database: self)
+    var sqlQueryCache = SQLQueryCache()
     
     /// Statement authorizer. Use withAuthorizer(_:_:).
     fileprivate var _authorizer: StatementAuthorizer?
@@ -176,10 +214,16 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
     /// This cache is never cleared: we assume journal mode never changes.
     var journalModeCache: String?
     
+    /// Not nil when configuration.profilingEnabled is true
+    var profiler: DatabaseProfiler?
+    
     // MARK: - Private properties
     
     private var busyCallback: BusyCallback?
     private var trace: ((TraceEvent) -> Void)?
+    private var walCommitHook: ((Int) -> Void)?
+    private var unconstrainedCacheSize: Int? // Support for trimMemory(_:constrainedCacheSize:)
+    private var traceOptions: TracingOptions = []
     private var functions = Set<DatabaseFunction>()
     private var collations = Set<DatabaseCollation>()
     private var _readOnlyDepth = 0 // Modify with beginReadOnly/endReadOnly
@@ -236,6 +280,7 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
         setupDefaultFunctions()
         setupDefaultCollations()
         setupAuthorizer()
+        setupProfiler()
         observationBroker.installCommitAndRollbackHooks()
         try activateExtendedCodes()
         
@@ -258,6 +303,13 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
         }
     }
     
+    private func setupProfiler() {
+        if configuration.profilingEnabled {
+            profiler = DatabaseProfiler()
+            setupTrace()
+        }
+    }
+    
     private func setupForeignKeys() throws {
         // Foreign keys are disabled by default with SQLite3
         if configuration.foreignKeysEnabled {
@@ -412,9 +464,13 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
     ///
     ///     let ids: [Int] = ...
     ///     try dbQueue.write { db in
-    ///         try Player.deleteAll(db, keys: ids)
+    ///         try Player.filter(keys: ids).deleteAll(db)
     ///     }
     ///
+    /// Methods such as `Player.fetchAll(db, keys: ids)` and
+    /// `Player.deleteAll(db, keys: ids)` do not have this limit: they split
+    /// large sets of keys in several statements.
+    ///
     /// See https://www.sqlite.org/limits.html
     /// and `SQLITE_LIMIT_VARIABLE_NUMBER`.
     public var maximumStatementArgumentCount: Int {
@@ -528,6 +584,17 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
         }
     }
     
+    /// Starts reading the given snapshot. The connection must be inside a
+    /// deferred transaction that has not read anything yet.
+    ///
+    /// See https://www.sqlite.org/c3ref/snapshot_open.html
+    func openVersionSnapshot(_ snapshot: UnsafeMutablePointer<sqlite3_snapshot>) throws {
+        let code = sqlite3_snapshot_open(sqliteConnection, "main", snapshot)
+        guard code == SQLITE_OK else {
+            throw DatabaseError(resultCode: code, message: lastErrorMessage)
+        }
+    }
+    
     func wasChanged(since initialSnapshot: UnsafeMutablePointer<sqlite3_snapshot>) throws -> Bool {
         let secondSnapshot = try takeVersionSnapshot()
         defer {
@@ -600,8 +667,19 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
     public func trace(options: TracingOptions = .statement, _ trace: ((TraceEvent) -> Void)? = nil) {
         SchedulingWatchdog.preconditionValidQueue(self)
         self.trace = trace
+        self.traceOptions = trace == nil ? [] : options
+        setupTrace()
+    }
+    
+    /// Installs the SQLite trace hook required by `trace(options:_:)` and
+    /// by the profiler.
+    private func setupTrace() {
+        var options = traceOptions
+        if profiler != nil {
+            options.insert(TracingOptions(rawValue: SQLITE_TRACE_PROFILE))
+        }
         
-        if options.isEmpty || trace == nil {
+        if options.isEmpty {
             #if GRDBCUSTOMSQLITE || GRDBCIPHER || os(iOS)
             sqlite3_trace_v2(sqliteConnection, 0, nil, nil)
             #elseif os(Linux)
@@ -654,18 +732,16 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
     }
     #endif
     
-    // Precondition: configuration.trace != nil
+    // Precondition: trace != nil or profiler != nil
     private func trace_v2(
         _ mask: CInt,
         _ p: UnsafeMutableRawPointer?,
         _ x: UnsafeMutableRawPointer?,
         _ sqlite3_expanded_sql: @escaping @convention(c) (OpaquePointer?) -> UnsafeMutablePointer<Int8>?)
     {
-        guard let trace = trace else { return }
-        
         switch mask {
         case SQLITE_TRACE_STMT:
-            if let sqliteStatement = p, let unexpandedSQL = x {
+            if let trace = trace, let sqliteStatement = p, let unexpandedSQL = x {
                 let statement = TraceEvent.Statement(
                     impl: .trace_v2(
                         sqliteStatement: OpaquePointer(sqliteStatement),
@@ -675,6 +751,12 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
             }
         case SQLITE_TRACE_PROFILE:
             if let sqliteStatement = p, let durationP = x?.assumingMemoryBound(to: Int64.self) {
+                profiler?.statementDidExecute(OpaquePointer(sqliteStatement), nanoseconds: durationP.pointee)
+                
+                guard let trace = trace,
+                      traceOptions.contains(TracingOptions(rawValue: SQLITE_TRACE_PROFILE))
+                else { return }
+                
                 let statement = TraceEvent.Statement(
                     impl: .trace_v2(
                         sqliteStatement: OpaquePointer(sqliteStatement),
@@ -729,6 +811,31 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
         }
     }
     
+    /// Sets a hook that is called after each transaction commit in WAL mode,
+    /// with the number of pages in the WAL.
+    ///
+    /// A hook disables SQLite automatic checkpoints. Pass nil in order to
+    /// restore them.
+    ///
+    /// See https://www.sqlite.org/c3ref/wal_hook.html
+    func setWALCommitHook(_ hook: ((Int) -> Void)?) {
+        SchedulingWatchdog.preconditionValidQueue(self)
+        walCommitHook = hook
+        
+        guard hook != nil else {
+            // The default automatic checkpoints install their own hook.
+            sqlite3_wal_autocheckpoint(sqliteConnection, 1000)
+            return
+        }
+        
+        let dbPointer = Unmanaged.passUnretained(self).toOpaque()
+        sqlite3_wal_hook(sqliteConnection, { (dbPointer, _, _, pageCount) in
+            let db = Unmanaged<Database>.fromOpaque(dbPointer!).takeUnretainedValue()
+            db.walCommitHook?(Int(pageCount))
+            return SQLITE_OK
+        }, dbPointer)
+    }
+    
     // MARK: - Interrupt
     
     // See https://www.sqlite.org/c3ref/interrupt.html
@@ -1146,6 +1253,31 @@ public final class Database: CustomStringConvertible, CustomDebugStringConvertib
         schemaCache.clear()
         internalStatementCache.clear()
         publicStatementCache.clear()
+        sqlQueryCache.clear()
+    }
+    
+    /// Releases memory according to the memory pressure.
+    ///
+    /// See `MemoryBudget`.
+    func trimMemory(_ level: MemoryGovernor.Level, constrainedCacheSize: Int) throws {
+        SchedulingWatchdog.preconditionValidQueue(self)
+        switch level {
+        case .normal:
+            if let cacheSize = unconstrainedCacheSize {
+                try execute(sql: "PRAGMA cache_size = \(cacheSize)")
+                unconstrainedCacheSize = nil
+            }
+        case .soft:
+            internalStatementCache.evictColdStatements()
+            publicStatementCache.evictColdStatements()
+            sqlite3_db_release_memory(sqliteConnection)
+        case .hard:
+            releaseMemory()
+            if unconstrainedCacheSize == nil {
+                unconstrainedCacheSize = try Int.fetchOne(self, sql: "PRAGMA cache_size")
+                try execute(sql: "PRAGMA cache_size = \(constrainedCacheSize)")
+            }
+        }
     }
     
     // MARK: - Erasing
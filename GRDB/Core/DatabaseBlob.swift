@@ -0,0 +1,309 @@
+import Foundation
+
+/// A raw SQLite blob handle, suitable for the SQLite C API.
+public typealias SQLiteBlob = OpaquePointer
+
+extension Database {
+    /// Opens a blob for incremental I/O.
+    ///
+    /// Incremental I/O reads and writes a blob in chunks, without loading
+    /// the whole blob in memory. A blob can not be resized: in order to
+    /// write a new blob, first insert a zero-filled blob with the
+    /// `zeroblob()` SQL function, and then write its content:
+    ///
+    ///     try db.execute(
+    ///         sql: "INSERT INTO document (content) VALUES (zeroblob(?))",
+    ///         arguments: [byteCount])
+    ///     let blob = try db.openBlob(
+    ///         table: "document",
+    ///         column: "content",
+    ///         rowID: db.lastInsertedRowID,
+    ///         mode: .readWrite)
+    ///     try blob.write(from: inputStream)
+    ///
+    /// The blob must be used and released from the database dispatch queue.
+    ///
+    /// See https://www.sqlite.org/c3ref/blob_open.html
+    ///
+    /// - parameters:
+    ///     - table: The name of a table in the main database.
+    ///     - column: The name of a column.
+    ///     - rowID: The rowid of the row that contains the blob.
+    ///     - mode: The access mode.
+    /// - returns: A DatabaseBlob.
+    /// - throws: A DatabaseError whenever an SQLite error occurs.
+    public func openBlob(
+        table: String,
+        column: String,
+        rowID: Int64,
+        mode: DatabaseBlob.Mode = .readOnly)
+    throws -> DatabaseBlob
+    {
+        SchedulingWatchdog.preconditionValidQueue(self)
+        var sqliteBlob: SQLiteBlob? = nil
+        let flags: Int32
+        switch mode {
+        case .readOnly: flags = 0
+        case .readWrite: flags = 1
+        }
+        let code = sqlite3_blob_open(sqliteConnection, "main", table, column, rowID, flags, &sqliteBlob)
+        guard code == SQLITE_OK, let blob = sqliteBlob else {
+            // https://www.sqlite.org/c3ref/blob_open.html
+            // > This function sets the database connection error code and
+            // > message accessible via sqlite3_errcode() and sqlite3_errmsg()
+            // > and related functions.
+            sqlite3_blob_close(sqliteBlob)
+            throw DatabaseError(resultCode: code, message: lastErrorMessage)
+        }
+        return DatabaseBlob(database: self, sqliteBlob: blob, rowID: rowID, mode: mode)
+    }
+}
+
+/// A DatabaseBlob gives incremental access to a blob stored in the database.
+///
+/// See `Database.openBlob(table:column:rowID:mode:)`.
+public final class DatabaseBlob {
+    /// The access mode of a blob.
+    public enum Mode {
+        /// The blob can only be read.
+        case readOnly
+        
+        /// The blob can be read and written.
+        case readWrite
+    }
+    
+    /// The default size of the buffers used by streaming methods.
+    public static let defaultChunkSize = 64 * 1024
+    
+    /// The raw SQLite blob handle, suitable for the SQLite C API.
+    public private(set) var sqliteBlob: SQLiteBlob?
+    
+    /// The access mode of the blob.
+    public let mode: Mode
+    
+    /// The rowid of the row that contains the blob.
+    public private(set) var rowID: Int64
+    
+    /// The number of bytes in the blob.
+    public var count: Int {
+        SchedulingWatchdog.preconditionValidQueue(database)
+        return Int(sqlite3_blob_bytes(openedBlob))
+    }
+    
+    private unowned let database: Database
+    
+    private var openedBlob: SQLiteBlob {
+        guard let sqliteBlob = sqliteBlob else {
+            fatalError("DatabaseBlob is closed")
+        }
+        return sqliteBlob
+    }
+    
+    fileprivate init(database: Database, sqliteBlob: SQLiteBlob, rowID: Int64, mode: Mode) {
+        self.database = database
+        self.sqliteBlob = sqliteBlob
+        self.rowID = rowID
+        self.mode = mode
+    }
+    
+    deinit {
+        sqlite3_blob_close(sqliteBlob)
+    }
+    
+    /// Closes the blob.
+    ///
+    /// The blob is automatically closed when it is deallocated. Once closed,
+    /// the blob can no longer be used.
+    public func close() {
+        SchedulingWatchdog.preconditionValidQueue(database)
+        sqlite3_blob_close(sqliteBlob)
+        sqliteBlob = nil
+    }
+    
+    /// Moves the blob to another row of the same table.
+    ///
+    /// This is faster than opening a new blob.
+    ///
+    /// See https://www.sqlite.org/c3ref/blob_reopen.html
+    ///
+    /// - parameter rowID: The rowid of the row that contains the blob.
+    /// - throws: A DatabaseError whenever an SQLite error occurs.
+    public func reopen(rowID: Int64) throws {
+        SchedulingWatchdog.preconditionValidQueue(database)
+        let code = sqlite3_blob_reopen(openedBlob, rowID)
+        guard code == SQLITE_OK else {
+            throw DatabaseError(resultCode: code, message: database.lastErrorMessage)
+        }
+        self.rowID = rowID
+    }
+    
+    // MARK: - Reading
+    
+    /// Reads bytes from the blob into a buffer.
+    ///
+    /// - parameters:
+    ///     - buffer: The buffer to fill. Its whole size is read.
+    ///     - offset: The offset of the first read byte in the blob.
+    /// - throws: A DatabaseError whenever an SQLite error occurs, or if the
+    ///   read bytes are out of the bounds of the blob.
+    public func read(into buffer: UnsafeMutableRawBufferPointer, at offset: Int) throws {
+        SchedulingWatchdog.preconditionValidQueue(database)
+        guard let baseAddress = buffer.baseAddress, buffer.count > 0 else {
+            return
+        }
+        let code = sqlite3_blob_read(openedBlob, baseAddress, Int32(buffer.count), Int32(offset))
+        guard code == SQLITE_OK else {
+            throw DatabaseError(resultCode: code, message: database.lastErrorMessage)
+        }
+    }
+    
+    /// Returns bytes read from the blob.
+    ///
+    /// - parameters:
+    ///     - count: The number of bytes to read.
+    ///     - offset: The offset of the first read byte in the blob.
+    /// - throws: A DatabaseError whenever an SQLite error occurs, or if the
+    ///   read bytes are out of the bounds of the blob.
+    public func read(count: Int, at offset: Int = 0) throws -> Data {
+        var data = Data(count: count)
+        try data.withUnsafeMutableBytes { buffer in
+            try read(into: buffer, at: offset)
+        }
+        return data
+    }
+    
+    /// Reads the whole blob, chunk after chunk.
+    ///
+    /// Only one buffer of `chunkSize` bytes is allocated.
+    ///
+    ///     let blob = try db.openBlob(table: "document", column: "content", rowID: 1)
+    ///     try blob.readChunks { bytes in
+    ///         // Process bytes
+    ///     }
+    ///
+    /// - parameters:
+    ///     - chunkSize: The maximum size of the chunks.
+    ///     - body: A closure that is called with each chunk. The buffer must
+    ///       not escape the closure.
+    /// - throws: A DatabaseError whenever an SQLite error occurs, or the
+    ///   error thrown by `body`.
+    public func readChunks(
+        chunkSize: Int = DatabaseBlob.defaultChunkSize,
+        _ body: (UnsafeRawBufferPointer) throws -> Void)
+    throws
+    {
+        GRDBPrecondition(chunkSize > 0, "Invalid chunk size")
+        let count = self.count
+        let buffer = UnsafeMutableRawBufferPointer.allocate(
+            byteCount: min(chunkSize, max(count, 1)),
+            alignment: 1)
+        defer { buffer.deallocate() }
+        var offset = 0
+        while offset < count {
+            let chunk = UnsafeMutableRawBufferPointer(rebasing: buffer[0..<min(buffer.count, count - offset)])
+            try read(into: chunk, at: offset)
+            try body(UnsafeRawBufferPointer(chunk))
+            offset += chunk.count
+        }
+    }
+    
+    /// Writes the whole blob into an output stream, chunk after chunk.
+    ///
+    /// The stream must be opened.
+    ///
+    /// - parameters:
+    ///     - stream: An opened output stream.
+    ///     - chunkSize: The maximum size of the chunks.
+    /// - throws: A DatabaseError whenever an SQLite error occurs, or the
+    ///   error of the stream.
+    public func read(to stream: OutputStream, chunkSize: Int = DatabaseBlob.defaultChunkSize) throws {
+        try readChunks(chunkSize: chunkSize) { bytes in
+            var chunk = bytes
+            while let baseAddress = chunk.baseAddress, chunk.count > 0 {
+                let written = stream.write(baseAddress.assumingMemoryBound(to: UInt8.self), maxLength: chunk.count)
+                if written <= 0 {
+                    throw stream.streamError ?? DatabaseError(message: "could not write blob into output stream")
+                }
+                chunk = UnsafeRawBufferPointer(rebasing: chunk[written...])
+            }
+        }
+    }
+    
+    // MARK: - Writing
+    
+    /// Writes bytes into the blob.
+    ///
+    /// The size of the blob can not be changed.
+    ///
+    /// - parameters:
+    ///     - bytes: The written bytes.
+    ///     - offset: The offset of the first written byte in the blob.
+    /// - throws: A DatabaseError whenever an SQLite error occurs, or if the
+    ///   written bytes are out of the bounds of the blob.
+    public func write(_ bytes: UnsafeRawBufferPointer, at offset: Int) throws {
+        SchedulingWatchdog.preconditionValidQueue(database)
+        guard let baseAddress = bytes.baseAddress, bytes.count > 0 else {
+            return
+        }
+        let code = sqlite3_blob_write(openedBlob, baseAddress, Int32(bytes.count), Int32(offset))
+        guard code == SQLITE_OK else {
+            throw DatabaseError(resultCode: code, message: database.lastErrorMessage)
+        }
+    }
+    
+    /// Writes bytes into the blob.
+    ///
+    /// The size of the blob can not be changed.
+    ///
+    /// - parameters:
+    ///     - data: The written bytes.
+    ///     - offset: The offset of the first written byte in the blob.
+    /// - throws: A DatabaseError whenever an SQLite error occurs, or if the
+    ///   written bytes are out of the bounds of the blob.
+    public func write(_ data: Data, at offset: Int = 0) throws {
+        try data.withUnsafeBytes { bytes in
+            try write(bytes, at: offset)
+        }
+    }
+    
+    /// Writes the content of an input stream into the blob, chunk
+    /// after chunk.
+    ///
+    /// The stream must be opened. Writing stops when the stream is exhausted,
+    /// or when the end of the blob is reached.
+    ///
+    /// - parameters:
+    ///     - stream: An opened input stream.
+    ///     - offset: The offset of the first written byte in the blob.
+    ///     - chunkSize: The maximum size of the chunks.
+    /// - returns: The number of written bytes.
+    /// - throws: A DatabaseError whenever an SQLite error occurs, or the
+    ///   error of the stream.
+    @discardableResult
+    public func write(
+        from stream: InputStream,
+        at offset: Int = 0,
+        chunkSize: Int = DatabaseBlob.defaultChunkSize)
+    throws -> Int
+    {
+        GRDBPrecondition(chunkSize > 0, "Invalid chunk size")
+        let count = self.count
+        let buffer = UnsafeMutablePointer<UInt8>.allocate(capacity: chunkSize)
+        defer { buffer.deallocate() }
+        var offset = offset
+        var writtenCount = 0
+        while offset < count {
+            let readCount = stream.read(buffer, maxLength: min(chunkSize, count - offset))
+            if readCount < 0 {
+                throw stream.streamError ?? DatabaseError(message: "could not read blob from input stream")
+            }
+            if readCount == 0 {
+                break
+            }
+            try write(UnsafeRawBufferPointer(start: buffer, count: readCount), at: offset)
+            offset += readCount
+            writtenCount += readCount
+        }
+        return writtenCount
+    }
+}
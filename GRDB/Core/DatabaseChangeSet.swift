@@ -0,0 +1,282 @@
+import Foundation
+
+// MARK: - TransactionChangeSetObserver
+
+/// A transaction observer that is notified of all the changes of a
+/// transaction at once, right before the transaction is committed.
+///
+/// Unlike regular transaction observers, a change set observer is not
+/// notified of individual database changes: its `databaseDidChange(with:)`
+/// method is not called. It does not have to copy database events during
+/// the transaction either. Instead, changes are gathered in a compact buffer,
+/// and notified in `databaseWillCommit(with:)`.
+///
+/// For example:
+///
+///     class PlayerObserver: TransactionChangeSetObserver {
+///         var changes: DatabaseChangeSet?
+///
+///         func observes(eventsOfKind eventKind: DatabaseEventKind) -> Bool {
+///             eventKind.tableName == "player"
+///         }
+///
+///         func databaseWillCommit(with changes: DatabaseChangeSet) throws {
+///             self.changes = changes
+///         }
+///
+///         func databaseDidCommit(_ db: Database) {
+///             if let changes = changes {
+///                 print("Modified players: \(changes.rowIDs(in: "player"))")
+///             }
+///             changes = nil
+///         }
+///
+///         func databaseDidRollback(_ db: Database) {
+///             changes = nil
+///         }
+///     }
+public protocol TransactionChangeSetObserver: TransactionObserver {
+    /// When a transaction is about to be committed, the observer is notified
+    /// of all the changes of the transaction it is interested in, and has an
+    /// opportunity to rollback pending changes by throwing an error.
+    ///
+    /// This method is called instead of `databaseWillCommit()`. The change
+    /// set can be stored, and used in `databaseDidCommit(_:)`.
+    ///
+    /// This method is called on the database queue.
+    ///
+    /// - warning: this method must not change the database.
+    ///
+    /// - throws: An eventual error that rollbacks pending changes.
+    func databaseWillCommit(with changes: DatabaseChangeSet) throws
+}
+
+extension TransactionChangeSetObserver {
+    /// Default implementation does nothing. Change set observers are notified
+    /// of database changes in `databaseWillCommit(with:)`.
+    public func databaseDidChange(with event: DatabaseEvent) {
+    }
+}
+
+// MARK: - DatabaseChange
+
+/// A database change, notified to `TransactionChangeSetObserver`.
+public struct DatabaseChange: Hashable {
+    /// The change kind
+    public var kind: DatabaseEvent.Kind
+    
+    /// The database name
+    public var databaseName: String
+    
+    /// The table name
+    public var tableName: String
+    
+    /// The rowID of the changed row.
+    public var rowID: Int64
+}
+
+// MARK: - DatabaseChangeSet
+
+/// The database changes of a transaction, notified to
+/// `TransactionChangeSetObserver`.
+///
+/// A change set contains at most one change per row, in the order rows were
+/// first changed. When a row is changed several times, the kind of the change
+/// summarizes all changes: an inserted row that is updated is notified as
+/// inserted, a row that is deleted and inserted again is notified as
+/// updated, and an inserted row that is deleted is notified as deleted.
+public struct DatabaseChangeSet {
+    /// A changed table
+    struct Table: Hashable {
+        var databaseName: String
+        var tableName: String
+    }
+    
+    private let tables: [Table]
+    private let tableIndexes: [Int32]
+    private let rowIDs: [Int64]
+    private let kinds: [DatabaseEvent.Kind]
+    
+    fileprivate init(
+        tables: [Table],
+        tableIndexes: [Int32],
+        rowIDs: [Int64],
+        kinds: [DatabaseEvent.Kind])
+    {
+        self.tables = tables
+        self.tableIndexes = tableIndexes
+        self.rowIDs = rowIDs
+        self.kinds = kinds
+    }
+    
+    /// The names of the changed tables.
+    public var tableNames: Set<String> {
+        var tableNames = Set<String>()
+        var isIncluded = [Bool](repeating: false, count: tables.count)
+        for tableIndex in tableIndexes where !isIncluded[Int(tableIndex)] {
+            isIncluded[Int(tableIndex)] = true
+            tableNames.insert(tables[Int(tableIndex)].tableName)
+        }
+        return tableNames
+    }
+    
+    /// Returns the rowIDs of the changed rows in the given table.
+    public func rowIDs(in tableName: String) -> [Int64] {
+        let isIncluded = tables.map { $0.tableName == tableName }
+        guard isIncluded.contains(true) else {
+            return []
+        }
+        var result: [Int64] = []
+        for (tableIndex, rowID) in zip(tableIndexes, rowIDs) where isIncluded[Int(tableIndex)] {
+            result.append(rowID)
+        }
+        return result
+    }
+}
+
+extension DatabaseChangeSet: RandomAccessCollection {
+    public typealias Index = Int
+    
+    public var startIndex: Int { 0 }
+    
+    public var endIndex: Int { rowIDs.count }
+    
+    public subscript(position: Int) -> DatabaseChange {
+        let table = tables[Int(tableIndexes[position])]
+        return DatabaseChange(
+            kind: kinds[position],
+            databaseName: table.databaseName,
+            tableName: table.tableName,
+            rowID: rowIDs[position])
+    }
+}
+
+// MARK: - DatabaseChangeTables
+
+/// The tables changed during a transaction.
+///
+/// Changes refer to their table by index, so that no Swift string is created
+/// for each individual change.
+struct DatabaseChangeTables {
+    private(set) var tables: [DatabaseChangeSet.Table] = []
+    private var indexes: [DatabaseChangeSet.Table: Int32] = [:]
+    private var lastIndex: Int32?
+    
+    /// Returns the index of the table.
+    mutating func index(
+        databaseNameCString: UnsafePointer<Int8>,
+        tableNameCString: UnsafePointer<Int8>)
+    -> Int32
+    {
+        // Consecutive changes generally happen in the same table
+        if let lastIndex = lastIndex {
+            let table = tables[Int(lastIndex)]
+            if table.tableName.withCString({ strcmp($0, tableNameCString) }) == 0
+                && table.databaseName.withCString({ strcmp($0, databaseNameCString) }) == 0
+            {
+                return lastIndex
+            }
+        }
+        
+        let table = DatabaseChangeSet.Table(
+            databaseName: String(cString: databaseNameCString),
+            tableName: String(cString: tableNameCString))
+        let index: Int32
+        if let existingIndex = indexes[table] {
+            index = existingIndex
+        } else {
+            index = Int32(tables.count)
+            tables.append(table)
+            indexes[table] = index
+        }
+        lastIndex = index
+        return index
+    }
+    
+    mutating func removeAll() {
+        tables = []
+        indexes = [:]
+        lastIndex = nil
+    }
+}
+
+// MARK: - DatabaseChangeBuffer
+
+/// The changes of a transaction, notified to a `TransactionChangeSetObserver`.
+///
+/// Changes are appended as they happen. They are deduplicated when the change
+/// set is built.
+struct DatabaseChangeBuffer {
+    private struct Key: Hashable {
+        var tableIndex: Int32
+        var rowID: Int64
+    }
+    
+    private var tableIndexes: [Int32] = []
+    private var rowIDs: [Int64] = []
+    private var kinds: [DatabaseEvent.Kind] = []
+    
+    var count: Int { rowIDs.count }
+    
+    mutating func append(tableIndex: Int32, rowID: Int64, kind: DatabaseEvent.Kind) {
+        tableIndexes.append(tableIndex)
+        rowIDs.append(rowID)
+        kinds.append(kind)
+    }
+    
+    /// Removes the changes that were appended after the buffer contained
+    /// `count` changes.
+    mutating func removeChanges(after count: Int) {
+        let removedCount = self.count - count
+        guard removedCount > 0 else { return }
+        tableIndexes.removeLast(removedCount)
+        rowIDs.removeLast(removedCount)
+        kinds.removeLast(removedCount)
+    }
+    
+    mutating func removeAll() {
+        tableIndexes = []
+        rowIDs = []
+        kinds = []
+    }
+    
+    /// Returns the deduplicated changes.
+    func changeSet(tables: [DatabaseChangeSet.Table]) -> DatabaseChangeSet {
+        var positions: [Key: Int] = [:]
+        positions.reserveCapacity(count)
+        var changeTableIndexes: [Int32] = []
+        changeTableIndexes.reserveCapacity(count)
+        var changeRowIDs: [Int64] = []
+        changeRowIDs.reserveCapacity(count)
+        var changeKinds: [DatabaseEvent.Kind] = []
+        changeKinds.reserveCapacity(count)
+        
+        for index in 0..<count {
+            let key = Key(tableIndex: tableIndexes[index], rowID: rowIDs[index])
+            let kind = kinds[index]
+            if let position = positions[key] {
+                switch (changeKinds[position], kind) {
+                case (.insert, .update):
+                    // Still an insertion
+                    break
+                case (.delete, .insert):
+                    // The rowID was reused
+                    changeKinds[position] = .update
+                default:
+                    changeKinds[position] = kind
+                }
+            } else {
+                positions[key] = changeRowIDs.count
+                changeTableIndexes.append(key.tableIndex)
+                changeRowIDs.append(key.rowID)
+                changeKinds.append(kind)
+            }
+        }
+        
+        return DatabaseChangeSet(
+            tables: tables,
+            tableIndexes: changeTableIndexes,
+            rowIDs: changeRowIDs,
+            kinds: changeKinds)
+    }
+}
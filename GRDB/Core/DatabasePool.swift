@@ -9,8 +9,17 @@ public final class DatabasePool: DatabaseWriter {
     private let writer: SerializedDatabase
     private var readerPool: Pool<SerializedDatabase>!
     
+    /// The schema cache shared by all connections
+    private let sharedSchemaCache = SharedDatabaseSchemaCache()
+    
     @LockedBox var databaseSnapshotCount = 0
     
+    /// Not nil when configuration.checkpointPolicy is set
+    private var checkpointer: WALCheckpointer?
+    
+    /// Not nil when configuration.memoryBudget is set
+    private var memoryGovernor: MemoryGovernor?
+    
     // MARK: - Database Information
     
     /// The database configuration
@@ -45,6 +54,13 @@ public final class DatabasePool: DatabaseWriter {
             defaultLabel: "GRDB.DatabasePool",
             purpose: "writer")
         
+        // The writer does not use the shared schema cache, because it can
+        // see uncommitted schema changes. But it can clear the shared cache.
+        let sharedSchemaCache = self.sharedSchemaCache
+        writer.sync { db in
+            db.schemaCache.shared = sharedSchemaCache
+        }
+        
         // Readers
         var readerConfiguration = DatabasePool.readerConfiguration(configuration)
         
@@ -53,15 +69,23 @@ public final class DatabasePool: DatabaseWriter {
         // an opened transaction.
         readerConfiguration.allowsUnsafeTransactions = false
         
-        var readerCount = 0
-        readerPool = Pool(maximumCount: configuration.maximumReaderCount, makeElement: {
-            readerCount += 1 // protected by Pool (TODO: document this protection behavior)
-            return try SerializedDatabase(
-                path: path,
-                configuration: readerConfiguration,
-                defaultLabel: "GRDB.DatabasePool",
-                purpose: "reader.\(readerCount)")
-        })
+        // Readers can be opened concurrently
+        let readerCount = LockedBox(wrappedValue: 0)
+        readerPool = Pool(
+            maximumCount: configuration.maximumReaderCount,
+            idleTimeout: configuration.readerIdleTimeout,
+            makeElement: {
+                let readerIndex = readerCount.increment()
+                let reader = try SerializedDatabase(
+                    path: path,
+                    configuration: readerConfiguration,
+                    defaultLabel: "GRDB.DatabasePool",
+                    purpose: "reader.\(readerIndex)")
+                reader.sync { db in
+                    db.schemaCache.shared = sharedSchemaCache
+                }
+                return reader
+            })
         
         // Activate WAL Mode unless readonly
         if !configuration.readonly {
@@ -92,8 +116,16 @@ public final class DatabasePool: DatabaseWriter {
             }
         }
         
+        if let checkpointPolicy = configuration.checkpointPolicy, !configuration.readonly {
+            setupCheckpointer(checkpointPolicy)
+        }
+        
         setupSuspension()
         
+        if let memoryBudget = configuration.memoryBudget {
+            setupMemoryGovernor(memoryBudget)
+        }
+        
         // Be a nice iOS citizen, and don't consume too much memory
         // See https://github.com/groue/GRDB.swift/#memory-management
         #if os(iOS)
@@ -168,12 +200,43 @@ extension DatabasePool {
     public func releaseMemory() {
         // Release writer memory
         writer.sync { $0.releaseMemory() }
+        sharedSchemaCache.clear()
         // Release readers memory by closing all connections
         readerPool.barrier {
             readerPool.removeAll()
         }
     }
     
+    private func setupMemoryGovernor(_ budget: MemoryBudget) {
+        memoryGovernor = MemoryGovernor(
+            budget: budget,
+            label: configuration.identifier(defaultLabel: "GRDB.DatabasePool", purpose: "memoryGovernor"),
+            trimMemory: { [weak self] level in
+                self?.trimMemory(level, constrainedCacheSize: budget.constrainedCacheSize)
+            })
+    }
+    
+    /// Releases memory according to the memory pressure, without waiting for
+    /// busy connections.
+    private func trimMemory(_ level: MemoryGovernor.Level, constrainedCacheSize: Int) {
+        // The writer releases memory after its pending work
+        writer.async { db in
+            try? db.trimMemory(level, constrainedCacheSize: constrainedCacheSize)
+        }
+        
+        switch level {
+        case .hard:
+            sharedSchemaCache.clear()
+            readerPool.removeAvailableElements()
+        case .normal, .soft:
+            readerPool.forEachAvailableElement { reader in
+                reader.sync { db in
+                    try? db.trimMemory(level, constrainedCacheSize: constrainedCacheSize)
+                }
+            }
+        }
+    }
+    
     #if os(iOS)
     /// Listens to UIApplicationDidEnterBackgroundNotification and
     /// UIApplicationDidReceiveMemoryWarningNotification in order to release
@@ -218,6 +281,296 @@ extension DatabasePool {
         }
     }
     #endif
+    
+    // MARK: - Reader Statistics
+    
+    /// Statistics about the usage of read-only connections.
+    ///
+    /// Use those statistics in order to tune
+    /// `Configuration.maximumReaderCount` and
+    /// `Configuration.readerIdleTimeout`: a high `waitCount`, for example,
+    /// reveals that reads often have to wait for an available connection.
+    public var readerStatistics: ReaderStatistics {
+        ReaderStatistics(readerPool.statistics)
+    }
+    
+    /// Statistics about the usage of the read-only connections of a
+    /// database pool.
+    ///
+    /// See `DatabasePool.readerStatistics`.
+    public struct ReaderStatistics {
+        /// The number of open read-only connections.
+        public var readerCount: Int
+        
+        /// The number of read-only connections that are currently used.
+        public var busyReaderCount: Int
+        
+        /// The number of reads that are currently waiting for an available
+        /// read-only connection.
+        public var waitingReadCount: Int
+        
+        /// The number of read-only connections that were acquired.
+        public var acquisitionCount: Int
+        
+        /// The number of acquisitions that had to wait for an available
+        /// read-only connection, because `Configuration.maximumReaderCount`
+        /// was reached.
+        public var waitCount: Int
+        
+        /// The total time spent waiting for an available read-only connection.
+        public var totalWaitDuration: TimeInterval
+        
+        /// The longest time spent waiting for an available read-only
+        /// connection.
+        public var maximumWaitDuration: TimeInterval
+        
+        /// The number of read-only connections that were closed because they
+        /// were not used for `Configuration.readerIdleTimeout`.
+        public var idleCloseCount: Int
+        
+        init(_ statistics: Pool<SerializedDatabase>.Statistics) {
+            readerCount = statistics.elementCount
+            busyReaderCount = statistics.usedElementCount
+            waitingReadCount = statistics.waitingCount
+            acquisitionCount = statistics.acquisitionCount
+            waitCount = statistics.waitCount
+            totalWaitDuration = statistics.totalWaitDuration
+            maximumWaitDuration = statistics.maximumWaitDuration
+            idleCloseCount = statistics.idleRemovalCount
+        }
+    }
+    
+    // MARK: - Warm-Up
+    
+    /// Asynchronously opens read-only connections, and prepares them for
+    /// the first reads performed by the application.
+    ///
+    ///     // Right after the pool was opened
+    ///     dbPool.asyncWarmUp(
+    ///         readerCount: 2,
+    ///         tables: ["player", "team"],
+    ///         statements: ["SELECT * FROM player ORDER BY score DESC LIMIT 10"],
+    ///         completion: { result in
+    ///             if case let .success(statistics) = result {
+    ///                 print(statistics.openDuration)
+    ///             }
+    ///         })
+    ///
+    /// The warm-up has three phases:
+    ///
+    /// 1. Up to `readerCount` read-only connections are opened concurrently,
+    ///     with the `Configuration.prepareDatabase` function. Connections are
+    ///     not opened beyond `Configuration.maximumReaderCount`, and
+    ///     connections that are currently used by the application are
+    ///     not warmed up.
+    ///
+    /// 2. The schema of the `tables` (columns, primary key, indexes and
+    ///     foreign keys) is loaded in the schema cache shared by all
+    ///     connections of the pool. This is the information used by
+    ///     records and the query interface.
+    ///
+    /// 3. The `statements` are prepared and stored in the statement cache of
+    ///     each warmed-up connection, as `cachedSelectStatement(sql:)` would
+    ///     do, and with the `SQLITE_PREPARE_PERSISTENT` flag, when available.
+    ///
+    /// Read-only connections that are opened after the warm-up share the
+    /// schema cache, but do not contain the prepared statements.
+    ///
+    /// - parameters:
+    ///     - readerCount: The maximum number of connections to warm up.
+    ///     - tables: The tables whose schema should be loaded.
+    ///     - statements: SQL queries that should be prepared.
+    ///     - completion: A closure that is called in an unspecified dispatch
+    ///       queue, with the durations of the warm-up phases, or an error.
+    /// - precondition: readerCount is positive.
+    public func asyncWarmUp(
+        readerCount: Int,
+        tables: [String] = [],
+        statements: [String] = [],
+        completion: @escaping (Result<WarmUpStatistics, Error>) -> Void = { _ in })
+    {
+        GRDBPrecondition(readerCount > 0, "readerCount must be at least 1")
+        let readerCount = min(readerCount, configuration.maximumReaderCount)
+        DispatchQueue.global(qos: .utility).async { [readerPool] in
+            guard let readerPool = readerPool else {
+                // Pool is closed
+                completion(.success(WarmUpStatistics()))
+                return
+            }
+            completion(Result {
+                try DatabasePool.warmUp(
+                    readerPool,
+                    readerCount: readerCount,
+                    tables: tables,
+                    statements: statements)
+            })
+        }
+    }
+    
+    private static func warmUp(
+        _ readerPool: Pool<SerializedDatabase>,
+        readerCount: Int,
+        tables: [String],
+        statements: [String])
+    throws -> WarmUpStatistics
+    {
+        var statistics = WarmUpStatistics()
+        
+        // 1. Open connections concurrently, and keep them until the end
+        // of the warm-up, so that each iteration gets a distinct connection.
+        var start = DispatchTime.now()
+        let readers = LockedBox<[(element: SerializedDatabase, release: () -> Void)]>(wrappedValue: [])
+        let openError = LockedBox<Error?>(wrappedValue: nil)
+        defer {
+            for reader in readers.wrappedValue {
+                reader.release()
+            }
+        }
+        DispatchQueue.concurrentPerform(iterations: readerCount) { _ in
+            do {
+                if let reader = try readerPool.tryGet() {
+                    readers.update { $0.append(reader) }
+                }
+            } catch {
+                openError.wrappedValue = error
+            }
+        }
+        if let error = openError.wrappedValue {
+            throw error
+        }
+        let warmedReaders = readers.wrappedValue.map(\.element)
+        statistics.readerCount = warmedReaders.count
+        statistics.openDuration = duration(since: start)
+        
+        // 2. Fill the shared schema cache
+        start = DispatchTime.now()
+        if let reader = warmedReaders.first, !tables.isEmpty {
+            try reader.sync { db in
+                try db.inTransaction(.deferred) {
+                    try db.clearSchemaCacheIfNeeded()
+                    for table in tables {
+                        _ = try db.columns(in: table)
+                        _ = try db.primaryKey(table)
+                        _ = try db.indexes(on: table)
+                        _ = try db.foreignKeys(on: table)
+                    }
+                    return .commit
+                }
+            }
+        }
+        statistics.schemaDuration = duration(since: start)
+        
+        // 3. Fill statement caches concurrently
+        start = DispatchTime.now()
+        if !statements.isEmpty {
+            let prepareError = LockedBox<Error?>(wrappedValue: nil)
+            DispatchQueue.concurrentPerform(iterations: warmedReaders.count) { index in
+                do {
+                    try warmedReaders[index].sync { db in
+                        // Prepare statements inside a read transaction, after
+                        // the schema cache was validated, so that the first
+                        // read of the application does not clear the
+                        // statement cache.
+                        try db.inTransaction(.deferred) {
+                            try db.clearSchemaCacheIfNeeded()
+                            for sql in statements {
+                                _ = try db.cachedSelectStatement(sql: sql)
+                            }
+                            return .commit
+                        }
+                    }
+                } catch {
+                    prepareError.wrappedValue = error
+                }
+            }
+            if let error = prepareError.wrappedValue {
+                throw error
+            }
+        }
+        statistics.statementDuration = duration(since: start)
+        
+        return statistics
+    }
+    
+    private static func duration(since start: DispatchTime) -> TimeInterval {
+        TimeInterval(DispatchTime.now().uptimeNanoseconds - start.uptimeNanoseconds) / 1.0e9
+    }
+    
+    /// The durations of the phases of a database pool warm-up.
+    ///
+    /// See `DatabasePool.asyncWarmUp(readerCount:tables:statements:completion:)`.
+    public struct WarmUpStatistics {
+        /// The number of warmed-up read-only connections.
+        public var readerCount = 0
+        
+        /// The time spent opening read-only connections.
+        public var openDuration: TimeInterval = 0
+        
+        /// The time spent loading the schema of tables.
+        public var schemaDuration: TimeInterval = 0
+        
+        /// The time spent preparing statements.
+        public var statementDuration: TimeInterval = 0
+    }
+    
+    // MARK: - WAL Checkpoints
+    
+    /// Replaces SQLite automatic checkpoints with a WALCheckpointer.
+    private func setupCheckpointer(_ policy: CheckpointPolicy) {
+        let checkpointer = WALCheckpointer(
+            path: path,
+            configuration: configuration,
+            policy: policy,
+            readersAreIdle: { [weak self] in
+                // Database snapshots are not considered: they may prevent
+                // escalated checkpoints from completing.
+                self?.readerPool.isIdle ?? false
+            })
+        writer.sync { db in
+            db.setWALCommitHook { [weak checkpointer] pageCount in
+                checkpointer?.walDidCommit(pageCount: pageCount)
+            }
+        }
+        self.checkpointer = checkpointer
+    }
+    
+    /// Statistics about automatic checkpoints, or nil if
+    /// `Configuration.checkpointPolicy` is nil.
+    ///
+    /// Use those statistics in order to tune the checkpoint policy: a high
+    /// `busyCheckpointCount`, for example, reveals that escalated checkpoints
+    /// often compete with writes.
+    public var checkpointStatistics: CheckpointStatistics? {
+        checkpointer?.statistics
+    }
+    
+    // MARK: - Profiling
+    
+    /// The profiling statistics of all connections of the pool: the writer
+    /// connection, and the currently open read-only connections.
+    ///
+    /// Statistics are only collected when `Configuration.profilingEnabled`
+    /// is true.
+    ///
+    /// This method blocks the current thread until all connections are
+    /// available. It must not be called from a database access method.
+    public var profilingStatistics: ProfilingStatistics {
+        var statistics = ProfilingStatistics()
+        forEachConnection { db in
+            statistics = statistics + db.profilingStatistics
+        }
+        return statistics
+    }
+    
+    /// Resets the profiling statistics of all connections of the pool.
+    ///
+    /// This method blocks the current thread until all connections are
+    /// available. It must not be called from a database access method.
+    public func resetProfilingStatistics() {
+        forEachConnection { db in
+            db.resetProfilingStatistics()
+        }
+    }
 }
 
 extension DatabasePool: DatabaseReader {
@@ -238,6 +591,7 @@ extension DatabasePool: DatabaseReader {
             return
         }
         writer.suspend()
+        checkpointer?.suspend()
     }
     
     func resume() {
@@ -247,6 +601,7 @@ extension DatabasePool: DatabaseReader {
             return
         }
         writer.resume()
+        checkpointer?.resume()
     }
     
     private func setupSuspension() {
@@ -337,37 +692,32 @@ extension DatabasePool: DatabaseReader {
     ///
     /// - parameter block: A block that accesses the database.
     public func asyncRead(_ block: @escaping (Result<Database, Error>) -> Void) {
-        // First async jump in order to grab a reader connection.
-        // Honor configuration dispatching (qos/targetQueue).
-        let label = configuration.identifier(
-            defaultLabel: "GRDB.DatabasePool",
-            purpose: "asyncRead")
-        configuration
-            .makeDispatchQueue(label: label)
-            .async {
-                do {
-                    let (reader, releaseReader) = try self.readerPool.get()
-                    
-                    // Second async jump because sync could deadlock if
-                    // configuration has a serial targetQueue.
-                    reader.async { db in
-                        defer {
-                            try? db.commit() // Ignore commit error
-                            releaseReader()
-                        }
-                        do {
-                            // The block isolation comes from the DEFERRED transaction.
-                            try db.beginTransaction(.deferred)
-                            try db.clearSchemaCacheIfNeeded()
-                            block(.success(db))
-                        } catch {
-                            block(.failure(error))
-                        }
+        // Grab a reader connection without blocking any thread while all
+        // readers are busy.
+        readerPool.asyncGet { result in
+            do {
+                let (reader, releaseReader) = try result.get()
+                
+                // Async jump because sync could deadlock if
+                // configuration has a serial targetQueue.
+                reader.async { db in
+                    defer {
+                        try? db.commit() // Ignore commit error
+                        releaseReader()
+                    }
+                    do {
+                        // The block isolation comes from the DEFERRED transaction.
+                        try db.beginTransaction(.deferred)
+                        try db.clearSchemaCacheIfNeeded()
+                        block(.success(db))
+                    } catch {
+                        block(.failure(error))
                     }
-                } catch {
-                    block(.failure(error))
                 }
+            } catch {
+                block(.failure(error))
             }
+        }
     }
     
     /// :nodoc:
@@ -677,6 +1027,155 @@ extension DatabasePool: DatabaseReader {
         return readers.first { $0.onValidQueue }
     }
     
+    // MARK: - Parallel Reads
+    
+    /// Synchronously executes a read-only block for each partition, and
+    /// returns the results in the order of partitions.
+    ///
+    /// Partitions are processed concurrently, by several reader connections
+    /// that all see the same database snapshot, as if the whole job was
+    /// performed by a single `read` method:
+    ///
+    ///     // Count players in four partitions
+    ///     let counts = try dbPool.parallelRead(partitions: [0, 1, 2, 3]) { db, partition in
+    ///         try Int.fetchOne(
+    ///             db,
+    ///             sql: "SELECT COUNT(*) FROM player WHERE rowid % 4 = ?",
+    ///             arguments: [partition])!
+    ///     }
+    ///     let playerCount = counts.reduce(0, +)
+    ///
+    /// The number of connections is limited by
+    /// `Configuration.maximumReaderCount`, and by the number of readers that
+    /// are available when this method is called. When there are more
+    /// partitions than connections, each connection processes several
+    /// partitions, one after the other.
+    ///
+    /// The block is called concurrently, from several threads. When it throws
+    /// an error, the partitions that have not started yet are not processed,
+    /// and the first error is rethrown.
+    ///
+    /// With SQLite builds that support snapshots (SQLITE_ENABLE_SNAPSHOT), all
+    /// connections open the same `sqlite3_snapshot`. Otherwise, writes are
+    /// blocked until all connections have established snapshot isolation, and
+    /// the shared snapshot is only guaranteed with regard to the writes
+    /// performed by this database pool.
+    ///
+    /// This method is *not* reentrant.
+    ///
+    /// - parameter partitions: The partitions of the job.
+    /// - parameter block: A block that accesses the database for
+    ///   one partition.
+    /// - returns: The results of the block, in the order of partitions.
+    /// - throws: The first error thrown by the block, or any DatabaseError that
+    ///   would happen while establishing the read access to the database.
+    public func parallelRead<Partition, T>(
+        partitions: [Partition],
+        _ block: (Database, Partition) throws -> T)
+    throws -> [T]
+    {
+        GRDBPrecondition(currentReader == nil, "Database methods are not reentrant.")
+        GRDBPrecondition(!writer.onValidQueue, "Database methods are not reentrant.")
+        if partitions.isEmpty {
+            return []
+        }
+        
+        // Wait for one reader, and grab other available readers.
+        var readers = try [readerPool.get()]
+        defer {
+            for (_, releaseReader) in readers {
+                releaseReader()
+            }
+        }
+        while readers.count < partitions.count, let reader = try readerPool.tryGet() {
+            readers.append(reader)
+        }
+        
+        let connections = readers.map { $0.element }
+        defer {
+            for connection in connections {
+                connection.sync { db in
+                    if db.isInsideTransaction {
+                        try? db.commit() // Ignore commit error
+                    }
+                }
+            }
+        }
+        try beginSharedSnapshotTransactions(connections)
+        
+        let nextIndex = LockedBox(wrappedValue: 0)
+        let results = LockedBox(wrappedValue: [T?](repeating: nil, count: partitions.count))
+        let firstError = LockedBox<Error?>(wrappedValue: nil)
+        DispatchQueue.concurrentPerform(iterations: connections.count) { connectionIndex in
+            connections[connectionIndex].sync { db in
+                while firstError.wrappedValue == nil {
+                    let index = nextIndex.increment() - 1
+                    if index >= partitions.count {
+                        return
+                    }
+                    do {
+                        let result = try block(db, partitions[index])
+                        results.update { $0[index] = result }
+                    } catch {
+                        firstError.update { firstError in
+                            if firstError == nil {
+                                firstError = error
+                            }
+                        }
+                    }
+                }
+            }
+        }
+        
+        if let error = firstError.wrappedValue {
+            throw error
+        }
+        return results.wrappedValue.map { $0! }
+    }
+    
+    /// Opens a deferred transaction in all connections, so that they all see
+    /// the same database snapshot.
+    private func beginSharedSnapshotTransactions(_ connections: [SerializedDatabase]) throws {
+        #if SQLITE_ENABLE_SNAPSHOT
+        let snapshot = try connections[0].sync { db -> UnsafeMutablePointer<sqlite3_snapshot>? in
+            try db.beginTransaction(.deferred)
+            // Acquire snapshot isolation
+            try db.clearSchemaCacheIfNeeded()
+            // We must expect an error: https://www.sqlite.org/c3ref/snapshot_get.html
+            // > At least one transaction must be written to it first.
+            return try? db.takeVersionSnapshot()
+        }
+        if let snapshot = snapshot {
+            defer { sqlite3_snapshot_free(snapshot) }
+            for connection in connections.dropFirst() {
+                try connection.sync { db in
+                    try db.beginTransaction(.deferred)
+                    try db.openVersionSnapshot(snapshot)
+                    try db.clearSchemaCacheIfNeeded()
+                }
+            }
+            return
+        }
+        
+        // No snapshot: use the fallback below
+        try connections[0].sync { db in
+            try db.commit()
+        }
+        #endif
+        
+        // Prevent writes until all connections have acquired
+        // snapshot isolation.
+        try writer.sync { _ in
+            for connection in connections {
+                try connection.sync { db in
+                    try db.beginTransaction(.deferred)
+                    // Acquire snapshot isolation
+                    try db.clearSchemaCacheIfNeeded()
+                }
+            }
+        }
+    }
+    
     // MARK: - Writing in Database
     
     /// Synchronously executes database updates in a protected dispatch queue,
@@ -786,6 +1285,33 @@ extension DatabasePool: DatabaseReader {
         try writer.reentrantSync(updates)
     }
     
+    /// Asynchronously executes database updates in a protected dispatch queue,
+    /// wrapped inside a transaction.
+    ///
+    /// If the updates throw an error, the transaction is rollbacked.
+    ///
+    /// The *completion* closure is always called with the result of the
+    /// database updates. Its arguments are a database connection and the
+    /// result of the transaction. This result is a failure if the transaction
+    /// could not be committed. The completion closure is executed in a
+    /// protected dispatch queue, outside of any transaction.
+    ///
+    /// When `Configuration.groupCommitMaximumCount` is set, the updates may
+    /// share their transaction with other asynchronous writes. They run in a
+    /// savepoint of the shared transaction.
+    ///
+    /// This method is *not* reentrant.
+    ///
+    /// - parameter updates: The updates to the database.
+    /// - parameter completion: A closure that is called with the eventual
+    ///   transaction error.
+    public func asyncWrite<T>(
+        _ updates: @escaping (Database) throws -> T,
+        completion: @escaping (Database, Result<T, Error>) -> Void)
+    {
+        writer.asyncWrite(updates, completion: completion)
+    }
+    
     /// Asynchronously executes database updates in a protected dispatch queue,
     /// outside of any transaction.
     ///
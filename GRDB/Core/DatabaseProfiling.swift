@@ -0,0 +1,231 @@
+import Foundation
+
+extension Database {
+    
+    // MARK: - Profiling
+    
+    /// Profiling statistics about the statements and transactions executed
+    /// by the database connection.
+    ///
+    /// Statistics are only collected when `Configuration.profilingEnabled`
+    /// is true. Otherwise, this property returns empty statistics.
+    ///
+    /// Statistics are only available on platforms that support the
+    /// `sqlite3_trace_v2` function (SQLite 3.14+, but not Linux).
+    public var profilingStatistics: ProfilingStatistics {
+        SchedulingWatchdog.preconditionValidQueue(self)
+        return profiler?.statistics ?? ProfilingStatistics()
+    }
+    
+    /// Resets the profiling statistics of the database connection.
+    public func resetProfilingStatistics() {
+        SchedulingWatchdog.preconditionValidQueue(self)
+        profiler?.statistics = ProfilingStatistics()
+    }
+}
+
+/// Profiling statistics about the statements and transactions executed by
+/// database connections.
+///
+/// See `Configuration.profilingEnabled` and `Database.profilingStatistics`.
+public struct ProfilingStatistics {
+    /// Statistics about executed statements, keyed by SQL.
+    ///
+    /// The SQL is the SQL of prepared statements, where statement arguments
+    /// are not expanded.
+    public internal(set) var statements: [String: StatementProfilingStatistics] = [:]
+    
+    /// The durations of transactions.
+    public internal(set) var transactionDurations = DurationHistogram()
+    
+    /// Returns statistics that aggregate two statistics (from two database
+    /// connections, for example).
+    public static func + (lhs: Self, rhs: Self) -> Self {
+        var result = lhs
+        result.statements.merge(rhs.statements, uniquingKeysWith: +)
+        result.transactionDurations = lhs.transactionDurations + rhs.transactionDurations
+        return result
+    }
+}
+
+/// Profiling statistics about the executions of an SQL statement.
+///
+/// Counters come from `sqlite3_stmt_status`, see
+/// https://www.sqlite.org/c3ref/c_stmtstatus_counter.html
+public struct StatementProfilingStatistics {
+    /// The durations of statement executions.
+    public internal(set) var durations = DurationHistogram()
+    
+    /// The number of times that SQLite has stepped forward in a table as
+    /// part of a full table scan (`SQLITE_STMTSTATUS_FULLSCAN_STEP`).
+    public internal(set) var fullScanStepCount = 0
+    
+    /// The number of sort operations (`SQLITE_STMTSTATUS_SORT`).
+    public internal(set) var sortCount = 0
+    
+    /// The number of rows inserted into transient indices that were created
+    /// automatically (`SQLITE_STMTSTATUS_AUTOINDEX`).
+    public internal(set) var autoIndexCount = 0
+    
+    /// The number of virtual machine operations (`SQLITE_STMTSTATUS_VM_STEP`).
+    public internal(set) var virtualMachineStepCount = 0
+    
+    /// The number of statement executions.
+    public var executionCount: Int { durations.count }
+    
+    /// The total duration of statement executions.
+    public var totalDuration: TimeInterval { durations.totalDuration }
+    
+    /// The average duration of statement executions.
+    public var averageDuration: TimeInterval { durations.averageDuration }
+    
+    /// The estimated median duration of statement executions.
+    public var medianDuration: TimeInterval { durations.percentile(0.5) }
+    
+    /// The estimated 99th percentile of the duration of
+    /// statement executions.
+    public var p99Duration: TimeInterval { durations.percentile(0.99) }
+    
+    /// :nodoc:
+    public static func + (lhs: Self, rhs: Self) -> Self {
+        var result = lhs
+        result.durations = lhs.durations + rhs.durations
+        result.fullScanStepCount += rhs.fullScanStepCount
+        result.sortCount += rhs.sortCount
+        result.autoIndexCount += rhs.autoIndexCount
+        result.virtualMachineStepCount += rhs.virtualMachineStepCount
+        return result
+    }
+}
+
+/// A histogram of durations, with buckets of exponentially
+/// increasing sizes.
+///
+/// The bucket at index 0 counts durations below one microsecond. The bucket
+/// at index `i > 0` counts durations from 2^(i-1) microseconds (included) to
+/// 2^i microseconds (excluded). The last bucket counts all longer durations.
+public struct DurationHistogram {
+    /// The number of buckets.
+    public static let bucketCount = 32
+    
+    /// The number of durations in each bucket.
+    public private(set) var bucketCounts = Array(repeating: 0, count: DurationHistogram.bucketCount)
+    
+    /// The number of durations.
+    public private(set) var count = 0
+    
+    /// The sum of all durations.
+    public private(set) var totalDuration: TimeInterval = 0
+    
+    /// The longest duration.
+    public private(set) var maximumDuration: TimeInterval = 0
+    
+    /// The average duration.
+    public var averageDuration: TimeInterval {
+        count == 0 ? 0 : totalDuration / Double(count)
+    }
+    
+    /// Returns the upper bound of the durations counted in a bucket.
+    public static func upperBound(ofBucketAt index: Int) -> TimeInterval {
+        TimeInterval(UInt64(1) << UInt64(index)) / 1.0e6
+    }
+    
+    /// Returns an estimation of a duration percentile.
+    ///
+    /// The estimation is the upper bound of the bucket that contains the
+    /// percentile, bounded by the maximum duration.
+    ///
+    /// - parameter fraction: A number between 0 and 1.
+    public func percentile(_ fraction: Double) -> TimeInterval {
+        GRDBPrecondition(fraction >= 0 && fraction <= 1, "Invalid percentile")
+        if count == 0 {
+            return 0
+        }
+        let rank = max(1, Int((fraction * Double(count)).rounded(.up)))
+        var cumulatedCount = 0
+        for (index, bucketCount) in bucketCounts.enumerated() {
+            cumulatedCount += bucketCount
+            if cumulatedCount >= rank {
+                return min(Self.upperBound(ofBucketAt: index), maximumDuration)
+            }
+        }
+        return maximumDuration
+    }
+    
+    mutating func record(nanoseconds: Int64) {
+        let microseconds = UInt64(max(0, nanoseconds)) / 1000
+        let index = microseconds == 0
+            ? 0
+            : min(64 - microseconds.leadingZeroBitCount, Self.bucketCount - 1)
+        let duration = TimeInterval(nanoseconds) / 1.0e9
+        bucketCounts[index] += 1
+        count += 1
+        totalDuration += duration
+        maximumDuration = max(maximumDuration, duration)
+    }
+    
+    /// :nodoc:
+    public static func + (lhs: Self, rhs: Self) -> Self {
+        var result = lhs
+        for index in result.bucketCounts.indices {
+            result.bucketCounts[index] += rhs.bucketCounts[index]
+        }
+        result.count += rhs.count
+        result.totalDuration += rhs.totalDuration
+        result.maximumDuration = max(lhs.maximumDuration, rhs.maximumDuration)
+        return result
+    }
+}
+
+/// Collects profiling statistics for a database connection.
+///
+/// The profiler is only accessed from the database dispatch queue: it does
+/// not need any lock.
+struct DatabaseProfiler {
+    var statistics = ProfilingStatistics()
+    
+    /// The start of the current transaction
+    private var transactionStart: DispatchTime?
+    
+    /// Called from the SQLITE_TRACE_PROFILE trace callback.
+    mutating func statementDidExecute(_ sqliteStatement: SQLiteStatement, nanoseconds: Int64) {
+        guard let cString = sqlite3_sql(sqliteStatement) else {
+            return
+        }
+        let sql = String(cString: cString)
+        
+        // Reset counters, so that next execution starts from zero.
+        func status(_ op: Int32) -> Int {
+            Int(sqlite3_stmt_status(sqliteStatement, op, 1))
+        }
+        
+        let fullScanStepCount = status(SQLITE_STMTSTATUS_FULLSCAN_STEP)
+        let sortCount = status(SQLITE_STMTSTATUS_SORT)
+        let autoIndexCount = status(SQLITE_STMTSTATUS_AUTOINDEX)
+        let virtualMachineStepCount = status(SQLITE_STMTSTATUS_VM_STEP)
+        
+        // Mutate in place, in order to avoid copying the histogram.
+        if statistics.statements[sql] == nil {
+            statistics.statements[sql] = StatementProfilingStatistics()
+        }
+        statistics.statements[sql]!.durations.record(nanoseconds: nanoseconds)
+        statistics.statements[sql]!.fullScanStepCount += fullScanStepCount
+        statistics.statements[sql]!.sortCount += sortCount
+        statistics.statements[sql]!.autoIndexCount += autoIndexCount
+        statistics.statements[sql]!.virtualMachineStepCount += virtualMachineStepCount
+    }
+    
+    /// Called after each execution of an update statement, in order to
+    /// measure the duration of transactions.
+    mutating func updateStatementDidExecute(isInsideTransaction: Bool) {
+        if isInsideTransaction {
+            if transactionStart == nil {
+                transactionStart = DispatchTime.now()
+            }
+        } else if let start = transactionStart {
+            transactionStart = nil
+            let nanoseconds = DispatchTime.now().uptimeNanoseconds - start.uptimeNanoseconds
+            statistics.transactionDurations.record(nanoseconds: Int64(nanoseconds))
+        }
+    }
+}
@@ -8,6 +8,9 @@ import UIKit
 public final class DatabaseQueue: DatabaseWriter {
     private var writer: SerializedDatabase
     
+    /// Not nil when configuration.memoryBudget is set
+    private var memoryGovernor: MemoryGovernor?
+    
     // MARK: - Configuration
     
     /// The database configuration
@@ -40,6 +43,10 @@ public final class DatabaseQueue: DatabaseWriter {
         
         setupSuspension()
         
+        if let memoryBudget = configuration.memoryBudget {
+            setupMemoryGovernor(memoryBudget)
+        }
+        
         // Be a nice iOS citizen, and don't consume too much memory
         // See https://github.com/groue/GRDB.swift/#memory-management
         #if os(iOS)
@@ -60,6 +67,10 @@ public final class DatabaseQueue: DatabaseWriter {
             path: ":memory:",
             configuration: configuration,
             defaultLabel: "GRDB.DatabaseQueue")
+        
+        if let memoryBudget = configuration.memoryBudget {
+            setupMemoryGovernor(memoryBudget)
+        }
     }
     
     deinit {
@@ -82,6 +93,18 @@ extension DatabaseQueue {
         writer.sync { $0.releaseMemory() }
     }
     
+    private func setupMemoryGovernor(_ budget: MemoryBudget) {
+        memoryGovernor = MemoryGovernor(
+            budget: budget,
+            label: configuration.identifier(defaultLabel: "GRDB.DatabaseQueue", purpose: "memoryGovernor"),
+            trimMemory: { [weak self] level in
+                // The database releases memory after its pending work
+                self?.writer.async { db in
+                    try? db.trimMemory(level, constrainedCacheSize: budget.constrainedCacheSize)
+                }
+            })
+    }
+    
     #if os(iOS)
     /// Listens to UIApplicationDidEnterBackgroundNotification and
     /// UIApplicationDidReceiveMemoryWarningNotification in order to release
@@ -447,6 +470,33 @@ extension DatabaseQueue {
         try writer.reentrantSync(updates)
     }
     
+    /// Asynchronously executes database updates in a protected dispatch queue,
+    /// wrapped inside a transaction.
+    ///
+    /// If the updates throw an error, the transaction is rollbacked.
+    ///
+    /// The *completion* closure is always called with the result of the
+    /// database updates. Its arguments are a database connection and the
+    /// result of the transaction. This result is a failure if the transaction
+    /// could not be committed. The completion closure is executed in a
+    /// protected dispatch queue, outside of any transaction.
+    ///
+    /// When `Configuration.groupCommitMaximumCount` is set, the updates may
+    /// share their transaction with other asynchronous writes. They run in a
+    /// savepoint of the shared transaction.
+    ///
+    /// This method is *not* reentrant.
+    ///
+    /// - parameter updates: The updates to the database.
+    /// - parameter completion: A closure that is called with the eventual
+    ///   transaction error.
+    public func asyncWrite<T>(
+        _ updates: @escaping (Database) throws -> T,
+        completion: @escaping (Database, Result<T, Error>) -> Void)
+    {
+        writer.asyncWrite(updates, completion: completion)
+    }
+    
     /// Asynchronously executes database updates in a protected dispatch queue,
     /// outside of any transaction.
     public func asyncWriteWithoutTransaction(_ updates: @escaping (Database) -> Void) {
@@ -340,6 +340,111 @@ extension Publisher where Failure == Error {
 }
 #endif
 
+#if swift(>=5.5) && canImport(_Concurrency)
+extension DatabaseReader {
+    // MARK: - Asynchronous Database Access
+    
+    /// Asynchronously executes a read-only function that accesses the
+    /// database, and returns its result.
+    ///
+    ///     let players = try await dbQueue.read { db in
+    ///         try Player.fetchAll(db)
+    ///     }
+    ///
+    /// The current task is suspended until the database is available: no
+    /// thread is blocked while waiting. In a database pool, the function runs
+    /// concurrently with other reads and writes.
+    ///
+    /// When the current task is cancelled, the database access is
+    /// interrupted, and a `CancellationError`, or a DatabaseError of code
+    /// `SQLITE_INTERRUPT`, is thrown.
+    ///
+    /// Attempts to write in the database throw a DatabaseError of
+    /// resultCode `SQLITE_READONLY`.
+    ///
+    /// - parameter value: A function that accesses the database.
+    /// - throws: The error thrown by `value`, or any DatabaseError that would
+    ///   happen while establishing the read access to the database.
+    @available(OSX 10.15, iOS 13, tvOS 13, watchOS 6, *)
+    public func read<T>(_ value: @escaping (Database) throws -> T) async throws -> T {
+        try await withDatabaseCancellation { cancellation in
+            try await withUnsafeThrowingContinuation { continuation in
+                asyncRead { dbResult in
+                    continuation.resume(with: Result {
+                        try cancellation.access(dbResult.get(), value)
+                    })
+                }
+            }
+        }
+    }
+}
+
+/// Interrupts a database access when the task that waits for it
+/// is cancelled.
+@available(OSX 10.15, iOS 13, tvOS 13, watchOS 6, *)
+final class DatabaseCancellation {
+    private enum State {
+        case idle
+        case accessing(Database)
+        case cancelled
+    }
+    
+    @LockedBox private var state = State.idle
+    
+    /// Runs `body`, a database access that is interrupted if the
+    /// cancellation is triggered during its execution.
+    ///
+    /// - throws: CancellationError if the cancellation was triggered before
+    ///   the database access could start, or the error thrown by `body`.
+    func access<T>(_ db: Database, _ body: (Database) throws -> T) throws -> T {
+        try $state.update { state in
+            if case .cancelled = state {
+                throw CancellationError()
+            }
+            state = .accessing(db)
+        }
+        defer {
+            $state.update { state in
+                if case .accessing = state {
+                    state = .idle
+                }
+            }
+        }
+        return try body(db)
+    }
+    
+    /// Interrupts the current database access, and prevents any
+    /// further access.
+    func cancel() {
+        $state.update { state in
+            if case let .accessing(db) = state {
+                db.interrupt()
+            }
+            state = .cancelled
+        }
+    }
+}
+
+/// Runs `operation` with a DatabaseCancellation that is triggered when the
+/// current task is cancelled.
+@available(OSX 10.15, iOS 13, tvOS 13, watchOS 6, *)
+func withDatabaseCancellation<T>(
+    _ operation: (DatabaseCancellation) async throws -> T)
+async throws -> T
+{
+    let cancellation = DatabaseCancellation()
+    #if compiler(>=5.7)
+    return try await withTaskCancellationHandler(
+        operation: { try await operation(cancellation) },
+        onCancel: { cancellation.cancel() })
+    #else
+    return try await withTaskCancellationHandler(
+        handler: { cancellation.cancel() },
+        operation: { try await operation(cancellation) })
+    #endif
+}
+#endif
+
 extension DatabaseReader {
     // MARK: - Value Observation Support
     
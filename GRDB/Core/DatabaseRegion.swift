@@ -51,6 +51,11 @@ public struct DatabaseRegion: CustomStringConvertible, Equatable {
         tableRegions == nil
     }
     
+    /// The names of the tables in the region, or nil for the full database.
+    var tableNames: [CaseInsensitiveIdentifier]? {
+        tableRegions.map { Array($0.keys) }
+    }
+    
     /// The region that covers the full database: all columns and all rows
     /// from all tables.
     public static let fullDatabase = DatabaseRegion(tableRegions: nil)
@@ -117,10 +117,11 @@ extension DatabaseRegionObservation {
 }
 #endif
 
-private class DatabaseRegionObserver: TransactionObserver {
+private class DatabaseRegionObserver: DatabaseRegionTransactionObserver {
     let region: DatabaseRegion
     let onChange: (Database) -> Void
     var isChanged = false
+    var observedRegion: DatabaseRegion? { region }
     
     init(region: DatabaseRegion, onChange: @escaping (Database) -> Void) {
         self.region = region
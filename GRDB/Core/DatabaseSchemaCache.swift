@@ -26,6 +26,17 @@ struct DatabaseSchemaCache {
     private var indexes: [String: Presence<[IndexInfo]>] = [:]
     private var foreignKeys: [String: Presence<[ForeignKeyInfo]>] = [:]
     
+    /// Adds the values of another cache for the same schema.
+    mutating func formUnion(_ other: DatabaseSchemaCache) {
+        if schemaInfo == nil {
+            schemaInfo = other.schemaInfo
+        }
+        primaryKeys.merge(other.primaryKeys, uniquingKeysWith: { $1 })
+        columns.merge(other.columns, uniquingKeysWith: { $1 })
+        indexes.merge(other.indexes, uniquingKeysWith: { $1 })
+        foreignKeys.merge(other.foreignKeys, uniquingKeysWith: { $1 })
+    }
+    
     mutating func clear() {
         primaryKeys = [:]
         columns = [:]
@@ -66,3 +77,72 @@ struct DatabaseSchemaCache {
         self.foreignKeys[table] = foreignKeys
     }
 }
+
+/// A thread-safe cache of the main database schema, shared by all
+/// connections of a database pool.
+///
+/// The cache contains the schema information of a single schema version,
+/// as reported by `PRAGMA schema_version`. Connections that read another
+/// version of the schema (because they were not refreshed yet, or because
+/// their WAL snapshot predates a schema change) do not use the shared cache.
+final class SharedDatabaseSchemaCache {
+    private struct State {
+        var schemaVersion: Int32?
+        var generation = 0
+        var cache = DatabaseSchemaCache()
+    }
+    
+    @ReadWriteBox private var state = State()
+    
+    /// Incremented whenever the cache is cleared.
+    var generation: Int {
+        $state.read { $0.generation }
+    }
+    
+    /// Returns the cache for the given schema version, or nil if the shared
+    /// cache can not be used for this version.
+    func cache(forSchemaVersion schemaVersion: Int32) -> DatabaseSchemaCache? {
+        $state.read { state in
+            guard let cachedVersion = state.schemaVersion else {
+                return DatabaseSchemaCache()
+            }
+            if cachedVersion == schemaVersion {
+                return state.cache
+            }
+            if cachedVersion < schemaVersion {
+                // The cache will be replaced
+                return DatabaseSchemaCache()
+            }
+            return nil
+        }
+    }
+    
+    /// Stores schema information for the given schema version.
+    ///
+    /// The information about older schema versions is discarded.
+    func merge(_ cache: DatabaseSchemaCache, forSchemaVersion schemaVersion: Int32) {
+        $state.update { state in
+            if let cachedVersion = state.schemaVersion {
+                if cachedVersion == schemaVersion {
+                    state.cache.formUnion(cache)
+                    return
+                }
+                if cachedVersion > schemaVersion {
+                    return
+                }
+            }
+            state.schemaVersion = schemaVersion
+            state.cache = cache
+        }
+    }
+    
+    /// Clears the cache, and notifies connections that they should clear
+    /// their own schema cache.
+    func clear() {
+        $state.update { state in
+            state.schemaVersion = nil
+            state.cache = DatabaseSchemaCache()
+            state.generation += 1
+        }
+    }
+}
@@ -523,6 +523,77 @@ extension Publisher where Failure == Error {
 }
 #endif
 
+#if swift(>=5.5) && canImport(_Concurrency)
+extension DatabaseWriter {
+    // MARK: - Asynchronous Database Access
+    
+    /// Asynchronously executes database updates, wrapped inside a
+    /// transaction, and returns their result.
+    ///
+    ///     let newPlayerCount = try await dbQueue.write { db -> Int in
+    ///         try Player(...).insert(db)
+    ///         return try Player.fetchCount(db)
+    ///     }
+    ///
+    /// The current task is suspended until the writer is available: no
+    /// thread is blocked while waiting.
+    ///
+    /// If the updates throw an error, the transaction is rollbacked and the
+    /// error is rethrown.
+    ///
+    /// When the current task is cancelled, the database access is
+    /// interrupted, the transaction is rollbacked, and a `CancellationError`,
+    /// or a DatabaseError of code `SQLITE_INTERRUPT`, is thrown.
+    ///
+    /// - parameter updates: A function that updates the database.
+    /// - throws: The error thrown by the updates, or by the
+    ///   wrapping transaction.
+    @available(OSX 10.15, iOS 13, tvOS 13, watchOS 6, *)
+    public func write<T>(_ updates: @escaping (Database) throws -> T) async throws -> T {
+        try await withDatabaseCancellation { cancellation in
+            try await withUnsafeThrowingContinuation { continuation in
+                asyncWrite(
+                    { db in try cancellation.access(db, updates) },
+                    completion: { _, result in continuation.resume(with: result) })
+            }
+        }
+    }
+    
+    /// Asynchronously executes database updates, outside of any transaction,
+    /// and returns their result.
+    ///
+    ///     let newPlayerCount = try await dbQueue.writeWithoutTransaction { db -> Int in
+    ///         try Player(...).insert(db)
+    ///         return try Player.fetchCount(db)
+    ///     }
+    ///
+    /// The current task is suspended until the writer is available: no
+    /// thread is blocked while waiting.
+    ///
+    /// When the current task is cancelled, the database access is
+    /// interrupted, and a `CancellationError`, or a DatabaseError of code
+    /// `SQLITE_INTERRUPT`, is thrown.
+    ///
+    /// - parameter updates: A function that updates the database.
+    /// - throws: The error thrown by the updates.
+    @available(OSX 10.15, iOS 13, tvOS 13, watchOS 6, *)
+    public func writeWithoutTransaction<T>(
+        _ updates: @escaping (Database) throws -> T)
+    async throws -> T
+    {
+        try await withDatabaseCancellation { cancellation in
+            try await withUnsafeThrowingContinuation { continuation in
+                asyncWriteWithoutTransaction { db in
+                    continuation.resume(with: Result {
+                        try cancellation.access(db, updates)
+                    })
+                }
+            }
+        }
+    }
+}
+#endif
+
 /// A future database value, returned by the DatabaseWriter.concurrentRead(_:)
 /// method.
 ///
@@ -42,6 +42,32 @@ extension FetchRequest {
     public func databaseRegion(_ db: Database) throws -> DatabaseRegion {
         try makePreparedRequest(db, forSingleResult: false).statement.databaseRegion
     }
+    
+    /// Returns whether the request fetches at least one row.
+    ///
+    ///     // SELECT EXISTS (SELECT * FROM player WHERE score > 1000)
+    ///     let request = Player.filter(Column("score") > 1000)
+    ///     let hasHighScores = try request.exists(db)
+    ///
+    /// This method is more efficient than `fetchCount(db) > 0`, or
+    /// `fetchOne(db) != nil`: SQLite stops looking for rows as soon as one
+    /// is found, and no row is decoded.
+    ///
+    /// - parameter db: A database connection.
+    public func exists(_ db: Database) throws -> Bool {
+        let request: SQLRequest<Bool> = "SELECT \(SQLExpression.exists(sqlSubquery))"
+        return try request.fetchOne(db)!
+    }
+    
+    /// Returns whether the request does not fetch any row.
+    ///
+    ///     // SELECT EXISTS (SELECT * FROM player)
+    ///     let noPlayer = try Player.all().isEmpty(db)
+    ///
+    /// - parameter db: A database connection.
+    public func isEmpty(_ db: Database) throws -> Bool {
+        try !exists(db)
+    }
 }
 
 // MARK: - PreparedRequest
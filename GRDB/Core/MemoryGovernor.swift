@@ -0,0 +1,149 @@
+import Foundation
+
+/// A MemoryBudget defines memory thresholds above which database connections
+/// progressively release memory.
+///
+///     var config = Configuration()
+///     config.memoryBudget = MemoryBudget(
+///         softLimit: 64 * 1024 * 1024,
+///         hardLimit: 128 * 1024 * 1024)
+///     let dbPool = try DatabasePool(path: "...", configuration: config)
+///
+/// Memory usage is the memory allocated by SQLite, as reported by
+/// `sqlite3_status64(SQLITE_STATUS_MEMORY_USED)`. It includes the memory of
+/// prepared statements, such as the cached statements of GRDB, and of the
+/// page caches. It is shared by all database connections of the process. See
+/// https://www.sqlite.org/c3ref/c_status_malloc_count.html
+///
+/// Memory allocated by GRDB itself, such as schema caches, or the values
+/// fetched by your application, is not measured and does not count against
+/// the budget. Schema caches are still cleared above the hard limit.
+///
+/// Above the soft limit, connections evict the cached statements that were
+/// not used since the previous check, and release the unused memory of their
+/// page cache. Hot statements are kept.
+///
+/// Above the hard limit, available read-only connections of database pools
+/// are closed as well, cached statements and schema information are cleared,
+/// and the page cache is limited to `constrainedCacheSize`. The default page
+/// cache size is restored when memory usage goes back below the soft limit.
+///
+/// Connections that are busy when the limit is checked are not interrupted:
+/// the writer connection releases memory after its pending work, and busy
+/// read-only connections are left untouched.
+public struct MemoryBudget {
+    /// The memory usage, in bytes, above which connections evict their cold
+    /// cached statements.
+    public var softLimit: Int
+    
+    /// The memory usage, in bytes, above which connections release as much
+    /// memory as possible.
+    public var hardLimit: Int
+    
+    /// The value of `PRAGMA cache_size` (see
+    /// https://www.sqlite.org/pragma.html#pragma_cache_size) above the
+    /// hard limit. Negative values are in kibibytes.
+    public var constrainedCacheSize: Int
+    
+    /// The time interval between two checks of the memory usage.
+    public var checkInterval: TimeInterval
+    
+    /// Creates a memory budget.
+    ///
+    /// - parameters:
+    ///     - softLimit: The memory usage, in bytes, above which cold cached
+    ///       statements are evicted.
+    ///     - hardLimit: The memory usage, in bytes, above which as much
+    ///       memory as possible is released.
+    ///     - constrainedCacheSize: The page cache size above the hard limit.
+    ///     - checkInterval: The time interval between two checks of the
+    ///       memory usage.
+    public init(
+        softLimit: Int,
+        hardLimit: Int,
+        constrainedCacheSize: Int = -512,
+        checkInterval: TimeInterval = 5)
+    {
+        GRDBPrecondition(softLimit <= hardLimit, "Memory budget soft limit must not exceed the hard limit")
+        GRDBPrecondition(checkInterval > 0, "Memory budget check interval must be positive")
+        self.softLimit = softLimit
+        self.hardLimit = hardLimit
+        self.constrainedCacheSize = constrainedCacheSize
+        self.checkInterval = checkInterval
+    }
+}
+
+/// MemoryGovernor periodically checks the memory usage of SQLite against a
+/// memory budget, and asks database connections to release memory.
+final class MemoryGovernor {
+    /// The memory pressure, from the least to the most constraining.
+    enum Level {
+        /// Memory usage is below the soft limit
+        case normal
+        
+        /// Memory usage is between the soft limit and the hard limit
+        case soft
+        
+        /// Memory usage is above the hard limit
+        case hard
+    }
+    
+    private let budget: MemoryBudget
+    
+    /// Asks database connections to release memory
+    private let trimMemory: (Level) -> Void
+    private let queue: DispatchQueue
+    private var level = Level.normal // Only accessed from queue
+    
+    /// Creates a memory governor.
+    ///
+    /// - parameters:
+    ///     - budget: A memory budget.
+    ///     - label: The label of the governor dispatch queue.
+    ///     - trimMemory: A function that asks database connections to
+    ///       release memory. It is not called while the memory usage
+    ///       remains below the soft limit.
+    init(budget: MemoryBudget, label: String, trimMemory: @escaping (Level) -> Void) {
+        self.budget = budget
+        self.trimMemory = trimMemory
+        self.queue = DispatchQueue(label: label, qos: .utility)
+        scheduleCheck()
+    }
+    
+    /// The memory allocated by SQLite, in bytes. It does not include the
+    /// memory allocated by GRDB.
+    static var sqliteMemoryUsed: Int {
+        var current: sqlite3_int64 = 0
+        var highwater: sqlite3_int64 = 0
+        sqlite3_status64(SQLITE_STATUS_MEMORY_USED, &current, &highwater, 0)
+        return Int(current)
+    }
+    
+    /// Schedules a check. The governor is not retained.
+    private func scheduleCheck() {
+        queue.asyncAfter(deadline: .now() + budget.checkInterval) { [weak self] in
+            guard let self = self else { return }
+            self.check()
+            self.scheduleCheck()
+        }
+    }
+    
+    private func check() {
+        let memoryUsed = Self.sqliteMemoryUsed
+        let newLevel: Level
+        if memoryUsed > budget.hardLimit {
+            newLevel = .hard
+        } else if memoryUsed > budget.softLimit {
+            newLevel = .soft
+        } else {
+            newLevel = .normal
+        }
+        
+        // Notify normal level once, so that constrained connections can
+        // restore their page cache.
+        if newLevel != .normal || level != .normal {
+            trimMemory(newLevel)
+        }
+        level = newLevel
+    }
+}
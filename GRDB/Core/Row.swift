@@ -1819,6 +1819,9 @@ extension Row {
         private let scopes: [String: _LayoutedRowAdapter]
         private let prefetchedRows: Row.PrefetchedRowsView
         
+        /// Nil when scopes are not defined by `ScopeAdapter`
+        fileprivate let scopeTree: LayoutedScopeTree?
+        
         /// The scopes defined on this row.
         public var names: Dictionary<String, _LayoutedRowAdapter>.Keys {
             scopes.keys
@@ -1828,9 +1831,15 @@ extension Row {
             self.init(row: Row(), scopes: [:], prefetchedRows: Row.PrefetchedRowsView())
         }
         
-        init(row: Row, scopes: [String: _LayoutedRowAdapter], prefetchedRows: Row.PrefetchedRowsView) {
+        init(
+            row: Row,
+            scopes: [String: _LayoutedRowAdapter],
+            scopeTree: LayoutedScopeTree? = nil,
+            prefetchedRows: Row.PrefetchedRowsView)
+        {
             self.row = row
             self.scopes = scopes
+            self.scopeTree = scopeTree
             self.prefetchedRows = prefetchedRows
         }
         
@@ -1871,6 +1880,21 @@ extension Row {
         public subscript(_ name: String) -> Row? {
             scopes.index(forKey: name).map { self[$0].row }
         }
+        
+        /// Returns the row of a nested scope.
+        fileprivate func row(for scope: LayoutedScopeTree.Scope) -> Row {
+            let adaptedRow = Row(base: row, adapter: scope.adapter)
+            // Same prefetched rows as the nested row that would be
+            // reached through `scopes`, one level after the other.
+            var prefetches = prefetchedRows.prefetches
+            for name in scope.path {
+                prefetches = prefetches[name]?.prefetches ?? [:]
+            }
+            if !prefetches.isEmpty {
+                adaptedRow.prefetchedRows = Row.PrefetchedRowsView(prefetches: prefetches)
+            }
+            return adaptedRow
+        }
     }
 }
 
@@ -1902,6 +1926,9 @@ extension Row {
         
         /// The scopes defined on this row, recursively.
         public var names: Set<String> {
+            if let scopeTree = scopes.scopeTree {
+                return scopeTree.names
+            }
             var names = Set<String>()
             for (name, row) in scopes {
                 names.insert(name)
@@ -1938,6 +1965,9 @@ extension Row {
         ///
         /// Nil is returned if the scope is not available.
         public subscript(_ name: String) -> Row? {
+            if let scopeTree = scopes.scopeTree {
+                return scopeTree.scope(named: name).map(scopes.row(for:))
+            }
             var fifo = Array(scopes)
             while !fifo.isEmpty {
                 let scope = fifo.removeFirst()
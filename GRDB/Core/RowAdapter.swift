@@ -412,6 +412,66 @@ public struct ScopeAdapter: RowAdapter {
 struct LayoutedScopeAdapter: _LayoutedRowAdapter {
     let _mapping: _LayoutedColumnMapping
     let _scopes: [String: _LayoutedRowAdapter]
+    
+    /// The flattened scopes, resolved once for all rows fetched with
+    /// this adapter.
+    let scopeTree: LayoutedScopeTree
+    
+    init(_mapping: _LayoutedColumnMapping, _scopes: [String: _LayoutedRowAdapter]) {
+        self._mapping = _mapping
+        self._scopes = _scopes
+        self.scopeTree = LayoutedScopeTree(scopes: _scopes)
+    }
+}
+
+/// The scopes of a layouted adapter, and their nested scopes, flattened in
+/// breadth-first order.
+///
+/// It supports `Row.scopesTree`, which would otherwise visit nested scopes
+/// for each row.
+final class LayoutedScopeTree {
+    struct Scope {
+        /// The names of the scope and of its ancestors, starting from
+        /// the root.
+        var path: [String]
+        
+        var adapter: _LayoutedRowAdapter
+    }
+    
+    /// All scopes, in breadth-first order
+    let scopes: [Scope]
+    
+    /// The names of all scopes
+    let names: Set<String>
+    
+    /// [name: index of the first scope with this name in `scopes`]
+    private let scopeIndexes: [String: Int]
+    
+    init(scopes rootScopes: [String: _LayoutedRowAdapter]) {
+        var scopes = rootScopes.map { Scope(path: [$0.key], adapter: $0.value) }
+        var index = 0
+        while index < scopes.count {
+            let scope = scopes[index]
+            for (name, adapter) in scope.adapter._scopes {
+                scopes.append(Scope(path: scope.path + [name], adapter: adapter))
+            }
+            index += 1
+        }
+        
+        var scopeIndexes: [String: Int] = [:]
+        for (index, scope) in scopes.enumerated() where scopeIndexes[scope.path.last!] == nil {
+            scopeIndexes[scope.path.last!] = index
+        }
+        
+        self.scopes = scopes
+        self.names = Set(scopeIndexes.keys)
+        self.scopeIndexes = scopeIndexes
+    }
+    
+    /// Returns the first scope with the given name, in breadth-first order.
+    func scope(named name: String) -> Scope? {
+        scopeIndexes[name].map { scopes[$0] }
+    }
 }
 
 struct ChainedAdapter: RowAdapter {
@@ -479,7 +539,11 @@ struct AdaptedRowImpl: RowImpl {
     var isFetched: Bool { base.isFetched }
     
     func scopes(prefetchedRows: Row.PrefetchedRowsView) -> Row.ScopesView {
-        Row.ScopesView(row: base, scopes: adapter._scopes, prefetchedRows: prefetchedRows)
+        Row.ScopesView(
+            row: base,
+            scopes: adapter._scopes,
+            scopeTree: (adapter as? LayoutedScopeAdapter)?.scopeTree,
+            prefetchedRows: prefetchedRows)
     }
     
     func hasNull(atUncheckedIndex index: Int) -> Bool {
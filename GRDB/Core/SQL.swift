@@ -123,6 +123,34 @@ public struct SQL {
     func qualified(with alias: TableAlias) -> SQL {
         SQL(elements: elements.map { $0.qualified(with: alias) })
     }
+    
+    /// Appends the fingerprint of the literal, and the values of its
+    /// arguments, in the same order as `sql(_:)`.
+    ///
+    /// Returns false if the literal has no fingerprint, because it contains
+    /// subqueries or named arguments.
+    func fingerprint(_ fingerprinter: inout SQLFingerprinter) -> Bool {
+        fingerprinter.append(.count(elements.count))
+        for element in elements {
+            switch element {
+            case let .sql(sql, arguments):
+                guard arguments.namedValues.isEmpty else {
+                    return false
+                }
+                fingerprinter.append(.name(sql))
+                fingerprinter.append(arguments: arguments.values)
+            case .subquery:
+                return false
+            case let .expression(expression):
+                guard expression.fingerprint(&fingerprinter) else { return false }
+            case let .selection(selection):
+                guard selection.fingerprint(&fingerprinter) else { return false }
+            case let .ordering(ordering):
+                guard ordering.fingerprint(&fingerprinter) else { return false }
+            }
+        }
+        return true
+    }
 }
 
 extension SQL {
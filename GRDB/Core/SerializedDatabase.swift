@@ -14,6 +14,9 @@ final class SerializedDatabase {
     /// The dispatch queue
     private let queue: DispatchQueue
     
+    /// The writes waiting for a group commit
+    @LockedBox private var groupedWrites: [GroupedWrite] = []
+    
     init(
         path: String,
         configuration: Configuration = Configuration(),
@@ -206,6 +209,88 @@ final class SerializedDatabase {
         }
     }
     
+    /// Asynchronously executes updates in a transaction, in the serialized
+    /// dispatch queue, and then the completion closure, outside of
+    /// any transaction.
+    ///
+    /// When `Configuration.groupCommitMaximumCount` is set, updates may share
+    /// their transaction with other updates.
+    func asyncWrite<T>(
+        _ updates: @escaping (Database) throws -> T,
+        completion: @escaping (Database, Result<T, Error>) -> Void)
+    {
+        guard let maximumCount = configuration.groupCommitMaximumCount else {
+            async { db in
+                do {
+                    var result: T?
+                    try db.inTransaction {
+                        result = try updates(db)
+                        return .commit
+                    }
+                    completion(db, .success(result!))
+                } catch {
+                    completion(db, .failure(error))
+                }
+            }
+            return
+        }
+        
+        GRDBPrecondition(maximumCount > 0, "Group commit maximum count must be at least 1")
+        let write = GroupedWrite(updates, completion: completion)
+        let count = $groupedWrites.update { writes -> Int in
+            writes.append(write)
+            return writes.count
+        }
+        if count >= maximumCount {
+            queue.async { self.commitGroupedWrites() }
+        } else if count == 1 {
+            let delay = configuration.groupCommitMaximumDelay
+            queue.asyncAfter(deadline: .now() + delay) { self.commitGroupedWrites() }
+        }
+    }
+    
+    /// Runs pending grouped writes in a single transaction.
+    ///
+    /// This method is scheduled in the serialized dispatch queue each time a
+    /// group of writes may have to be committed. It does nothing if the group
+    /// has already been committed.
+    private func commitGroupedWrites() {
+        let maximumCount = configuration.groupCommitMaximumCount ?? 1
+        let (writes, hasRemainingWrites) = $groupedWrites.update { pendingWrites -> ([GroupedWrite], Bool) in
+            let writes = Array(pendingWrites.prefix(maximumCount))
+            pendingWrites.removeFirst(writes.count)
+            return (writes, !pendingWrites.isEmpty)
+        }
+        if hasRemainingWrites {
+            queue.async { self.commitGroupedWrites() }
+        }
+        if writes.isEmpty {
+            return
+        }
+        
+        var transactionError: Error?
+        do {
+            try db.inTransaction {
+                for write in writes {
+                    write.perform(db)
+                    if !db.isInsideTransaction {
+                        // Transaction was rollbacked by SQLite: stop here, and
+                        // let inTransaction throw SQLITE_ABORT.
+                        break
+                    }
+                }
+                return .commit
+            }
+        } catch {
+            transactionError = error
+        }
+        
+        for write in writes {
+            write.complete(db, transactionError: transactionError)
+        }
+        preconditionNoUnsafeTransactionLeft(db)
+    }
+    
     /// Returns true if any only if the current dispatch queue is valid.
     var onValidQueue: Bool {
         SchedulingWatchdog.current?.allows(db) ?? false
@@ -257,3 +342,40 @@ final class SerializedDatabase {
             line: line)
     }
 }
+
+// MARK: - GroupedWrite
+
+/// A write that waits for a group commit.
+private final class GroupedWrite {
+    /// Runs the updates in a savepoint
+    let perform: (Database) -> Void
+    
+    /// Calls the completion closure, once the transaction has completed.
+    let complete: (Database, _ transactionError: Error?) -> Void
+    
+    init<T>(
+        _ updates: @escaping (Database) throws -> T,
+        completion: @escaping (Database, Result<T, Error>) -> Void)
+    {
+        var result: Result<T, Error>?
+        perform = { db in
+            do {
+                var value: T?
+                try db.inSavepoint {
+                    value = try updates(db)
+                    return .commit
+                }
+                result = .success(value!)
+            } catch {
+                result = .failure(error)
+            }
+        }
+        complete = { db, transactionError in
+            if let transactionError = transactionError {
+                completion(db, .failure(transactionError))
+            } else {
+                completion(db, result!)
+            }
+        }
+    }
+}
@@ -228,6 +228,18 @@ public class Statement {
         }
     }
     
+    /// Resets the statement and clears its bindings, so that new values can
+    /// be bound with `bind(_:at:)`, without any validation.
+    ///
+    /// The `arguments` property is emptied: use this method only when building
+    /// a StatementArguments would be a waste, as in batch insertions.
+    func resetBindings() {
+        _arguments = StatementArguments()
+        argumentsNeedValidation = false
+        try! reset()
+        clearBindings()
+    }
+    
     // 1-based index
     @inlinable
     func bind<T: StatementBinding>(_ value: T, at index: CInt) {
@@ -381,6 +393,33 @@ public final class SelectStatement: Statement {
         columnIndexes[name.lowercased()]
     }
     
+    /// Support for Decodable records: the column indexes of the keys
+    /// requested by the row decoder, in the order of requests.
+    ///
+    /// Decodable records request their keys in the same order for all rows.
+    /// Once the first row has been decoded, keys are resolved without any
+    /// case-insensitive column lookup.
+    private var decodingPlan: [(key: String, index: Int?)] = []
+    
+    /// Returns the index of the leftmost column named `key`, in a
+    /// case-insensitive way, given the position of the key request in the
+    /// decoding of a row.
+    func decodingColumnIndex(forKey key: String, position: Int) -> Int? {
+        if position < decodingPlan.count {
+            let entry = decodingPlan[position]
+            if entry.key == key {
+                return entry.index
+            }
+            // Another record type, or conditional decoding: ignore the plan.
+            return index(ofColumn: key)
+        }
+        let index = self.index(ofColumn: key)
+        if position == decodingPlan.count {
+            decodingPlan.append((key: key, index: index))
+        }
+        return index
+    }
+    
     /// Creates a cursor over the statement which does not produce any
     /// value. Each call to the next() cursor method calls the sqlite3_step()
     /// C function.
@@ -481,6 +520,9 @@ public final class UpdateStatement: Statement {
     private(set) var transactionEffect: TransactionEffect?
     private(set) var databaseEventKinds: [DatabaseEventKind] = []
     
+    /// The number of values last validated by `execute(bindings:)`
+    private var validatedBindingCount: Int?
+    
     var releasesDatabaseLock: Bool {
         guard let transactionEffect = transactionEffect else {
             return false
@@ -543,6 +585,72 @@ public final class UpdateStatement: Statement {
         // prevented or not. Database knows.
         try database.executeUpdateStatement(self)
     }
+    
+    /// Executes the SQL query with the given values, bound to the statement
+    /// arguments from left to right.
+    ///
+    /// Unlike `execute(arguments:)`, this method does not build any
+    /// StatementArguments: values are directly bound to the SQLite statement.
+    /// Use it in tight loops that repeatedly execute the same statement:
+    ///
+    ///     let statement = try db.makeUpdateStatement(sql: """
+    ///         INSERT INTO player (name, score) VALUES (?, ?)
+    ///         """)
+    ///     for player in players {
+    ///         try statement.execute(bindings: player.name, player.score)
+    ///     }
+    ///
+    /// Nil values are bound to NULL. Named arguments such as `:name` are bound
+    /// by position.
+    ///
+    /// The number of values is only checked the first time the statement is
+    /// executed with this method. After this method has been called, the
+    /// `arguments` property is empty.
+    ///
+    /// - parameter bindings: Statement values.
+    /// - precondition: The number of values matches the number of
+    ///   statement arguments.
+    /// - throws: A DatabaseError whenever an SQLite error occurs.
+    public func execute(bindings: StatementBinding?...) throws {
+        try execute(bindings: bindings)
+    }
+    
+    /// Executes the SQL query with the given values, bound to the statement
+    /// arguments from left to right.
+    ///
+    /// See `execute(bindings:)`.
+    ///
+    /// - parameter bindings: An array of statement values.
+    /// - precondition: The number of values matches the number of
+    ///   statement arguments.
+    /// - throws: A DatabaseError whenever an SQLite error occurs.
+    public func execute(bindings: [StatementBinding?]) throws {
+        SchedulingWatchdog.preconditionValidQueue(database)
+        
+        if bindings.count != validatedBindingCount {
+            // Force arguments validity: it is a programmer error to provide
+            // arguments that do not match the statement.
+            guard bindings.count == sqliteArgumentCount else {
+                fatalError(DatabaseError(
+                    resultCode: .SQLITE_MISUSE,
+                    message: "wrong number of statement arguments: \(bindings.count)",
+                    sql: sql))
+            }
+            validatedBindingCount = bindings.count
+        }
+        
+        resetBindings()
+        for (index, binding) in zip(CInt(1)..., bindings) {
+            // Cleared bindings are NULL
+            guard let binding = binding else { continue }
+            let code = binding.bind(to: sqliteStatement, at: index)
+            guard code == SQLITE_OK else {
+                fatalError(DatabaseError(resultCode: code, message: database.lastErrorMessage, sql: sql))
+            }
+        }
+        
+        try database.executeUpdateStatement(self)
+    }
 }
 
 // MARK: - StatementBinding
@@ -49,6 +49,16 @@ extension Date: DatabaseValueConvertible {
     /// year, month and day components. Other components (minutes, etc.)
     /// are set to zero if missing.
     public static func fromDatabaseValue(_ dbValue: DatabaseValue) -> Date? {
+        if case let .string(string) = dbValue.storage,
+           string.utf8.count == 23,
+           let date = string.withCString({ cString in
+            Date(
+                storageFormatCString: UnsafeRawPointer(cString).assumingMemoryBound(to: UInt8.self),
+                length: 23)
+           })
+        {
+            return date
+        }
         if let databaseDateComponents = DatabaseDateComponents.fromDatabaseValue(dbValue) {
             return Date(databaseDateComponents: databaseDateComponents)
         }
@@ -124,6 +134,14 @@ extension Date: StatementColumnConvertible {
         case SQLITE_INTEGER, SQLITE_FLOAT:
             self.init(timeIntervalSince1970: sqlite3_column_double(sqliteStatement, index))
         case SQLITE_TEXT:
+            if let cString = sqlite3_column_text(sqliteStatement, index),
+               let date = Date(
+                storageFormatCString: cString,
+                length: Int(sqlite3_column_bytes(sqliteStatement, index)))
+            {
+                self = date
+                return
+            }
             guard let components = DatabaseDateComponents(sqliteStatement: sqliteStatement, index: index),
                   let date = Date(databaseDateComponents: components)
             else {
@@ -136,6 +154,123 @@ extension Date: StatementColumnConvertible {
     }
 }
 
+// MARK: - Storage Format Parsing
+
+extension Date {
+    /// Creates a date from a string in the "yyyy-MM-dd HH:mm:ss.SSS" format
+    /// used for stored dates (the "T" separator is also accepted), in the
+    /// UTC time zone.
+    ///
+    /// This initializer does not use any Calendar: it validates the string
+    /// eight bytes at a time, and computes the timestamp directly. It
+    /// returns nil for other formats, and for components that require
+    /// calendar computations (invalid dates, leap seconds, dates before
+    /// the Gregorian calendar), so that the caller can fall back to
+    /// DatabaseDateComponents.
+    ///
+    /// - precondition: `cString` is followed by a trailing zero.
+    @usableFromInline
+    init?(storageFormatCString cString: UnsafePointer<UInt8>, length: Int) {
+        // "yyyy-MM-dd HH:mm:ss.SSS"
+        guard length == 23 else { return nil }
+        
+        // Load the 23 bytes and the trailing zero in three words
+        var w0: UInt64 = 0
+        var w1: UInt64 = 0
+        var w2: UInt64 = 0
+        memcpy(&w0, cString, 8)
+        memcpy(&w1, cString + 8, 8)
+        memcpy(&w2, cString + 16, 8)
+        w0 = UInt64(littleEndian: w0) // "yyyy-MM-"
+        w1 = UInt64(littleEndian: w1) // "dd HH:mm"
+        w2 = UInt64(littleEndian: w2) // ":ss.SSS\0"
+        
+        // Separators
+        let separator = (w1 >> 16) & 0xFF
+        guard w0 & 0xFF0000FF00000000 == 0x2D00002D00000000,      // "-" "-"
+              w1 & 0x0000FF0000000000 == 0x00003A0000000000,      // ":"
+              w2 & 0xFF000000FF0000FF == 0x000000002E00003A,      // ":" "." "\0"
+              separator == 0x20 || separator == 0x54              // " " or "T"
+        else { return nil }
+        
+        // Digits
+        let mask0: UInt64 = 0x00FFFF00FFFFFFFF
+        let mask1: UInt64 = 0xFFFF00FFFF00FFFF
+        let mask2: UInt64 = 0x00FFFFFF00FFFF00
+        guard hasDigits(w0, mask: mask0),
+              hasDigits(w1, mask: mask1),
+              hasDigits(w2, mask: mask2)
+        else { return nil }
+        let d0 = (w0 & mask0) &- (0x3030303030303030 & mask0)
+        let d1 = (w1 & mask1) &- (0x3030303030303030 & mask1)
+        let d2 = (w2 & mask2) &- (0x3030303030303030 & mask2)
+        
+        let year = byte(d0, 0) * 1000 + byte(d0, 1) * 100 + byte(d0, 2) * 10 + byte(d0, 3)
+        let month = byte(d0, 5) * 10 + byte(d0, 6)
+        let day = byte(d1, 0) * 10 + byte(d1, 1)
+        let hour = byte(d1, 3) * 10 + byte(d1, 4)
+        let minute = byte(d1, 6) * 10 + byte(d1, 7)
+        let second = byte(d2, 1) * 10 + byte(d2, 2)
+        let millisecond = byte(d2, 4) * 100 + byte(d2, 5) * 10 + byte(d2, 6)
+        
+        // Foundation uses the Julian calendar before 1582-10-15.
+        guard year > 1582,
+              month >= 1 && month <= 12,
+              day >= 1 && day <= daysInMonth(month, year: year),
+              hour <= 23,
+              minute <= 59,
+              second <= 59
+        else { return nil }
+        
+        let seconds = daysSince1970(year: year, month: month, day: day) * 86400
+            + hour * 3600
+            + minute * 60
+            + second
+        self.init(timeIntervalSince1970: TimeInterval(seconds) + TimeInterval(millisecond) / 1000)
+    }
+}
+
+/// Returns whether the masked bytes of word are ASCII digits.
+@inline(__always)
+private func hasDigits(_ word: UInt64, mask: UInt64) -> Bool {
+    // High nibble must be 3, and low nibble must be 9 or less: adding 6
+    // must not carry into the high nibble.
+    let highNibbles: UInt64 = 0xF0F0F0F0F0F0F0F0 & mask
+    let expected: UInt64 = 0x3030303030303030 & mask
+    return word & highNibbles == expected
+        && (word &+ 0x0606060606060606) & highNibbles == expected
+}
+
+@inline(__always)
+private func byte(_ word: UInt64, _ index: Int) -> Int {
+    Int(truncatingIfNeeded: (word >> UInt64(8 * index)) & 0xFF)
+}
+
+private func daysInMonth(_ month: Int, year: Int) -> Int {
+    switch month {
+    case 2:
+        let isLeapYear = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0
+        return isLeapYear ? 29 : 28
+    case 4, 6, 9, 11:
+        return 30
+    default:
+        return 31
+    }
+}
+
+/// Returns the number of days since 1970-01-01 in the proleptic
+/// Gregorian calendar.
+///
+/// See http://howardhinnant.github.io/date_algorithms.html#days_from_civil
+private func daysSince1970(year: Int, month: Int, day: Int) -> Int {
+    let y = month <= 2 ? year - 1 : year
+    let era = (y >= 0 ? y : y - 399) / 400
+    let yoe = y - era * 400                                             // [0, 399]
+    let doy = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1  // [0, 365]
+    let doe = yoe * 365 + yoe / 4 - yoe / 100 + doy                     // [0, 146096]
+    return era * 146097 + doe - 719468
+}
+
 /// The DatabaseDate date formatter for stored dates.
 private let storageDateFormatter: DateFormatter = {
     let formatter = DateFormatter()
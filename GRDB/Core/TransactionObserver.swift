@@ -160,10 +160,37 @@ class DatabaseObservationBroker {
     private unowned var database: Database
     private var savepointStack = SavepointStack()
     private var transactionState: TransactionState = .none
-    private var transactionObservations: [TransactionObservation] = []
+    private var transactionObservations: [TransactionObservation] = [] {
+        didSet { _observationIndex = nil }
+    }
+    
+    /// The index of transaction observations by observed table. It is built
+    /// on demand, and invalidated when observations or observed
+    /// regions change.
+    private var _observationIndex: TransactionObservationIndex?
+    private var observationIndex: TransactionObservationIndex {
+        if let index = _observationIndex {
+            return index
+        }
+        let index = TransactionObservationIndex(transactionObservations)
+        _observationIndex = index
+        return index
+    }
+    
     private var statementObservations: [StatementObservation] = [] {
-        didSet { observesDatabaseChanges = !statementObservations.isEmpty }
+        didSet { updateObservesDatabaseChanges() }
     }
+    
+    /// The statement observations of change set observers, notified of
+    /// individual changes through their change buffer.
+    private var statementChangeSetObservations: [StatementObservation] = [] {
+        didSet { updateObservesDatabaseChanges() }
+    }
+    
+    /// The tables modified by the current transaction, for change
+    /// set observers.
+    private var changeTables = DatabaseChangeTables()
+    
     private var observesDatabaseChanges: Bool = false {
         didSet {
             if observesDatabaseChanges == oldValue { return }
@@ -179,6 +206,10 @@ class DatabaseObservationBroker {
         self.database = database
     }
     
+    private func updateObservesDatabaseChanges() {
+        observesDatabaseChanges = !statementObservations.isEmpty || !statementChangeSetObservations.isEmpty
+    }
+    
     // MARK: - Transaction observers
     
     func add(transactionObserver: TransactionObserver, extent: Database.TransactionObservationExtent) {
@@ -189,10 +220,17 @@ class DatabaseObservationBroker {
         transactionObservations.removeFirst { $0.isWrapping(transactionObserver) }
     }
     
+    /// Must be called when the observed region of a
+    /// `DatabaseRegionTransactionObserver` has changed.
+    func observedRegionDidChange() {
+        _observationIndex = nil
+    }
+    
     func disableUntilNextTransaction(transactionObserver: TransactionObserver) {
         if let observation = transactionObservations.first(where: { $0.isWrapping(transactionObserver) }) {
             observation.isDisabled = true
             statementObservations.removeFirst { $0.0 === observation }
+            statementChangeSetObservations.removeFirst { $0.0 === observation }
         }
     }
     
@@ -224,12 +262,16 @@ class DatabaseObservationBroker {
             // in databaseWillChange() and databaseDidChange().
             let eventKinds = statement.databaseEventKinds
             
+            // Only consider observations that may be interested in the
+            // tables modified by the statement.
+            let observations = eventKinds.isEmpty ? [] : observationIndex.observations(for: eventKinds)
+            
             switch eventKinds.count {
             case 0:
                 // Statement has no effect on any database table.
                 //
                 // For example: PRAGMA foreign_keys = ON
-                statementObservations = []
+                setStatementObservations([])
             case 1:
                 // We'll execute a simple statement without any side effect.
                 // Eventual database events will thus all have the same kind. All
@@ -238,7 +280,7 @@ class DatabaseObservationBroker {
                 // For example, if one observes all deletions in the table T, then
                 // all individual deletions of DELETE FROM T are notified:
                 let eventKind = eventKinds[0]
-                statementObservations = transactionObservations.compactMap { observation in
+                setStatementObservations(observations.compactMap { observation in
                     guard observation.observes(eventsOfKind: eventKind) else {
                         // observation is not interested
                         return nil
@@ -250,7 +292,7 @@ class DatabaseObservationBroker {
                     
                     // observation will be notified of all individual events
                     return (observation, DatabaseEventPredicate.true)
-                }
+                })
             default:
                 // We'll execute a complex statement with side effects performed by
                 // an SQL trigger or a foreign key action. Eventual database events
@@ -260,7 +302,7 @@ class DatabaseObservationBroker {
                 // For example, if DELETE FROM T1 generates deletions in T1 and T2
                 // by the mean of a foreign key action, then when one only observes
                 // deletions in T1, one must not be notified of deletions in T2:
-                statementObservations = transactionObservations.compactMap { observation in
+                setStatementObservations(observations.compactMap { observation in
                     let observedKinds = eventKinds.filter(observation.observes)
                     if observedKinds.isEmpty {
                         // observation is not interested
@@ -281,7 +323,7 @@ class DatabaseObservationBroker {
                         DatabaseEventPredicate.matching(
                             observedKinds: observedKinds,
                             advertisedKinds: eventKinds))
-                }
+                })
             }
         }
         
@@ -303,9 +345,22 @@ class DatabaseObservationBroker {
         }
     }
     
+    /// Splits statement observations between regular observers, and
+    /// change set observers.
+    private func setStatementObservations(_ observations: [StatementObservation]) {
+        if observations.contains(where: { $0.0.observesChangeSets }) {
+            statementObservations = observations.filter { !$0.0.observesChangeSets }
+            statementChangeSetObservations = observations.filter { $0.0.observesChangeSets }
+        } else {
+            statementObservations = observations
+            statementChangeSetObservations = []
+        }
+    }
+    
     func updateStatementDidFail(_ statement: UpdateStatement) throws {
         // Undo updateStatementWillExecute
         statementObservations = []
+        statementChangeSetObservations = []
         SchedulingWatchdog.current!.databaseObservationBroker = nil
         
         // Reset transactionState before databaseDidRollback eventually
@@ -331,6 +386,7 @@ class DatabaseObservationBroker {
         // Undo updateStatementWillExecute
         if transactionObservations.isEmpty == false {
             statementObservations = []
+            statementChangeSetObservations = []
             SchedulingWatchdog.current!.databaseObservationBroker = nil
         }
         
@@ -355,7 +411,7 @@ class DatabaseObservationBroker {
                 break
                 
             case .beginSavepoint(let name):
-                savepointStack.savepointDidBegin(name)
+                savepointStack.savepointDidBegin(name, changeCounts: changeCounts())
                 
             case .releaseSavepoint(let name):          // 1. A RELEASE SAVEPOINT statement has been executed
                 savepointStack.savepointDidRelease(name)
@@ -377,7 +433,12 @@ class DatabaseObservationBroker {
                 }
                 
             case .rollbackSavepoint(let name):
-                savepointStack.savepointDidRollback(name)
+                if let changeCounts = savepointStack.savepointDidRollback(name) {
+                    // Forget changes that were rollbacked
+                    for observation in transactionObservations where observation.observesChangeSets {
+                        observation.removeChanges(after: changeCounts[ObjectIdentifier(observation)] ?? 0)
+                    }
+                }
             }
         }
         
@@ -412,6 +473,37 @@ class DatabaseObservationBroker {
     #endif
     
     // Called from sqlite3_update_hook
+    private func databaseDidChange(
+        kind: DatabaseEvent.Kind,
+        rowID: Int64,
+        databaseNameCString: UnsafePointer<Int8>?,
+        tableNameCString: UnsafePointer<Int8>?)
+    {
+        let event = DatabaseEvent(
+            kind: kind,
+            rowID: rowID,
+            databaseNameCString: databaseNameCString,
+            tableNameCString: tableNameCString)
+        
+        if !statementChangeSetObservations.isEmpty {
+            // Change set observers do not need any copy of the event
+            let tableIndex = changeTables.index(
+                databaseNameCString: databaseNameCString!,
+                tableNameCString: tableNameCString!)
+            for (observation, predicate) in statementChangeSetObservations {
+                // Avoid boxing the event when the predicate is trivial
+                if case .matching = predicate, !predicate.evaluate(event) {
+                    continue
+                }
+                observation.databaseDidChange(tableIndex: tableIndex, rowID: rowID, kind: kind)
+            }
+        }
+        
+        if !statementObservations.isEmpty {
+            databaseDidChange(with: event)
+        }
+    }
+    
     private func databaseDidChange(with event: DatabaseEvent) {
         // We're about to call the databaseDidChange(with:) method of
         // transaction observers. In this method, observers may disable
@@ -438,9 +530,11 @@ class DatabaseObservationBroker {
     // Called from sqlite3_commit_hook and databaseDidCommitEmptyDeferredTransaction()
     private func databaseWillCommit() throws {
         notifyBufferedEvents()
+        let changeTables = self.changeTables.tables
         for observation in transactionObservations {
-            try observation.databaseWillCommit()
+            try observation.databaseWillCommit(changeTables: changeTables)
         }
+        removeAllChanges()
     }
     
     // Called from updateStatementDidExecute
@@ -499,6 +593,7 @@ class DatabaseObservationBroker {
     // Called from updateStatementDidExecute or updateStatementDidFails
     private func databaseDidRollback(notifyTransactionObservers: Bool) {
         savepointStack.clear()
+        removeAllChanges()
         
         if notifyTransactionObservers {
             for observation in transactionObservations {
@@ -512,7 +607,9 @@ class DatabaseObservationBroker {
     /// and uninstall SQLite update hooks if there is no remaining observers.
     private func databaseDidEndTransaction() {
         assert(!database.isInsideTransaction)
-        transactionObservations = transactionObservations.filter(\.isObserving)
+        if transactionObservations.contains(where: { !$0.isObserving }) {
+            transactionObservations = transactionObservations.filter(\.isObserving)
+        }
         
         // Undo disableUntilNextTransaction(transactionObserver:)
         for observation in transactionObservations {
@@ -520,6 +617,23 @@ class DatabaseObservationBroker {
         }
     }
     
+    /// Returns the number of changes of change set observations, so that
+    /// rollbacked changes can be removed.
+    private func changeCounts() -> [ObjectIdentifier: Int] {
+        var changeCounts: [ObjectIdentifier: Int] = [:]
+        for observation in transactionObservations where observation.observesChangeSets {
+            changeCounts[ObjectIdentifier(observation)] = observation.changeCount
+        }
+        return changeCounts
+    }
+    
+    private func removeAllChanges() {
+        changeTables.removeAll()
+        for observation in transactionObservations where observation.observesChangeSets {
+            observation.removeAllChanges()
+        }
+    }
+    
     private func notifyBufferedEvents() {
         // We're about to call the databaseDidChange(with:) method of
         // transaction observers. In this method, observers may disable
@@ -620,11 +734,10 @@ class DatabaseObservationBroker {
             { (brokerPointer, updateKind, databaseNameCString, tableNameCString, rowID) in
                 let broker = Unmanaged<DatabaseObservationBroker>.fromOpaque(brokerPointer!).takeUnretainedValue()
                 broker.databaseDidChange(
-                    with: DatabaseEvent(
-                        kind: DatabaseEvent.Kind(rawValue: updateKind)!,
-                        rowID: rowID,
-                        databaseNameCString: databaseNameCString,
-                        tableNameCString: tableNameCString))
+                    kind: DatabaseEvent.Kind(rawValue: updateKind)!,
+                    rowID: rowID,
+                    databaseNameCString: databaseNameCString,
+                    tableNameCString: tableNameCString)
             },
             brokerPointer)
         
@@ -806,10 +919,25 @@ final class TransactionObservation {
     private var strongObserver: TransactionObserver?
     private var observer: TransactionObserver? { strongObserver ?? weakObserver }
     
+    /// The changes of the current transaction, if the observer is a
+    /// TransactionChangeSetObserver.
+    private var changeBuffer: DatabaseChangeBuffer?
+    
+    /// If true, the observer is a TransactionChangeSetObserver.
+    var observesChangeSets: Bool { changeBuffer != nil }
+    
+    var changeCount: Int { changeBuffer?.count ?? 0 }
+    
     fileprivate var isObserving: Bool {
         observer != nil
     }
     
+    /// The region observed by a `DatabaseRegionTransactionObserver`, or nil
+    /// if the observed events are not described by a region.
+    fileprivate var observedRegion: DatabaseRegion? {
+        (observer as? DatabaseRegionTransactionObserver)?.observedRegion
+    }
+    
     init(observer: TransactionObserver, extent: Database.TransactionObservationExtent) {
         self.extent = extent
         switch extent {
@@ -821,6 +949,9 @@ final class TransactionObservation {
         case .databaseLifetime:
             strongObserver = observer
         }
+        if observer is TransactionChangeSetObserver {
+            changeBuffer = DatabaseChangeBuffer()
+        }
     }
     
     func isWrapping(_ observer: TransactionObserver) -> Bool {
@@ -844,8 +975,27 @@ final class TransactionObservation {
         observer?.databaseDidChange(with: event)
     }
     
-    func databaseWillCommit() throws {
-        try observer?.databaseWillCommit()
+    func databaseDidChange(tableIndex: Int32, rowID: Int64, kind: DatabaseEvent.Kind) {
+        if isDisabled { return }
+        changeBuffer?.append(tableIndex: tableIndex, rowID: rowID, kind: kind)
+    }
+    
+    func removeChanges(after count: Int) {
+        changeBuffer?.removeChanges(after: count)
+    }
+    
+    func removeAllChanges() {
+        changeBuffer?.removeAll()
+    }
+    
+    func databaseWillCommit(changeTables: [DatabaseChangeSet.Table]) throws {
+        if let changeBuffer = changeBuffer,
+           let observer = observer as? TransactionChangeSetObserver
+        {
+            try observer.databaseWillCommit(with: changeBuffer.changeSet(tables: changeTables))
+        } else {
+            try observer?.databaseWillCommit()
+        }
     }
     
     func databaseDidCommit(_ db: Database) {
@@ -881,6 +1031,88 @@ final class TransactionObservation {
 
 typealias StatementObservation = (TransactionObservation, DatabaseEventPredicate)
 
+// MARK: - DatabaseRegionTransactionObserver
+
+/// A transaction observer that only observes the events that modify
+/// a database region.
+///
+/// The `observes(eventsOfKind:)` method of such an observer must return false
+/// for all events on tables that are not in the observed region. This allows
+/// the broker to skip the observer when a statement does not modify any of
+/// its tables.
+///
+/// When the observed region changes, the observer must call
+/// `observedRegionDidChange()` on the broker of the observed database.
+protocol DatabaseRegionTransactionObserver: TransactionObserver {
+    /// The observed region, or nil if the observer may observe any event.
+    var observedRegion: DatabaseRegion? { get }
+}
+
+// MARK: - TransactionObservationIndex
+
+/// An index of transaction observations by the tables they observe.
+///
+/// With many observations, the index avoids asking all of them if they
+/// observe the events of each executed statement.
+///
+/// Observations that do not describe their observed events with a region, and
+/// observations of the full database, are always considered.
+struct TransactionObservationIndex {
+    private struct Entry {
+        /// The position of the observation, so that observations are
+        /// considered in their registration order.
+        var ordinal: Int
+        var observation: TransactionObservation
+    }
+    
+    private var entriesByTable: [CaseInsensitiveIdentifier: [Entry]] = [:]
+    private var unindexedEntries: [Entry] = []
+    
+    init(_ observations: [TransactionObservation]) {
+        for (ordinal, observation) in observations.enumerated() {
+            let entry = Entry(ordinal: ordinal, observation: observation)
+            if let tableNames = observation.observedRegion?.tableNames {
+                for tableName in tableNames {
+                    entriesByTable[tableName, default: []].append(entry)
+                }
+            } else {
+                unindexedEntries.append(entry)
+            }
+        }
+    }
+    
+    /// Returns the observations that may observe the given event kinds, in
+    /// their registration order.
+    func observations(for eventKinds: [DatabaseEventKind]) -> [TransactionObservation] {
+        var entries = unindexedEntries
+        var needsSorting = false
+        for eventKind in eventKinds {
+            let tableName = CaseInsensitiveIdentifier(rawValue: eventKind.tableName)
+            guard let tableEntries = entriesByTable[tableName] else {
+                continue
+            }
+            needsSorting = needsSorting || !entries.isEmpty
+            entries.append(contentsOf: tableEntries)
+        }
+        
+        guard needsSorting else {
+            return entries.map { $0.observation }
+        }
+        
+        // Restore registration order, and remove duplicates (observations
+        // of several modified tables).
+        entries.sort { $0.ordinal < $1.ordinal }
+        var observations: [TransactionObservation] = []
+        observations.reserveCapacity(entries.count)
+        var lastOrdinal = -1
+        for entry in entries where entry.ordinal != lastOrdinal {
+            observations.append(entry.observation)
+            lastOrdinal = entry.ordinal
+        }
+        return observations
+    }
+}
+
 // MARK: - Database events
 
 /// A kind of database event. See the `TransactionObserver` protocol for
@@ -1362,9 +1594,10 @@ class SavepointStack {
     /// The buffered events (see DatabaseObservationBroker.databaseDidChange(with:))
     var eventsBuffer: [(event: DatabaseEventProtocol, statementObservations: [StatementObservation])] = []
     
-    /// The savepoint stack, as an array of tuples (savepointName, index in the eventsBuffer array).
-    /// Indexes let us drop rollbacked events from the event buffer.
-    private var savepoints: [(name: String, index: Int)] = []
+    /// The savepoint stack, as an array of tuples (savepointName, index in
+    /// the eventsBuffer array, number of changes of change set observations).
+    /// Indexes and counts let us drop rollbacked events and changes.
+    private var savepoints: [(name: String, index: Int, changeCounts: [ObjectIdentifier: Int])] = []
     
     /// If true, there is no current save point.
     var isEmpty: Bool { savepoints.isEmpty }
@@ -1374,8 +1607,8 @@ class SavepointStack {
         savepoints.removeAll()
     }
     
-    func savepointDidBegin(_ name: String) {
-        savepoints.append((name: name.lowercased(), index: eventsBuffer.count))
+    func savepointDidBegin(_ name: String, changeCounts: [ObjectIdentifier: Int] = [:]) {
+        savepoints.append((name: name.lowercased(), index: eventsBuffer.count, changeCounts: changeCounts))
     }
     
     // https://www.sqlite.org/lang_savepoint.html
@@ -1387,15 +1620,21 @@ class SavepointStack {
     // > command does not match any SAVEPOINT on the stack, then the ROLLBACK
     // > command fails with an error and leaves the state of the
     // > database unchanged.
-    func savepointDidRollback(_ name: String) {
+    //
+    // Returns the number of changes of change set observations when the
+    // savepoint began.
+    @discardableResult
+    func savepointDidRollback(_ name: String) -> [ObjectIdentifier: Int]? {
         let name = name.lowercased()
         while let pair = savepoints.last, pair.name != name {
             savepoints.removeLast()
         }
-        if let savepoint = savepoints.last {
-            eventsBuffer.removeLast(eventsBuffer.count - savepoint.index)
-        }
         assert(!savepoints.isEmpty || eventsBuffer.isEmpty)
+        guard let savepoint = savepoints.last else {
+            return nil
+        }
+        eventsBuffer.removeLast(eventsBuffer.count - savepoint.index)
+        return savepoint.changeCounts
     }
     
     // https://www.sqlite.org/lang_savepoint.html
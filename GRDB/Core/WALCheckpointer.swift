@@ -0,0 +1,301 @@
+import Foundation
+
+extension DatabasePool {
+    /// A CheckpointPolicy controls the automatic WAL checkpoints of a
+    /// database pool.
+    ///
+    /// By default, SQLite runs a checkpoint on the writer connection when the
+    /// WAL reaches 1000 pages: the write that triggers this automatic
+    /// checkpoint has to wait for it. With a CheckpointPolicy, checkpoints
+    /// run on a dedicated connection instead, and writes are not delayed:
+    ///
+    ///     var config = Configuration()
+    ///     config.checkpointPolicy = DatabasePool.CheckpointPolicy(
+    ///         walPageThreshold: 1000,
+    ///         interval: 60)
+    ///     let dbPool = try DatabasePool(path: "...", configuration: config)
+    ///
+    /// See https://www.sqlite.org/wal.html#ckpt for more information.
+    public struct CheckpointPolicy {
+        /// A passive checkpoint is run after a transaction is committed and
+        /// the WAL contains at least this number of pages.
+        ///
+        /// When nil, commits do not trigger any checkpoint.
+        public var walPageThreshold: Int?
+        
+        /// A passive checkpoint is run at this time interval, if the WAL
+        /// contains pages that were not checkpointed yet.
+        ///
+        /// When nil, no checkpoint is run periodically.
+        public var interval: TimeInterval?
+        
+        /// After a passive checkpoint, the `escalationMode` checkpoint is run
+        /// if the WAL contains at least this number of pages, and no
+        /// read-only connection of the pool is used.
+        ///
+        /// Passive checkpoints do not prevent the WAL from growing when it is
+        /// constantly read. An escalated checkpoint resets the WAL, so that
+        /// its size remains bounded.
+        ///
+        /// When nil, no checkpoint is escalated.
+        public var escalationThreshold: Int?
+        
+        /// The mode of escalated checkpoints: `.restart`, or `.truncate`.
+        public var escalationMode: Database.CheckpointMode
+        
+        /// Creates a checkpoint policy.
+        ///
+        /// - parameters:
+        ///     - walPageThreshold: The WAL size that triggers a
+        ///       passive checkpoint.
+        ///     - interval: The interval between periodic passive checkpoints.
+        ///     - escalationThreshold: The WAL size that triggers an
+        ///       escalated checkpoint.
+        ///     - escalationMode: The mode of escalated checkpoints.
+        public init(
+            walPageThreshold: Int? = 1000,
+            interval: TimeInterval? = nil,
+            escalationThreshold: Int? = 10_000,
+            escalationMode: Database.CheckpointMode = .truncate)
+        {
+            GRDBPrecondition(
+                escalationMode == .restart || escalationMode == .truncate,
+                "Escalated checkpoints must be restart or truncate checkpoints")
+            self.walPageThreshold = walPageThreshold
+            self.interval = interval
+            self.escalationThreshold = escalationThreshold
+            self.escalationMode = escalationMode
+        }
+    }
+    
+    /// Statistics about the automatic checkpoints of a database pool.
+    ///
+    /// See `DatabasePool.checkpointStatistics`.
+    public struct CheckpointStatistics {
+        /// The number of pages in the WAL, as of the last commit
+        /// or checkpoint.
+        public var walPageCount = 0
+        
+        /// The number of automatic checkpoints.
+        public var checkpointCount = 0
+        
+        /// The number of escalated checkpoints that were successfully run.
+        public var escalatedCheckpointCount = 0
+        
+        /// The number of escalated checkpoints that could not complete
+        /// because the database was busy.
+        public var busyCheckpointCount = 0
+        
+        /// The total time spent in automatic checkpoints.
+        public var totalCheckpointDuration: TimeInterval = 0
+        
+        /// The duration of the longest automatic checkpoint.
+        public var maximumCheckpointDuration: TimeInterval = 0
+    }
+}
+
+/// WALCheckpointer runs the automatic checkpoints of a database pool, on a
+/// dedicated database connection, according to a checkpoint policy.
+final class WALCheckpointer {
+    private struct State {
+        var statistics = DatabasePool.CheckpointStatistics()
+        var isCheckpointScheduled = false
+        
+        /// The number of WAL pages that were copied back into the database
+        /// by the last checkpoint.
+        var checkpointedPageCount = 0
+        
+        /// True during the suspension of the database pool
+        var isSuspended = false
+        
+        /// True if the WAL contains pages that were not checkpointed yet
+        var needsCheckpoint: Bool {
+            statistics.walPageCount > checkpointedPageCount
+        }
+    }
+    
+    private let path: String
+    private let configuration: Configuration
+    private let policy: DatabasePool.CheckpointPolicy
+    
+    /// Returns whether no read-only connection is used
+    private let readersAreIdle: () -> Bool
+    
+    /// The queue of all checkpoints
+    private let queue: DispatchQueue
+    
+    /// The checkpointing connection. Only accessed from `queue`.
+    private var connection: SerializedDatabase?
+    
+    @LockedBox private var state = State()
+    
+    var statistics: DatabasePool.CheckpointStatistics {
+        state.statistics
+    }
+    
+    /// Creates a checkpointer.
+    ///
+    /// - parameters:
+    ///     - path: The path to the database file.
+    ///     - configuration: The configuration of the database pool.
+    ///     - policy: The checkpoint policy.
+    ///     - readersAreIdle: A function that returns whether no read-only
+    ///       connection is used.
+    init(
+        path: String,
+        configuration: Configuration,
+        policy: DatabasePool.CheckpointPolicy,
+        readersAreIdle: @escaping () -> Bool)
+    {
+        var configuration = configuration
+        configuration.checkpointPolicy = nil
+        configuration.groupCommitMaximumCount = nil
+        // Escalated checkpoints do not wait for the writer: they fail with
+        // SQLITE_BUSY, and are retried after next passive checkpoint.
+        configuration.busyMode = .immediateError
+        
+        self.path = path
+        self.configuration = configuration
+        self.policy = policy
+        self.readersAreIdle = readersAreIdle
+        self.queue = DispatchQueue(
+            label: configuration.identifier(defaultLabel: "GRDB.DatabasePool", purpose: "checkpointer.queue"),
+            qos: .utility)
+        
+        if let interval = policy.interval {
+            scheduleCheckpoint(after: interval)
+        }
+    }
+    
+    /// Called after each transaction commit, with the number of pages in
+    /// the WAL.
+    func walDidCommit(pageCount: Int) {
+        let needsCheckpoint = $state.update { state -> Bool in
+            if pageCount <= state.checkpointedPageCount {
+                // Commits add pages to the WAL: this one has restarted it.
+                state.checkpointedPageCount = 0
+            }
+            state.statistics.walPageCount = pageCount
+            guard let threshold = policy.walPageThreshold,
+                  pageCount >= threshold,
+                  !state.isCheckpointScheduled
+            else {
+                return false
+            }
+            state.isCheckpointScheduled = true
+            return true
+        }
+        if needsCheckpoint {
+            queue.async { self.checkpoint() }
+        }
+    }
+    
+    /// Schedules a periodic checkpoint. The checkpointer is not retained.
+    private func scheduleCheckpoint(after interval: TimeInterval) {
+        queue.asyncAfter(deadline: .now() + interval) { [weak self] in
+            guard let self = self else { return }
+            if self.state.needsCheckpoint {
+                self.checkpoint()
+            }
+            self.scheduleCheckpoint(after: interval)
+        }
+    }
+    
+    /// Prevents checkpoints from starting, until `resume()` is called.
+    ///
+    /// This method can be called from any thread.
+    ///
+    /// See `DatabasePool.suspend()`.
+    func suspend() {
+        $state.update { $0.isSuspended = true }
+    }
+    
+    /// Resumes checkpoints.
+    ///
+    /// This method can be called from any thread.
+    func resume() {
+        $state.update { $0.isSuspended = false }
+    }
+    
+    /// Runs a passive checkpoint, eventually followed by an
+    /// escalated checkpoint.
+    ///
+    /// Must be called from `queue`.
+    private func checkpoint() {
+        // Commits that happen from now on can schedule another checkpoint
+        let isSuspended = $state.update { state -> Bool in
+            state.isCheckpointScheduled = false
+            return state.isSuspended
+        }
+        if isSuspended {
+            // Checkpoints acquire locks: wait for next commit or next
+            // periodic checkpoint.
+            return
+        }
+        
+        let start = DispatchTime.now()
+        var walPageCount: Int?
+        var checkpointedPageCount: Int?
+        var isEscalated = false
+        var isBusy = false
+        do {
+            let connection = try makeConnectionIfNeeded()
+            try connection.sync { db in
+                let result = try db.checkpoint(.passive)
+                walPageCount = result.walFrameCount
+                checkpointedPageCount = result.checkpointedFrameCount
+                
+                if let threshold = policy.escalationThreshold,
+                   result.walFrameCount >= threshold,
+                   !state.isSuspended,
+                   readersAreIdle()
+                {
+                    do {
+                        try db.checkpoint(policy.escalationMode)
+                        isEscalated = true
+                        walPageCount = 0
+                        checkpointedPageCount = 0
+                    } catch DatabaseError.SQLITE_BUSY, DatabaseError.SQLITE_LOCKED {
+                        isBusy = true
+                    }
+                }
+            }
+        } catch {
+            // Failed checkpoints are not fatal: the WAL keeps on growing
+            // until next checkpoint.
+        }
+        let duration = TimeInterval(DispatchTime.now().uptimeNanoseconds - start.uptimeNanoseconds) / 1.0e9
+        
+        $state.update { state in
+            if let walPageCount = walPageCount {
+                state.statistics.walPageCount = walPageCount
+            }
+            if let checkpointedPageCount = checkpointedPageCount {
+                state.checkpointedPageCount = checkpointedPageCount
+            }
+            state.statistics.checkpointCount += 1
+            if isEscalated {
+                state.statistics.escalatedCheckpointCount += 1
+            }
+            if isBusy {
+                state.statistics.busyCheckpointCount += 1
+            }
+            state.statistics.totalCheckpointDuration += duration
+            state.statistics.maximumCheckpointDuration = max(state.statistics.maximumCheckpointDuration, duration)
+        }
+    }
+    
+    /// Must be called from `queue`.
+    private func makeConnectionIfNeeded() throws -> SerializedDatabase {
+        if let connection = connection {
+            return connection
+        }
+        let connection = try SerializedDatabase(
+            path: path,
+            configuration: configuration,
+            defaultLabel: "GRDB.DatabasePool",
+            purpose: "checkpointer")
+        self.connection = connection
+        return connection
+    }
+}
@@ -163,9 +163,7 @@ public struct FTS5: VirtualTableModule {
                 END;
                 """)
             
-            // https://sqlite.org/fts5.html#the_rebuild_command
-            
-            try db.execute(sql: "INSERT INTO \(ftsTable)(\(ftsTable)) VALUES('rebuild')")
+            try db.rebuildFTS5Index(tableName)
         }
     }
     
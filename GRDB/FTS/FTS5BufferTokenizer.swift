@@ -0,0 +1,178 @@
+#if SQLITE_ENABLE_FTS5
+/// The protocol for custom FTS5 tokenizers that process the whole text
+/// to tokenize at once.
+///
+/// Types that adopt FTS5BufferTokenizer don't have to implement the
+/// low-level FTS5Tokenizer.tokenize(context:flags:pText:nText:tokenCallback:).
+///
+/// Instead, they receive the UTF-8 bytes of the tokenized text, and notify
+/// tokens as byte ranges in this buffer. No Swift string is built. For example,
+/// here is a tokenizer that splits text on commas:
+///
+///     final class CommaTokenizer: FTS5BufferTokenizer {
+///         static let name = "comma"
+///
+///         init(db: Database, arguments: [String]) throws { }
+///
+///         func tokenize(
+///             _ text: UnsafeBufferPointer<UInt8>,
+///             for tokenization: FTS5Tokenization,
+///             into tokens: inout FTS5TokenSink)
+///             throws
+///         {
+///             var start = 0
+///             for (index, byte) in text.enumerated() where byte == UInt8(ascii: ",") {
+///                 if start < index {
+///                     try tokens.append(start..<index)
+///                 }
+///                 start = index + 1
+///             }
+///             if start < text.count {
+///                 try tokens.append(start..<text.count)
+///             }
+///         }
+///     }
+///
+/// See also `FTS5LatinTokenizer`.
+public protocol FTS5BufferTokenizer: FTS5CustomTokenizer {
+    /// Tokenizes the text, and notifies found tokens to the `tokens` sink.
+    ///
+    /// When implementing this method, errors thrown by the `tokens` sink must
+    /// not be caught.
+    ///
+    /// - parameters:
+    ///     - text: The UTF-8 bytes of the tokenized text.
+    ///     - tokenization: The reason why FTS5 is requesting tokenization.
+    ///     - tokens: The sink of found tokens.
+    func tokenize(
+        _ text: UnsafeBufferPointer<UInt8>,
+        for tokenization: FTS5Tokenization,
+        into tokens: inout FTS5TokenSink)
+    throws
+}
+
+/// FTS5TokenSink notifies the tokens found by an `FTS5BufferTokenizer`
+/// to SQLite.
+public struct FTS5TokenSink {
+    private let context: UnsafeMutableRawPointer?
+    private let text: UnsafeBufferPointer<UInt8>
+    private let tokenCallback: FTS5TokenCallback
+    
+    fileprivate init(
+        context: UnsafeMutableRawPointer?,
+        text: UnsafeBufferPointer<UInt8>,
+        tokenCallback: @escaping FTS5TokenCallback)
+    {
+        self.context = context
+        self.text = text
+        self.tokenCallback = tokenCallback
+    }
+    
+    /// Notifies a token made of the text bytes in the given range.
+    ///
+    /// - parameters:
+    ///     - range: The range of the token in the tokenized text.
+    ///     - flags: Flags that tell SQLite how to register the token.
+    /// - precondition: range is a valid range of the tokenized text.
+    public mutating func append(_ range: Range<Int>, flags: FTS5TokenFlags = []) throws {
+        GRDBPrecondition(
+            range.lowerBound >= 0 && range.upperBound <= text.count,
+            "Token range is out of bounds")
+        guard let baseAddress = text.baseAddress else {
+            return
+        }
+        try notify(
+            UnsafeRawPointer(baseAddress + range.lowerBound).assumingMemoryBound(to: Int8.self),
+            count: range.count,
+            range: range,
+            flags: flags)
+    }
+    
+    /// Notifies a token made of the given bytes, found in the given range of the
+    /// tokenized text.
+    ///
+    /// Use this method when the token is not a verbatim copy of the tokenized
+    /// text, as when the tokenizer applies case folding, for example.
+    ///
+    /// - parameters:
+    ///     - token: The UTF-8 bytes of the token.
+    ///     - range: The range of the token in the tokenized text.
+    ///     - flags: Flags that tell SQLite how to register the token.
+    /// - precondition: range is a valid range of the tokenized text.
+    public mutating func append<Token>(
+        _ token: Token,
+        range: Range<Int>,
+        flags: FTS5TokenFlags = [])
+    throws
+    where Token: Collection, Token.Element == UInt8
+    {
+        GRDBPrecondition(
+            range.lowerBound >= 0 && range.upperBound <= text.count,
+            "Token range is out of bounds")
+        let isNotified = try token.withContiguousStorageIfAvailable { buffer in
+            try notify(buffer, range: range, flags: flags)
+        } != nil
+        if isNotified {
+            return
+        }
+        try ContiguousArray(token).withUnsafeBufferPointer { buffer in
+            try notify(buffer, range: range, flags: flags)
+        }
+    }
+    
+    private func notify(_ buffer: UnsafeBufferPointer<UInt8>, range: Range<Int>, flags: FTS5TokenFlags) throws {
+        guard let baseAddress = buffer.baseAddress else {
+            return
+        }
+        try notify(
+            UnsafeRawPointer(baseAddress).assumingMemoryBound(to: Int8.self),
+            count: buffer.count,
+            range: range,
+            flags: flags)
+    }
+    
+    private func notify(
+        _ pToken: UnsafePointer<Int8>,
+        count: Int,
+        range: Range<Int>,
+        flags: FTS5TokenFlags)
+    throws
+    {
+        let code = tokenCallback(
+            context,
+            flags.rawValue,
+            pToken,
+            Int32(count),
+            Int32(range.lowerBound),
+            Int32(range.upperBound))
+        guard code == SQLITE_OK else {
+            throw DatabaseError(resultCode: code, message: "token callback failed")
+        }
+    }
+}
+
+extension FTS5BufferTokenizer {
+    /// Default implementation
+    public func tokenize(
+        context: UnsafeMutableRawPointer?,
+        tokenization: FTS5Tokenization,
+        pText: UnsafePointer<Int8>?,
+        nText: Int32,
+        tokenCallback: @escaping FTS5TokenCallback)
+    -> Int32
+    {
+        let text = UnsafeBufferPointer(
+            start: pText.map { UnsafeRawPointer($0).assumingMemoryBound(to: UInt8.self) },
+            count: pText == nil ? 0 : Int(nText))
+        var tokens = FTS5TokenSink(context: context, text: text, tokenCallback: tokenCallback)
+        do {
+            try tokenize(text, for: tokenization, into: &tokens)
+            return SQLITE_OK
+        } catch let error as DatabaseError {
+            return error.extendedResultCode.rawValue
+        } catch {
+            return SQLITE_ERROR
+        }
+    }
+}
+#endif
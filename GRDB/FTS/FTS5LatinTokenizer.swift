@@ -0,0 +1,280 @@
+#if SQLITE_ENABLE_FTS5
+/// A fast FTS5 tokenizer for text written with ASCII and Latin-1 characters.
+///
+/// Tokens are made of ASCII letters and digits, Latin-1 letters, and all
+/// characters outside of the Latin-1 range. Other characters (spaces, ASCII
+/// and Latin-1 punctuation and symbols) separate tokens.
+///
+/// Tokens are case-folded, and Latin-1 diacritics are removed: "Élève" is
+/// tokenized as "eleve". A few letters are expanded: "æ" is tokenized as
+/// "ae", "ß" as "ss", and "þ" as "th". Characters outside of the Latin-1
+/// range are left untouched.
+///
+/// Runs of lowercase ASCII letters and digits are scanned 16 bytes at a time,
+/// and tokens that are not modified by case folding are notified without any
+/// copy. Unlike the `unicode61` tokenizer, the latin tokenizer is not
+/// Unicode-aware: use it when indexed text is mostly made of Latin-1
+/// characters.
+///
+/// Register the tokenizer before use:
+///
+///     db.add(tokenizer: FTS5LatinTokenizer.self)
+///     try db.create(virtualTable: "book", using: FTS5()) { t in
+///         t.tokenizer = FTS5LatinTokenizer.tokenizerDescriptor()
+///         t.column("title")
+///     }
+///
+/// Diacritics removal can be disabled:
+///
+///     t.tokenizer = FTS5LatinTokenizer.tokenizerDescriptor(removeDiacritics: false)
+public final class FTS5LatinTokenizer: FTS5BufferTokenizer {
+    public static let name = "latin"
+    
+    private let removesDiacritics: Bool
+    
+    /// Creates a latin tokenizer.
+    ///
+    /// The only supported arguments are `remove_diacritics 0` and
+    /// `remove_diacritics 1` (the default).
+    public init(db: Database, arguments: [String]) throws {
+        var removesDiacritics = true
+        var remainingArguments = arguments[...]
+        while let option = remainingArguments.popFirst() {
+            switch (option, remainingArguments.popFirst()) {
+            case ("remove_diacritics", "0"?):
+                removesDiacritics = false
+            case ("remove_diacritics", "1"?):
+                removesDiacritics = true
+            default:
+                throw DatabaseError(message: "invalid \(Self.name) tokenizer arguments: \(arguments)")
+            }
+        }
+        self.removesDiacritics = removesDiacritics
+    }
+    
+    /// Creates an FTS5 tokenizer descriptor.
+    ///
+    ///     db.create(virtualTable: "book", using: FTS5()) { t in
+    ///         t.tokenizer = FTS5LatinTokenizer.tokenizerDescriptor(removeDiacritics: false)
+    ///     }
+    ///
+    /// - parameter removeDiacritics: If true, Latin-1 diacritics are removed.
+    public static func tokenizerDescriptor(removeDiacritics: Bool) -> FTS5TokenizerDescriptor {
+        tokenizerDescriptor(arguments: ["remove_diacritics", removeDiacritics ? "1" : "0"])
+    }
+    
+    public func tokenize(
+        _ text: UnsafeBufferPointer<UInt8>,
+        for tokenization: FTS5Tokenization,
+        into tokens: inout FTS5TokenSink)
+    throws
+    {
+        var scanner = FTS5LatinScanner(text: text, removesDiacritics: removesDiacritics)
+        try scanner.scan(into: &tokens)
+    }
+}
+
+/// The kind of an ASCII byte
+private enum FTS5LatinASCIIClass {
+    case separator
+    case tokenCharacter
+    case uppercaseLetter
+}
+
+private let asciiClasses: [FTS5LatinASCIIClass] = (0..<128).map { byte in
+    switch UInt8(byte) {
+    case UInt8(ascii: "a")...UInt8(ascii: "z"), UInt8(ascii: "0")...UInt8(ascii: "9"):
+        return .tokenCharacter
+    case UInt8(ascii: "A")...UInt8(ascii: "Z"):
+        return .uppercaseLetter
+    default:
+        return .separator
+    }
+}
+
+/// The ASCII replacements of U+00C0 to U+00FF, indexed by the second byte of
+/// their UTF-8 encoding, minus 0x80. Nil for separators (× and ÷).
+private let latin1Replacements: [[UInt8]?] = ([
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", nil, "o", "u", "u", "u", "u", "y", "th", "ss",
+    "a", "a", "a", "a", "a", "a", "ae", "c", "e", "e", "e", "e", "i", "i", "i", "i",
+    "d", "n", "o", "o", "o", "o", "o", nil, "o", "u", "u", "u", "u", "y", "th", "y",
+] as [String?]).map { $0.map { Array($0.utf8) } }
+
+/// Scans a text for FTS5LatinTokenizer.
+private struct FTS5LatinScanner {
+    /// Text is scanned 16 bytes at a time
+    private typealias Chunk = SIMD16<UInt8>
+    private static let chunkLength = MemoryLayout<Chunk>.size
+    
+    private let text: UnsafeBufferPointer<UInt8>
+    private let removesDiacritics: Bool
+    
+    /// The start of the current token, or -1
+    private var tokenStart = -1
+    
+    /// If true, the current token differs from the text, and is
+    /// stored in `foldedToken`.
+    private var isFolded = false
+    private var foldedToken: [UInt8] = []
+    
+    init(text: UnsafeBufferPointer<UInt8>, removesDiacritics: Bool) {
+        self.text = text
+        self.removesDiacritics = removesDiacritics
+    }
+    
+    mutating func scan(into tokens: inout FTS5TokenSink) throws {
+        let count = text.count
+        var index = 0
+        while index < count {
+            if index + Self.chunkLength <= count {
+                let chunk = loadChunk(at: index)
+                if Self.isTokenCharacterChunk(chunk) {
+                    // Fast path: lowercase letters and digits only
+                    appendVerbatim(at: index, count: Self.chunkLength)
+                    index += Self.chunkLength
+                    continue
+                }
+                if Self.isASCIIChunk(chunk) {
+                    // No Latin-1 or multi-byte character
+                    for asciiIndex in index..<(index + Self.chunkLength) {
+                        try scanASCII(at: asciiIndex, into: &tokens)
+                    }
+                    index += Self.chunkLength
+                    continue
+                }
+            }
+            
+            let byte = text[index]
+            if byte < 0x80 {
+                try scanASCII(at: index, into: &tokens)
+                index += 1
+            } else if byte == 0xC3 && index + 1 < count && text[index + 1] & 0xC0 == 0x80 {
+                // U+00C0 to U+00FF: Latin-1 letters, × and ÷
+                try scanLatin1Letter(at: index, into: &tokens)
+                index += 2
+            } else if byte == 0xC2 && index + 1 < count && text[index + 1] & 0xC0 == 0x80 {
+                // U+0080 to U+00BF: Latin-1 punctuation and symbols
+                try endToken(at: index, into: &tokens)
+                index += 2
+            } else {
+                // Other characters are kept untouched
+                let length = min(Self.utf8SequenceLength(leadingByte: byte), count - index)
+                appendVerbatim(at: index, count: length)
+                index += length
+            }
+        }
+        try endToken(at: count, into: &tokens)
+    }
+    
+    private func loadChunk(at index: Int) -> Chunk {
+        var chunk = Chunk()
+        withUnsafeMutableBytes(of: &chunk) { chunkBytes in
+            let bytes = UnsafeRawBufferPointer(text)[index..<(index + Self.chunkLength)]
+            chunkBytes.copyMemory(from: UnsafeRawBufferPointer(rebasing: bytes))
+        }
+        return chunk
+    }
+    
+    /// Returns whether the chunk only contains ASCII lowercase letters
+    /// and digits.
+    private static func isTokenCharacterChunk(_ chunk: Chunk) -> Bool {
+        let isLowercaseLetter = (chunk &- UInt8(ascii: "a")) .< 26
+        let isDigit = (chunk &- UInt8(ascii: "0")) .< 10
+        return all(isLowercaseLetter .| isDigit)
+    }
+    
+    /// Returns whether the chunk only contains ASCII characters.
+    private static func isASCIIChunk(_ chunk: Chunk) -> Bool {
+        !any(chunk .>= 0x80)
+    }
+    
+    private static func utf8SequenceLength(leadingByte byte: UInt8) -> Int {
+        switch byte {
+        case 0xC0...0xDF: return 2
+        case 0xE0...0xEF: return 3
+        case 0xF0...0xF7: return 4
+        default: return 1
+        }
+    }
+    
+    private mutating func scanASCII(at index: Int, into tokens: inout FTS5TokenSink) throws {
+        let byte = text[index]
+        switch asciiClasses[Int(byte)] {
+        case .separator:
+            try endToken(at: index, into: &tokens)
+        case .tokenCharacter:
+            appendVerbatim(at: index, count: 1)
+        case .uppercaseLetter:
+            appendFolded(byte | 0x20, at: index)
+        }
+    }
+    
+    private mutating func scanLatin1Letter(at index: Int, into tokens: inout FTS5TokenSink) throws {
+        let byte = text[index + 1]
+        let offset = Int(byte - 0x80)
+        if removesDiacritics {
+            if let replacement = latin1Replacements[offset] {
+                appendFolded(contentsOf: replacement, at: index)
+            } else {
+                try endToken(at: index, into: &tokens)
+            }
+        } else {
+            switch offset {
+            case 0x17, 0x37:
+                // × and ÷
+                try endToken(at: index, into: &tokens)
+            case 0x00...0x1E:
+                // Uppercase letters: U+00C0 to U+00DE
+                appendFolded(0xC3, at: index)
+                appendFolded(byte + 0x20, at: index)
+            default:
+                appendVerbatim(at: index, count: 2)
+            }
+        }
+    }
+    
+    private mutating func appendVerbatim(at index: Int, count: Int) {
+        if tokenStart < 0 {
+            tokenStart = index
+        }
+        if isFolded {
+            foldedToken.append(contentsOf: text[index..<(index + count)])
+        }
+    }
+    
+    private mutating func startFolding(at index: Int) {
+        if tokenStart < 0 {
+            tokenStart = index
+        }
+        if !isFolded {
+            isFolded = true
+            foldedToken.removeAll(keepingCapacity: true)
+            foldedToken.append(contentsOf: text[tokenStart..<index])
+        }
+    }
+    
+    private mutating func appendFolded(_ byte: UInt8, at index: Int) {
+        startFolding(at: index)
+        foldedToken.append(byte)
+    }
+    
+    private mutating func appendFolded(contentsOf bytes: [UInt8], at index: Int) {
+        startFolding(at: index)
+        foldedToken.append(contentsOf: bytes)
+    }
+    
+    private mutating func endToken(at index: Int, into tokens: inout FTS5TokenSink) throws {
+        guard tokenStart >= 0 else {
+            return
+        }
+        if isFolded {
+            try tokens.append(foldedToken, range: tokenStart..<index)
+        } else {
+            try tokens.append(tokenStart..<index)
+        }
+        tokenStart = -1
+        isFolded = false
+    }
+}
+#endif
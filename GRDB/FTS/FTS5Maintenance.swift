@@ -0,0 +1,173 @@
+#if SQLITE_ENABLE_FTS5
+/// An option that controls how FTS5 merges the b-trees of a full-text index.
+///
+/// FTS5 stores a full-text index in several b-trees, which are progressively
+/// merged as documents are inserted. Queries are faster when the index
+/// contains fewer b-trees.
+///
+/// See https://www.sqlite.org/fts5.html#fts5_configuration_options
+public enum FTS5MergeOption {
+    /// The number of b-trees (between 2 and 16) that are automatically merged
+    /// after each write. Zero disables automatic merges. The SQLite default
+    /// is 4.
+    ///
+    /// See https://www.sqlite.org/fts5.html#the_automerge_configuration_option
+    case automerge(Int)
+    
+    /// The number of b-trees above which they are merged, regardless of the
+    /// `automerge` option. The SQLite default is 16.
+    ///
+    /// See https://www.sqlite.org/fts5.html#the_crisismerge_configuration_option
+    case crisismerge(Int)
+    
+    /// The minimum number of b-trees (between 2 and 16) that are merged by
+    /// `Database.mergeFTS5Index(_:pageCount:)`. The SQLite default is 4.
+    ///
+    /// See https://www.sqlite.org/fts5.html#the_usermerge_configuration_option
+    case usermerge(Int)
+    
+    fileprivate var name: String {
+        switch self {
+        case .automerge: return "automerge"
+        case .crisismerge: return "crisismerge"
+        case .usermerge: return "usermerge"
+        }
+    }
+    
+    fileprivate var value: Int {
+        switch self {
+        case let .automerge(value),
+             let .crisismerge(value),
+             let .usermerge(value):
+            return value
+        }
+    }
+}
+
+extension Database {
+    
+    // MARK: - FTS5 Index Maintenance
+    
+    /// Deletes the full-text index of an FTS5 table, and rebuilds it from the
+    /// content of the table, or its external content table.
+    ///
+    ///     try db.rebuildFTS5Index("document")
+    ///
+    /// See https://www.sqlite.org/fts5.html#the_rebuild_command
+    public func rebuildFTS5Index(_ tableName: String) throws {
+        try executeFTS5Command("rebuild", on: tableName)
+    }
+    
+    /// Merges all b-trees of the full-text index of an FTS5 table into a
+    /// single one.
+    ///
+    ///     try db.optimizeFTS5Index("document")
+    ///
+    /// This makes queries faster, but the whole index is rewritten.
+    /// Prefer `mergeFTS5Index(_:pageCount:)`, or
+    /// `DatabaseWriter.asyncMergeFTS5Index(_:pageCount:completion:)`, in order
+    /// to merge a large index without a long transaction.
+    ///
+    /// See https://www.sqlite.org/fts5.html#the_optimize_command
+    public func optimizeFTS5Index(_ tableName: String) throws {
+        try executeFTS5Command("optimize", on: tableName)
+    }
+    
+    /// Incrementally merges the b-trees of the full-text index of an
+    /// FTS5 table.
+    ///
+    ///     // Write about 500 pages
+    ///     try db.mergeFTS5Index("document", pageCount: 500)
+    ///
+    /// The amount of work is bounded by `pageCount`, so that this method can
+    /// be called repeatedly, in distinct transactions, until it returns false.
+    ///
+    /// See https://www.sqlite.org/fts5.html#the_merge_command
+    ///
+    /// - parameters:
+    ///     - tableName: The name of an FTS5 table.
+    ///     - pageCount: The approximate number of pages written to the
+    ///       database while merging.
+    /// - returns: Whether b-trees were merged. When false, the index does
+    ///   not contain enough b-trees to merge, according to the
+    ///   `usermerge` option.
+    /// - precondition: pageCount is positive.
+    @discardableResult
+    public func mergeFTS5Index(_ tableName: String, pageCount: Int) throws -> Bool {
+        GRDBPrecondition(pageCount > 0, "FTS5 merge page count must be positive")
+        // https://www.sqlite.org/fts5.html#the_merge_command
+        // > If the difference between the two values is 2 or greater, then
+        // > work was performed.
+        let changesCount = totalChangesCount
+        try executeFTS5Command("merge", value: pageCount, on: tableName)
+        return totalChangesCount - changesCount >= 2
+    }
+    
+    /// Sets an option that controls how the b-trees of the full-text index
+    /// of an FTS5 table are merged.
+    ///
+    ///     // Disable automatic merges
+    ///     try db.setFTS5MergeOption(.automerge(0), forTable: "document")
+    ///
+    /// Options are stored in the database.
+    public func setFTS5MergeOption(_ option: FTS5MergeOption, forTable tableName: String) throws {
+        try executeFTS5Command(option.name, value: option.value, on: tableName)
+    }
+    
+    /// See https://www.sqlite.org/fts5.html#special_insert_commands
+    private func executeFTS5Command(_ command: String, value: Int? = nil, on tableName: String) throws {
+        let table = tableName.quotedDatabaseIdentifier
+        if let value = value {
+            try execute(
+                sql: "INSERT INTO \(table)(\(table), rank) VALUES(?, ?)",
+                arguments: [command, value])
+        } else {
+            try execute(
+                sql: "INSERT INTO \(table)(\(table)) VALUES(?)",
+                arguments: [command])
+        }
+    }
+}
+
+extension DatabaseWriter {
+    /// Asynchronously merges the b-trees of the full-text index of an FTS5
+    /// table, until the index is fully merged.
+    ///
+    ///     dbPool.asyncMergeFTS5Index("document") { result in
+    ///         // Handle merge completion
+    ///     }
+    ///
+    /// The index is merged in several steps. Each step writes about
+    /// `pageCount` pages, in its own transaction. Other writes can run
+    /// between two steps: index maintenance does not block the application
+    /// for a long time.
+    ///
+    /// - parameters:
+    ///     - tableName: The name of an FTS5 table.
+    ///     - pageCount: The approximate number of pages written by each step.
+    ///     - completion: A closure that is called when no more b-tree can be
+    ///       merged, or when an error occurs. It is called in a protected
+    ///       dispatch queue, outside of any transaction.
+    /// - precondition: pageCount is positive.
+    public func asyncMergeFTS5Index(
+        _ tableName: String,
+        pageCount: Int = 500,
+        completion: @escaping (Result<Void, Error>) -> Void = { _ in })
+    {
+        GRDBPrecondition(pageCount > 0, "FTS5 merge page count must be positive")
+        asyncWrite({ db in
+            try db.mergeFTS5Index(tableName, pageCount: pageCount)
+        }, completion: { _, result in
+            switch result {
+            case .success(true):
+                // Let other writes run before next step
+                self.asyncMergeFTS5Index(tableName, pageCount: pageCount, completion: completion)
+            case .success(false):
+                completion(.success(()))
+            case let .failure(error):
+                completion(.failure(error))
+            }
+        })
+    }
+}
+#endif
@@ -98,6 +98,65 @@ public struct DatabaseMigrator {
         registerMigration(Migration(identifier: identifier, migrate: migrate))
     }
     
+    /// Registers a chunked migration, for data migrations that would hold
+    /// the database lock for too long in a single transaction.
+    ///
+    /// A chunked migration has two parts. The schema part is applied by
+    /// `migrate(_:)`, just like a regular migration. The data part is
+    /// applied later, chunk after chunk, by `migrateChunks(_:)` or
+    /// `asyncMigrateChunks(_:completion:)`:
+    ///
+    ///     migrator.registerChunkedMigration("backfillScores", migrateSchema: { db in
+    ///         try db.alter(table: "player") { t in
+    ///             t.add(column: "score", .integer)
+    ///         }
+    ///     }, migrateChunk: { db, checkpoint in
+    ///         // Process 1000 players, after the last processed one
+    ///         let lastId = Int64.fromDatabaseValue(checkpoint) ?? 0
+    ///         let ids = try Int64.fetchAll(db, sql: """
+    ///             SELECT id FROM player WHERE id > ? ORDER BY id LIMIT 1000
+    ///             """, arguments: [lastId])
+    ///         guard let newLastId = ids.last else {
+    ///             return nil // Done
+    ///         }
+    ///         try db.execute(sql: """
+    ///             UPDATE player SET score = ... WHERE id > ? AND id <= ?
+    ///             """, arguments: [lastId, newLastId])
+    ///         return newLastId.databaseValue
+    ///     })
+    ///
+    ///     // At application startup
+    ///     try migrator.migrate(dbQueue)
+    ///
+    ///     // Later
+    ///     migrator.asyncMigrateChunks(dbQueue) { _, error in ... }
+    ///
+    /// Each chunk runs in its own transaction, which also stores the
+    /// checkpoint returned by the chunk. The database lock is released
+    /// between two chunks, so that other writes can happen. When the
+    /// application is interrupted, the data migration resumes from the last
+    /// stored checkpoint. The first chunk receives a NULL checkpoint. The last
+    /// chunk returns nil.
+    ///
+    /// The schema part of other migrations must not depend on the data
+    /// produced by the chunks.
+    ///
+    /// - parameters:
+    ///     - identifier: The migration identifier.
+    ///     - migrateSchema: The block that performs the schema part of
+    ///       the migration.
+    ///     - migrateChunk: The block that performs one chunk of the data
+    ///       migration, from a checkpoint. It returns the next checkpoint, or
+    ///       nil when the data migration is complete.
+    /// - precondition: No migration with the same same as already been registered.
+    public mutating func registerChunkedMigration(
+        _ identifier: String,
+        migrateSchema: @escaping (Database) throws -> Void = { _ in },
+        migrateChunk: @escaping (Database, DatabaseValue) throws -> DatabaseValue?)
+    {
+        registerMigration(Migration(identifier: identifier, migrate: migrateSchema, migrateChunk: migrateChunk))
+    }
+    
     // MARK: - Applying Migrations
     
     /// Iterate migrations in the same order as they were registered. If a
@@ -153,6 +212,50 @@ public struct DatabaseMigrator {
         }
     }
     
+    /// Applies the data part of chunked migrations, until completion.
+    ///
+    /// Each chunk runs in its own transaction, so that other writes can
+    /// happen between two chunks.
+    ///
+    /// See `registerChunkedMigration(_:migrateSchema:migrateChunk:)`.
+    ///
+    /// - parameter writer: A DatabaseWriter (DatabaseQueue or DatabasePool)
+    ///   where migrations should apply.
+    /// - throws: An eventual error thrown by the registered migration blocks.
+    public func migrateChunks(_ writer: DatabaseWriter) throws {
+        while try writer.write(runNextChunk) { }
+    }
+    
+    /// Asynchronously applies the data part of chunked migrations,
+    /// until completion.
+    ///
+    /// Each chunk runs in its own transaction, so that other writes can
+    /// happen between two chunks.
+    ///
+    /// See `registerChunkedMigration(_:migrateSchema:migrateChunk:)`.
+    ///
+    /// - parameter writer: A DatabaseWriter (DatabaseQueue or DatabasePool)
+    ///   where migrations should apply.
+    /// - parameter completion: A closure that is called in a protected dispatch
+    ///   queue that can write in the database, with the eventual
+    ///   migration error.
+    public func asyncMigrateChunks(
+        _ writer: DatabaseWriter,
+        completion: @escaping (Database, Error?) -> Void)
+    {
+        writer.asyncWrite(runNextChunk, completion: { db, result in
+            switch result {
+            case .success(true):
+                // Let other writes run before next chunk
+                self.asyncMigrateChunks(writer, completion: completion)
+            case .success(false):
+                completion(db, nil)
+            case let .failure(error):
+                completion(db, error)
+            }
+        })
+    }
+    
     // MARK: - Querying Migrations
     
     /// Returns the identifiers of registered and applied migrations, in the
@@ -206,6 +309,23 @@ public struct DatabaseMigrator {
         try completedMigrations(db).last == migrations.last?.identifier
     }
     
+    /// Returns the identifiers of applied chunked migrations whose data part
+    /// is not complete, in the order of registration.
+    ///
+    /// - parameter db: A database connection.
+    /// - throws: An eventual database error.
+    public func pendingChunkedMigrations(_ db: Database) throws -> [String] {
+        guard migrations.contains(where: { $0.isChunked }),
+              try db.tableExists("grdb_migration_checkpoints")
+        else {
+            return []
+        }
+        let pendingIdentifiers = try Set(String.fetchCursor(
+            db,
+            sql: "SELECT identifier FROM grdb_migration_checkpoints"))
+        return migrations.map(\.identifier).filter { pendingIdentifiers.contains($0) }
+    }
+    
     /// Returns whether database contains unknown migration
     /// identifiers, which is likely the sign that the database
     /// has migrated further than the migrator itself supports.
@@ -266,11 +386,30 @@ public struct DatabaseMigrator {
         }
         
         try db.execute(sql: "CREATE TABLE IF NOT EXISTS grdb_migrations (identifier TEXT NOT NULL PRIMARY KEY)")
+        if unappliedMigrations.contains(where: { $0.isChunked }) {
+            try db.execute(sql: """
+                CREATE TABLE IF NOT EXISTS grdb_migration_checkpoints (
+                  identifier TEXT NOT NULL PRIMARY KEY,
+                  checkpoint)
+                """)
+        }
         for migration in unappliedMigrations {
             try migration.run(db)
         }
     }
     
+    /// Runs one chunk of the first pending chunked migration, and returns
+    /// false if there is no pending chunked migration.
+    private func runNextChunk(_ db: Database) throws -> Bool {
+        guard let identifier = try pendingChunkedMigrations(db).first,
+              let migration = migrations.first(where: { $0.identifier == identifier })
+        else {
+            return false
+        }
+        _ = try migration.runChunk(db)
+        return true
+    }
+    
     private func migrate(_ db: Database, upTo targetIdentifier: String) throws {
         if eraseDatabaseOnSchemaChange {
             var needsErase = false
@@ -3,6 +3,23 @@ struct Migration {
     let identifier: String
     let migrate: (Database) throws -> Void
     
+    /// The data part of a chunked migration: runs one chunk from the given
+    /// checkpoint, and returns the next checkpoint, or nil when the data
+    /// migration is complete.
+    let migrateChunk: ((Database, DatabaseValue) throws -> DatabaseValue?)?
+    
+    init(
+        identifier: String,
+        migrate: @escaping (Database) throws -> Void,
+        migrateChunk: ((Database, DatabaseValue) throws -> DatabaseValue?)? = nil)
+    {
+        self.identifier = identifier
+        self.migrate = migrate
+        self.migrateChunk = migrateChunk
+    }
+    
+    var isChunked: Bool { migrateChunk != nil }
+    
     func run(_ db: Database) throws {
         if try Bool.fetchOne(db, sql: "PRAGMA foreign_keys") ?? false {
             try runWithDeferredForeignKeysChecks(db)
@@ -67,7 +84,42 @@ struct Migration {
             })
     }
     
+    /// Runs one chunk of a chunked migration, and returns whether the data
+    /// migration is complete.
+    ///
+    /// The checkpoint is updated in the current transaction, so that an
+    /// interrupted data migration resumes where it left off.
+    func runChunk(_ db: Database) throws -> Bool {
+        guard let migrateChunk = migrateChunk,
+              let row = try Row.fetchOne(
+                db,
+                sql: "SELECT checkpoint FROM grdb_migration_checkpoints WHERE identifier = ?",
+                arguments: [identifier])
+        else {
+            return true
+        }
+        
+        let checkpoint: DatabaseValue = row[0]
+        if let nextCheckpoint = try migrateChunk(db, checkpoint) {
+            try db.execute(
+                sql: "UPDATE grdb_migration_checkpoints SET checkpoint = ? WHERE identifier = ?",
+                arguments: [nextCheckpoint, identifier])
+            return false
+        } else {
+            try db.execute(
+                sql: "DELETE FROM grdb_migration_checkpoints WHERE identifier = ?",
+                arguments: [identifier])
+            return true
+        }
+    }
+    
     private func insertAppliedIdentifier(_ db: Database) throws {
         try db.execute(sql: "INSERT INTO grdb_migrations (identifier) VALUES (?)", arguments: [identifier])
+        if isChunked {
+            // The data migration starts from a NULL checkpoint
+            try db.execute(
+                sql: "INSERT INTO grdb_migration_checkpoints (identifier, checkpoint) VALUES (?, NULL)",
+                arguments: [identifier])
+        }
     }
 }
@@ -43,6 +43,33 @@ extension QueryInterfaceRequest: FetchRequest {
         try relation.fetchCount(db)
     }
     
+    /// Returns whether the request fetches at least one row.
+    ///
+    ///     // SELECT EXISTS (SELECT 1 FROM player WHERE score > 1000 LIMIT 1)
+    ///     let request = Player.filter(Column("score") > 1000)
+    ///     let hasHighScores = try request.exists(db)
+    ///
+    /// Orderings are not part of the generated SQL. Selected columns are not
+    /// part of the generated SQL either, unless they are needed by a
+    /// `GROUP BY`, `HAVING`, or `OFFSET` clause, or contain an aggregate.
+    ///
+    /// - parameter db: A database connection.
+    public func exists(_ db: Database) throws -> Bool {
+        let subquery = try SQLSubquery.relation(relation.existenceRelation(db))
+        let request: SQLRequest<Bool> = "SELECT \(SQLExpression.exists(subquery))"
+        return try request.fetchOne(db)!
+    }
+    
+    /// Returns whether the request does not fetch any row.
+    ///
+    ///     // SELECT EXISTS (SELECT 1 FROM player LIMIT 1)
+    ///     let noPlayer = try Player.all().isEmpty(db)
+    ///
+    /// - parameter db: A database connection.
+    public func isEmpty(_ db: Database) throws -> Bool {
+        try !exists(db)
+    }
+    
     public func makePreparedRequest(
         _ db: Database,
         forSingleResult singleResult: Bool = false)
@@ -323,6 +350,146 @@ extension QueryInterfaceRequest {
     }
 }
 
+// MARK: - Keyset Pagination
+
+/// The position of a page in a keyset pagination.
+///
+/// A token contains the values of the ordering terms of a request, for the
+/// last row of the previous page. For example, when players are ordered by
+/// descending score and id, the token contains the score and the id of the
+/// last player of the previous page.
+///
+/// See `QueryInterfaceRequest.fetchPage(_:after:limit:)`.
+public struct KeysetPageToken: Hashable {
+    /// The values of the ordering terms of the request.
+    public var values: [DatabaseValue]
+    
+    /// Creates a token from the values of the ordering terms of a request.
+    ///
+    /// Use this initializer in order to restore a token that was given to
+    /// an API client, for example.
+    public init(values: [DatabaseValue]) {
+        self.values = values
+    }
+}
+
+/// A page of records fetched with keyset pagination.
+///
+/// See `QueryInterfaceRequest.fetchPage(_:after:limit:)`.
+public struct KeysetPage<Element> {
+    /// The elements of the page.
+    public var elements: [Element]
+    
+    /// The token of the next page, or nil if this page is the last one.
+    public var nextPageToken: KeysetPageToken?
+}
+
+extension QueryInterfaceRequest {
+    /// Creates a request that only selects the rows that come after the
+    /// page token, according to the ordering of the request.
+    ///
+    ///     // SELECT * FROM player
+    ///     // WHERE (score < 1000 OR score IS NULL)
+    ///     //    OR (score = 1000 AND id > 42)
+    ///     // ORDER BY score DESC, id
+    ///     let token = KeysetPageToken(values: [1000.databaseValue, 42.databaseValue])
+    ///     let request = Player
+    ///         .order(Column("score").desc, Column("id"))
+    ///         .after(token)
+    ///
+    /// Unlike `limit(_:offset:)`, the rows that come before the token are not
+    /// scanned and skipped: use an index on the ordering terms, and deep pages
+    /// are as fast as the first one.
+    ///
+    /// This method must be called after the request has been ordered, and
+    /// the ordering must identify rows uniquely, with a primary key, for
+    /// example. Ordering terms can be ascending or descending. NULL values
+    /// are sorted as in SQLite: first when ascending, last when descending,
+    /// unless the ordering uses `ascNullsLast` or `descNullsFirst`.
+    ///
+    /// See also `fetchPage(_:after:limit:)`.
+    ///
+    /// The request throws a DatabaseError when it is not ordered, when it is
+    /// ordered by an SQL literal, or when the token does not contain as many
+    /// values as the ordering of the request.
+    public func after(_ token: KeysetPageToken) -> QueryInterfaceRequest {
+        let ordering = relation.ordering
+        return map(\.relation) { relation in
+            relation.filter { db in
+                let orderings = try ordering.resolve(db)
+                return try SQLOrdering.keysetPredicate(orderings, after: token.values) ?? false.sqlExpression
+            }
+        }
+    }
+}
+
+extension QueryInterfaceRequest where RowDecoder: FetchableRecord {
+    /// Returns a page of records, fetched with keyset pagination.
+    ///
+    ///     let request = Player.order(Column("score").desc, Column("id"))
+    ///
+    ///     // First page
+    ///     var page = try request.fetchPage(db, limit: 20)
+    ///
+    ///     // Next pages
+    ///     while let token = page.nextPageToken {
+    ///         page = try request.fetchPage(db, after: token, limit: 20)
+    ///     }
+    ///
+    /// The values of the ordering terms are selected along with the records,
+    /// so that the token of the next page is built without any
+    /// extra query.
+    ///
+    /// See `after(_:)` for the requirements on the ordering of the request.
+    ///
+    /// - parameters:
+    ///     - db: A database connection.
+    ///     - token: The token of the page, or nil for the first page.
+    ///     - limit: The maximum number of records in the page.
+    /// - returns: A page of records.
+    /// - precondition: limit is positive.
+    /// - throws: A DatabaseError whenever an SQLite error occurs, or if the
+    ///   request does not fulfill the requirements of `after(_:)`.
+    public func fetchPage(
+        _ db: Database,
+        after token: KeysetPageToken? = nil,
+        limit: Int)
+    throws -> KeysetPage<RowDecoder>
+    {
+        GRDBPrecondition(limit > 0, "Keyset page limit must be positive")
+        let orderings = try relation.ordering.resolve(db)
+        if orderings.isEmpty {
+            throw SQLOrdering.keysetUnorderedError
+        }
+        
+        var request = self
+        if let token = token {
+            request = request.after(token)
+        }
+        
+        // Select ordering values, and one extra row that tells if there
+        // is a next page.
+        let keyColumns = orderings.indices.map { "grdb_keyset\($0)" }
+        let keySelection = try zip(orderings, keyColumns).map { ordering, column in
+            try SQLSelection.aliasedExpression(ordering.keysetExpression(), column)
+        }
+        request = request
+            .map(\.relation) { $0.annotated(with: keySelection) }
+            .limit(limit + 1)
+        
+        var rows = try Row.fetchAll(db, request)
+        var nextPageToken: KeysetPageToken?
+        if rows.count > limit {
+            rows.removeLast(rows.count - limit)
+            let lastRow = rows[limit - 1]
+            nextPageToken = KeysetPageToken(values: keyColumns.map { lastRow[$0] })
+        }
+        return KeysetPage(
+            elements: rows.map(RowDecoder.init(row:)),
+            nextPageToken: nextPageToken)
+    }
+}
+
 // MARK: - Batch Delete
 
 extension QueryInterfaceRequest where RowDecoder: MutablePersistableRecord {
@@ -610,13 +777,25 @@ private func prefetch(
             }
             
             let prefetchedRows = try prefetchRequest.fetchAll(db)
-            let prefetchedGroups = prefetchedRows.grouped(byDatabaseValuesOnColumns: pivotColumns.map { "grdb_\($0)" })
+            let prefetchedColumns = pivotColumns.map { "grdb_\($0)" }
             let groupingIndexes = firstOriginRow.indexes(forColumns: leftColumns)
             
-            for row in originRows {
-                let groupingKey = groupingIndexes.map { row.impl.databaseValue(atUncheckedIndex: $0) }
-                let prefetchedRows = prefetchedGroups[groupingKey, default: []]
-                row.prefetchedRows.setRows(prefetchedRows, forKeyPath: association.keyPath)
+            if groupingIndexes.count == 1,
+               let prefetchedGroups = originRows.mergeJoined(
+                with: prefetchedRows,
+                originIndex: groupingIndexes[0],
+                prefetchedColumn: prefetchedColumns[0])
+            {
+                for (row, prefetchedRows) in zip(originRows, prefetchedGroups) {
+                    row.prefetchedRows.setRows(prefetchedRows, forKeyPath: association.keyPath)
+                }
+            } else {
+                let prefetchedGroups = prefetchedRows.grouped(byDatabaseValuesOnColumns: prefetchedColumns)
+                for row in originRows {
+                    let groupingKey = groupingIndexes.map { row.impl.databaseValue(atUncheckedIndex: $0) }
+                    let prefetchedRows = prefetchedGroups[groupingKey, default: []]
+                    row.prefetchedRows.setRows(prefetchedRows, forKeyPath: association.keyPath)
+                }
             }
         }
     }
@@ -724,6 +903,92 @@ extension Array where Element == Row {
             indexes.map { row.impl.databaseValue(atUncheckedIndex: $0) }
         })
     }
+    
+    /// Returns the prefetched rows of each row, matched with a sort-merge
+    /// join on integer values. Returns nil if some matched values are
+    /// neither integers nor NULL.
+    ///
+    /// Prefetched rows are usually fetched in the order of the pivot column,
+    /// and origin rows in the order of their primary key: in this case, rows
+    /// are not sorted, and the join runs in linear time.
+    ///
+    /// - parameter prefetchedRows: Prefetched rows.
+    /// - parameter originIndex: The index of the matched column in self.
+    /// - parameter prefetchedColumn: The matched column in prefetched rows.
+    fileprivate func mergeJoined(
+        with prefetchedRows: [Row],
+        originIndex: Int,
+        prefetchedColumn: String)
+    -> [[Row]]?
+    {
+        guard let originKeys = integerKeys(atIndex: originIndex) else {
+            return nil
+        }
+        guard let firstPrefetchedRow = prefetchedRows.first else {
+            return Array(repeating: [], count: count)
+        }
+        let prefetchedIndex = firstPrefetchedRow.indexes(forColumns: [prefetchedColumn])[0]
+        guard let prefetchedKeys = prefetchedRows.integerKeys(atIndex: prefetchedIndex) else {
+            return nil
+        }
+        
+        let originPositions = sortedPositions(of: originKeys)
+        let prefetchedPositions = sortedPositions(of: prefetchedKeys)
+        var groups = [[Row]](repeating: [], count: count)
+        var prefetchedCursor = 0
+        var lastKey: Int64?
+        var lastGroup: [Row] = []
+        for originPosition in originPositions {
+            let key = originKeys[originPosition]!
+            if key != lastKey {
+                while prefetchedCursor < prefetchedPositions.count
+                        && prefetchedKeys[prefetchedPositions[prefetchedCursor]]! < key
+                {
+                    prefetchedCursor += 1
+                }
+                var group: [Row] = []
+                while prefetchedCursor < prefetchedPositions.count
+                        && prefetchedKeys[prefetchedPositions[prefetchedCursor]]! == key
+                {
+                    group.append(prefetchedRows[prefetchedPositions[prefetchedCursor]])
+                    prefetchedCursor += 1
+                }
+                lastKey = key
+                lastGroup = group
+            }
+            groups[originPosition] = lastGroup
+        }
+        return groups
+    }
+    
+    /// Returns the integer values at the given index, or nil if some values
+    /// are neither integers nor NULL.
+    private func integerKeys(atIndex index: Int) -> [Int64?]? {
+        var keys: [Int64?] = []
+        keys.reserveCapacity(count)
+        for row in self {
+            switch row.impl.databaseValue(atUncheckedIndex: index).storage {
+            case .null:
+                keys.append(nil)
+            case let .int64(value):
+                keys.append(value)
+            default:
+                return nil
+            }
+        }
+        return keys
+    }
+}
+
+/// Returns the positions of non-null keys, sorted by key. Positions of equal
+/// keys are sorted, so that rows keep their relative ordering.
+private func sortedPositions(of keys: [Int64?]) -> [Int] {
+    var positions = keys.indices.filter { keys[$0] != nil }
+    let isSorted = zip(positions, positions.dropFirst()).allSatisfy { keys[$0]! <= keys[$1]! }
+    if !isSorted {
+        positions.sort { (keys[$0]!, $0) < (keys[$1]!, $1) }
+    }
+    return positions
 }
 
 extension Row {
@@ -91,6 +91,26 @@ extension SQLCollection {
         }
     }
     
+    /// Appends the fingerprint of the collection, and the values of its
+    /// arguments, in the same order as `sql(_:)`.
+    ///
+    /// Returns false if the collection has no fingerprint.
+    func fingerprint(_ fingerprinter: inout SQLFingerprinter) -> Bool {
+        switch impl {
+        case let .array(expressions):
+            fingerprinter.append(.tag("array"))
+            return SQLExpression.fingerprint(expressions, &fingerprinter)
+            
+        case .subquery:
+            return false
+            
+        case let .table(tableName):
+            fingerprinter.append(.tag("table"))
+            fingerprinter.append(.name(tableName))
+            return true
+        }
+    }
+    
     /// Returns an expression that check whether the collection contains
     /// the expression.
     func contains(_ value: SQLExpression) -> SQLExpression {
@@ -996,6 +996,135 @@ extension SQLExpression {
         }
     }
     
+    /// Appends the fingerprint of the expression, and the values of its
+    /// arguments, in the same order as `sql(_:wrappedInParenthesis:)`.
+    ///
+    /// Returns false if the expression has no fingerprint, and its SQL can't
+    /// be cached.
+    func fingerprint(_ fingerprinter: inout SQLFingerprinter) -> Bool {
+        switch impl {
+        case let .column(name):
+            fingerprinter.append(.tag("column"))
+            fingerprinter.append(.name(name))
+            return true
+            
+        case let .qualifiedColumn(name, alias):
+            fingerprinter.append(.tag("column"))
+            fingerprinter.append(.name(name))
+            fingerprinter.append(.name(fingerprinter.context.qualifier(for: alias)))
+            return true
+            
+        case let .databaseValue(dbValue):
+            if dbValue.isNull {
+                fingerprinter.append(.tag("NULL"))
+            } else {
+                fingerprinter.append(argument: dbValue)
+            }
+            return true
+            
+        case let .rowValue(expressions):
+            fingerprinter.append(.tag("row"))
+            return SQLExpression.fingerprint(expressions, &fingerprinter)
+            
+        case .subquery, .exists:
+            return false
+            
+        case let .literal(sqlLiteral):
+            fingerprinter.append(.tag("literal"))
+            return sqlLiteral.fingerprint(&fingerprinter)
+            
+        case let .between(expression: expression, lowerBound: lowerBound, upperBound: upperBound, isNegated: isNegated):
+            fingerprinter.append(.tag(isNegated ? "NOT BETWEEN" : "BETWEEN"))
+            return expression.fingerprint(&fingerprinter)
+                && lowerBound.fingerprint(&fingerprinter)
+                && upperBound.fingerprint(&fingerprinter)
+            
+        case let .binary(op, lhs, rhs):
+            fingerprinter.append(.tag(op.sql))
+            return lhs.fingerprint(&fingerprinter)
+                && rhs.fingerprint(&fingerprinter)
+            
+        case let .escapableBinary(op, lhs, rhs, escape):
+            fingerprinter.append(.tag(op.sql))
+            guard lhs.fingerprint(&fingerprinter), rhs.fingerprint(&fingerprinter) else {
+                return false
+            }
+            if let escape = escape {
+                fingerprinter.append(.tag("ESCAPE"))
+                return escape.fingerprint(&fingerprinter)
+            }
+            return true
+            
+        case let .associativeBinary(op, expressions):
+            fingerprinter.append(.tag(op.sql))
+            return SQLExpression.fingerprint(expressions, &fingerprinter)
+            
+        case let .in(expression, collection, isNegated: isNegated):
+            fingerprinter.append(.tag(isNegated ? "NOT IN" : "IN"))
+            return expression.fingerprint(&fingerprinter)
+                && collection.fingerprint(&fingerprinter)
+            
+        case let .unary(op, expression):
+            fingerprinter.append(.tag("unary"))
+            fingerprinter.append(.name(op.sql))
+            return expression.fingerprint(&fingerprinter)
+            
+        case let .compare(op, lhs, rhs):
+            fingerprinter.append(.tag(op.rawValue))
+            return lhs.fingerprint(&fingerprinter)
+                && rhs.fingerprint(&fingerprinter)
+            
+        case let .tableMatch(alias, expression):
+            fingerprinter.append(.tag("MATCH"))
+            fingerprinter.append(.name(fingerprinter.context.resolvedName(for: alias)))
+            return expression.fingerprint(&fingerprinter)
+            
+        case let .not(expression):
+            fingerprinter.append(.tag("NOT"))
+            return expression.fingerprint(&fingerprinter)
+            
+        case let .collated(expression, collationName):
+            fingerprinter.append(.tag("COLLATE"))
+            fingerprinter.append(.name(collationName.rawValue))
+            return expression.fingerprint(&fingerprinter)
+            
+        case .countAll:
+            fingerprinter.append(.tag("COUNT(*)"))
+            return true
+            
+        case let .function(name, aggregate: _, distinct: distinct, arguments: arguments):
+            fingerprinter.append(.tag(distinct ? "function distinct" : "function"))
+            fingerprinter.append(.name(name))
+            return SQLExpression.fingerprint(arguments, &fingerprinter)
+            
+        case let .isEmpty(expression, isNegated: isNegated):
+            fingerprinter.append(.tag(isNegated ? "> 0" : "= 0"))
+            return expression.fingerprint(&fingerprinter)
+            
+        case .fastPrimaryKey:
+            return false
+            
+        case let .qualifiedFastPrimaryKey(alias):
+            // The primary key depends on the database schema: the cache is
+            // cleared when the schema changes.
+            fingerprinter.append(.tag("primary key"))
+            fingerprinter.append(.name(alias.tableName))
+            fingerprinter.append(.name(fingerprinter.context.qualifier(for: alias)))
+            return true
+        }
+    }
+    
+    /// Appends the fingerprint of a list of expressions.
+    static func fingerprint(_ expressions: [SQLExpression], _ fingerprinter: inout SQLFingerprinter) -> Bool {
+        fingerprinter.append(.count(expressions.count))
+        for expression in expressions {
+            guard expression.fingerprint(&fingerprinter) else {
+                return false
+            }
+        }
+        return true
+    }
+    
     /// Returns the columns that identify a unique row in the request
     ///
     /// When in doubt, returns an empty set.
@@ -98,6 +98,20 @@ public func sum(_ value: SQLSpecificExpressible) -> SQLExpression {
 }
 
 
+// MARK: - ZEROBLOB(...)
+
+/// Returns an expression that evaluates the `ZEROBLOB` SQL function.
+///
+///     // ZEROBLOB(1000000)
+///     zeroBlob(1000000)
+///
+/// A zero-filled blob reserves space that can be written incrementally.
+/// See `Database.openBlob(table:column:rowID:mode:)`.
+public func zeroBlob(_ count: SQLExpressible) -> SQLExpression {
+    .function("ZEROBLOB", [count.sqlExpression])
+}
+
+
 // MARK: - String functions
 
 /// :nodoc:
@@ -73,6 +73,35 @@ extension SQLOrdering {
     }
 }
 
+extension SQLOrdering {
+    /// Appends the fingerprint of the ordering, and the values of its
+    /// arguments, in the same order as `sql(_:)`.
+    ///
+    /// Returns false if the ordering has no fingerprint.
+    func fingerprint(_ fingerprinter: inout SQLFingerprinter) -> Bool {
+        switch impl {
+        case .expression(let expression):
+            fingerprinter.append(.tag("ordering"))
+            return expression.fingerprint(&fingerprinter)
+        case .asc(let expression):
+            fingerprinter.append(.tag("ASC"))
+            return expression.fingerprint(&fingerprinter)
+        case .desc(let expression):
+            fingerprinter.append(.tag("DESC"))
+            return expression.fingerprint(&fingerprinter)
+        case .ascNullsLast(let expression):
+            fingerprinter.append(.tag("ASC NULLS LAST"))
+            return expression.fingerprint(&fingerprinter)
+        case .descNullsFirst(let expression):
+            fingerprinter.append(.tag("DESC NULLS FIRST"))
+            return expression.fingerprint(&fingerprinter)
+        case .literal(let literal):
+            fingerprinter.append(.tag("literal"))
+            return literal.fingerprint(&fingerprinter)
+        }
+    }
+}
+
 extension SQLOrdering {
     func qualified(with alias: TableAlias) -> SQLOrdering {
         switch impl {
@@ -114,6 +143,125 @@ extension SQLOrdering {
     }
 }
 
+extension SQLOrdering {
+    /// The expression of the ordering, and its sort order.
+    private struct KeysetComponent {
+        var expression: SQLExpression
+        var isDescending: Bool
+        var nullsFirst: Bool
+        
+        /// Returns a predicate that selects values that are strictly after
+        /// `value`, or nil if no value can be after `value`.
+        ///
+        ///     -- ASC
+        ///     <expression> > <value>
+        ///     <expression> IS NOT NULL -- when value is NULL
+        ///
+        ///     -- DESC
+        ///     <expression> < <value> OR <expression> IS NULL
+        ///     nil                      -- when value is NULL
+        func predicate(after value: DatabaseValue) -> SQLExpression? {
+            if value.isNull {
+                // NULL is the first or the last value
+                return nullsFirst ? .compare(.isNot, expression, .null) : nil
+            }
+            let comparison = SQLExpression.binary(
+                isDescending ? .lessThan : .greaterThan,
+                expression,
+                .databaseValue(value))
+            if nullsFirst {
+                return comparison
+            } else {
+                return .associativeBinary(.or, [comparison, .compare(.is, expression, .null)])
+            }
+        }
+    }
+    
+    /// - throws: A DatabaseError if the ordering is a literal.
+    private func keysetComponent() throws -> KeysetComponent {
+        switch impl {
+        case .expression(let expression),
+             .asc(let expression):
+            return KeysetComponent(expression: expression, isDescending: false, nullsFirst: true)
+        case .desc(let expression):
+            return KeysetComponent(expression: expression, isDescending: true, nullsFirst: false)
+        case .ascNullsLast(let expression):
+            return KeysetComponent(expression: expression, isDescending: false, nullsFirst: false)
+        case .descNullsFirst(let expression):
+            return KeysetComponent(expression: expression, isDescending: true, nullsFirst: true)
+        case .literal:
+            throw DatabaseError(resultCode: .SQLITE_MISUSE, message: """
+                Ordering literals can't be used for keyset pagination. \
+                To resolve this error, order by expression literals instead.
+                """)
+        }
+    }
+    
+    /// The ordered expression, used by keyset pagination.
+    ///
+    /// - throws: A DatabaseError if the ordering is a literal.
+    func keysetExpression() throws -> SQLExpression {
+        try keysetComponent().expression
+    }
+    
+    /// Returns a predicate that selects the rows that come strictly after
+    /// `values`, according to `orderings`. Returns nil if no row can come
+    /// after `values`.
+    ///
+    ///     -- ORDER BY a, b
+    ///     (a, b) > (?, ?)
+    ///
+    ///     -- ORDER BY a DESC, b
+    ///     (a < ? OR a IS NULL) OR (a = ? AND b > ?)
+    ///
+    /// - throws: A DatabaseError if orderings are empty, contain a literal, or
+    ///   do not match the values.
+    static func keysetPredicate(_ orderings: [SQLOrdering], after values: [DatabaseValue]) throws -> SQLExpression? {
+        if orderings.isEmpty {
+            throw keysetUnorderedError
+        }
+        if orderings.count != values.count {
+            // Tokens may come from untrusted clients: don't crash.
+            throw DatabaseError(
+                resultCode: .SQLITE_MISUSE,
+                message: "Keyset page token does not match the ordering of the request")
+        }
+        let components = try orderings.map { try $0.keysetComponent() }
+        
+        // Row values can only handle ascending orderings of non-null values:
+        // NULL can not be compared.
+        if SQLExpression.rowValuesAreAvailable,
+           components.count > 1,
+           components.allSatisfy({ !$0.isDescending && $0.nullsFirst }),
+           !values.contains(where: \.isNull),
+           let lhs = SQLExpression.rowValue(components.map(\.expression)),
+           let rhs = SQLExpression.rowValue(values.map(SQLExpression.databaseValue))
+        {
+            return .binary(.greaterThan, lhs, rhs)
+        }
+        
+        // (a > ?) OR (a = ? AND b > ?) OR ...
+        var alternatives: [SQLExpression] = []
+        var equalities: [SQLExpression] = []
+        for (component, value) in zip(components, values) {
+            if let predicate = component.predicate(after: value) {
+                alternatives.append(.associativeBinary(.and, equalities + [predicate]))
+            }
+            equalities.append(.equal(component.expression, .databaseValue(value)))
+        }
+        if alternatives.isEmpty {
+            return nil
+        }
+        return .associativeBinary(.or, alternatives)
+    }
+    
+    /// The error thrown when keyset pagination is used on an
+    /// unordered request.
+    static var keysetUnorderedError: DatabaseError {
+        DatabaseError(resultCode: .SQLITE_MISUSE, message: "Keyset pagination requires an ordered request")
+    }
+}
+
 // MARK: - SQLOrderingTerm
 
 /// The protocol for all types that can be used as an SQL ordering term, as
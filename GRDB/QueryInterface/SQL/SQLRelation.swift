@@ -530,13 +530,35 @@ extension SQLRelation {
 extension SQLRelation {
     func fetchCount(_ db: Database) throws -> Int {
         guard groupPromise == nil && limit == nil && ctes.isEmpty else {
+            if groupPromise == nil && havingExpressionPromise == nil && !isDistinct && ctes.isEmpty {
+                // SELECT ... LIMIT ...
+                // ->
+                // SELECT COUNT(*) FROM (SELECT 1 ... LIMIT ...)
+                //
+                // The ordering does not change the number of rows.
+                return try fetchTrivialCount(db, of: unordered().selectOnly([.expression(1.sqlExpression)]))
+            }
+            
             // SELECT ... GROUP BY ...
-            // SELECT ... LIMIT ...
+            // SELECT DISTINCT ... LIMIT ...
             // WITH ... SELECT ...
             return try fetchTrivialCount(db)
         }
     
         if children.contains(where: { $0.value.impactsParentCount }) { // TODO: not tested
+            // SELECT DISTINCT player.* FROM player JOIN team ...
+            // ->
+            // SELECT COUNT(DISTINCT player.id) FROM player JOIN team ...
+            if isDistinct,
+               try selectsOwnColumnsOnly(db),
+               let primaryKeyColumn = try uniqueRowKeyColumn(db)
+            {
+                var countRelation = unordered()
+                countRelation.isDistinct = false
+                countRelation = countRelation.select(.countDistinct(.column(primaryKeyColumn)))
+                return try QueryInterfaceRequest(relation: countRelation).fetchOne(db)!
+            }
+            
             // SELECT ... FROM ... JOIN ...
             return try fetchTrivialCount(db)
         }
@@ -545,6 +567,18 @@ extension SQLRelation {
         GRDBPrecondition(!selection.isEmpty, "Can't generate SQL with empty selection")
         if selection.count == 1 {
             guard let count = selection[0].count(distinct: isDistinct) else {
+                // SELECT DISTINCT * FROM player
+                // ->
+                // SELECT COUNT(*) FROM player
+                //
+                // Rows are distinct when the table has a non-null
+                // primary key.
+                if isDistinct && selection[0].isAllColumns && havingExpressionPromise == nil {
+                    if try uniqueRowKeyColumn(db) != nil || hasWithoutRowIDSource(db) {
+                        let countRelation = unordered().with(\.isDistinct, false).select(.countAll)
+                        return try QueryInterfaceRequest(relation: countRelation).fetchOne(db)!
+                    }
+                }
                 return try fetchTrivialCount(db)
             }
             var countRelation = self.unordered()
@@ -573,9 +607,101 @@ extension SQLRelation {
     
     // SELECT COUNT(*) FROM (self)
     private func fetchTrivialCount(_ db: Database) throws -> Int {
-        let countRequest: SQLRequest<Int> = "SELECT COUNT(*) FROM (\(SQLSubquery.relation(unordered())))"
+        try fetchTrivialCount(db, of: unordered())
+    }
+    
+    // SELECT COUNT(*) FROM (relation)
+    private func fetchTrivialCount(_ db: Database, of relation: SQLRelation) throws -> Int {
+        let countRequest: SQLRequest<Int> = "SELECT COUNT(*) FROM (\(SQLSubquery.relation(relation)))"
         return try countRequest.fetchOne(db)!
     }
+    
+    /// True if the relation selects `*`, and joined relations do not
+    /// select anything.
+    private func selectsOwnColumnsOnly(_ db: Database) throws -> Bool {
+        let selection = try selectionPromise.resolve(db)
+        guard selection.count == 1 && selection[0].isAllColumns else {
+            return false
+        }
+        return try children.values.allSatisfy { try $0.relation.selectsNothing(db) }
+    }
+    
+    /// True if the relation and its joined relations do not select anything.
+    private func selectsNothing(_ db: Database) throws -> Bool {
+        try selectionPromise.resolve(db).isEmpty
+            && children.values.allSatisfy { try $0.relation.selectsNothing(db) }
+    }
+    
+    /// Returns the INTEGER PRIMARY KEY, or the single-column primary key of
+    /// a WITHOUT ROWID table, if the source is a table. Those columns
+    /// uniquely identify rows, and are never NULL.
+    private func uniqueRowKeyColumn(_ db: Database) throws -> String? {
+        guard try db.tableExists(source.tableName) else {
+            // View, or common table expression
+            return nil
+        }
+        let primaryKey = try db.primaryKey(source.tableName)
+        if let rowIDColumn = primaryKey.rowIDColumn {
+            return rowIDColumn
+        }
+        if !primaryKey.tableHasRowID && primaryKey.columns.count == 1 {
+            return primaryKey.columns[0]
+        }
+        return nil
+    }
+    
+    /// True if the source is a WITHOUT ROWID table: its rows are uniquely
+    /// identified by a non-null primary key.
+    private func hasWithoutRowIDSource(_ db: Database) throws -> Bool {
+        guard try db.tableExists(source.tableName) else {
+            return false
+        }
+        return try !db.primaryKey(source.tableName).tableHasRowID
+    }
+}
+
+extension SQLRelation {
+    /// Returns a relation that fetches one row if and only if the relation
+    /// is not empty.
+    ///
+    ///     -- SELECT * FROM player WHERE ... ORDER BY ...
+    ///     SELECT 1 FROM player WHERE ... LIMIT 1
+    func existenceRelation(_ db: Database) throws -> SQLRelation {
+        let relation = unordered()
+        
+        if groupPromise != nil || havingExpressionPromise != nil {
+            // Groups can be filtered by HAVING: keep them.
+            return relation.limitedToOneRow()
+        }
+        
+        if limit?.offset != nil {
+            // The number of skipped rows depends on the selection and
+            // DISTINCT: keep them.
+            return relation
+        }
+        
+        if try selectionPromise.resolve(db).contains(where: \.isAggregate) {
+            // Without GROUP BY, an aggregate selection fetches one row, even
+            // if the table is empty: keep it.
+            return relation.limitedToOneRow()
+        }
+        
+        // DISTINCT does not change whether a relation is empty
+        var existenceRelation = relation
+            .selectOnly([.expression(1.sqlExpression)])
+            .limitedToOneRow()
+        existenceRelation.isDistinct = false
+        return existenceRelation
+    }
+    
+    /// Returns a relation limited to one row, unless it is already limited.
+    private func limitedToOneRow() -> SQLRelation {
+        if limit == nil {
+            return with(\.limit, SQLLimit(limit: 1, offset: nil))
+        } else {
+            return self
+        }
+    }
 }
 
 // MARK: - SQLLimit
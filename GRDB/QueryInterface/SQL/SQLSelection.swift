@@ -50,6 +50,14 @@ public struct SQLSelection {
 }
 
 extension SQLSelection {
+    /// True if the selection is `*`
+    var isAllColumns: Bool {
+        if case .allColumns = impl {
+            return true
+        }
+        return false
+    }
+    
     /// Returns the number of columns in the selection.
     ///
     /// Returns nil when the number of columns is unknown.
@@ -201,6 +209,36 @@ extension SQLSelection {
         }
     }
     
+    /// Appends the fingerprint of the selection, and the values of its
+    /// arguments, in the same order as `sql(_:)`.
+    ///
+    /// Returns false if the selection has no fingerprint.
+    func fingerprint(_ fingerprinter: inout SQLFingerprinter) -> Bool {
+        switch impl {
+        case .allColumns:
+            fingerprinter.append(.tag("*"))
+            return true
+            
+        case let .qualifiedAllColumns(alias):
+            fingerprinter.append(.tag("*"))
+            fingerprinter.append(.name(fingerprinter.context.qualifier(for: alias)))
+            return true
+            
+        case let .expression(expression):
+            fingerprinter.append(.tag("expression"))
+            return expression.fingerprint(&fingerprinter)
+            
+        case let .aliasedExpression(expression, name):
+            fingerprinter.append(.tag("AS"))
+            fingerprinter.append(.name(name))
+            return expression.fingerprint(&fingerprinter)
+            
+        case let .literal(sqlLiteral):
+            fingerprinter.append(.tag("literal"))
+            return sqlLiteral.fingerprint(&fingerprinter)
+        }
+    }
+    
     /// Returns true if the selection is an aggregate.
     ///
     /// When in doubt, returns false.
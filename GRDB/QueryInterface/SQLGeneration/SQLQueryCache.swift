@@ -0,0 +1,134 @@
+/// SQLFingerprint is the structural fingerprint of a query interface request.
+///
+/// Two requests that only differ by the values they embed have the same
+/// fingerprint, and generate the same SQL:
+///
+///     // Same fingerprint
+///     // SELECT * FROM player WHERE score > ?
+///     Player.filter(Column("score") > 1000)
+///     Player.filter(Column("score") > 2000)
+///
+///     // Different fingerprint
+///     // SELECT * FROM player WHERE score IS NULL
+///     Player.filter(Column("score") == nil)
+struct SQLFingerprint: Hashable {
+    enum Token: Hashable {
+        /// A node of the request tree, a keyword, an operator...
+        case tag(String)
+        
+        /// An identifier, an SQL snippet...
+        case name(String?)
+        
+        /// The number of elements in a list
+        case count(Int)
+    }
+    
+    fileprivate var tokens: [Token] = []
+}
+
+/// SQLFingerprinter builds the fingerprint of a request, and gathers the
+/// values of its statement arguments, in the same order as SQL generation.
+struct SQLFingerprinter {
+    /// A generation context, used to resolve the qualifiers of table aliases
+    let context: SQLGenerationContext
+    private(set) var fingerprint = SQLFingerprint()
+    private(set) var arguments: [DatabaseValue] = []
+    
+    init(_ context: SQLGenerationContext) {
+        self.context = context
+    }
+    
+    mutating func append(_ token: SQLFingerprint.Token) {
+        fingerprint.tokens.append(token)
+    }
+    
+    mutating func append(argument: DatabaseValue) {
+        fingerprint.tokens.append(.tag("?"))
+        arguments.append(argument)
+    }
+    
+    mutating func append<S: Sequence>(arguments: S) where S.Element == DatabaseValue {
+        self.arguments.append(contentsOf: arguments)
+    }
+}
+
+/// A thread-unsafe cache of the SQL generated by query interface requests,
+/// indexed by request fingerprint.
+///
+/// A cache hit skips SQL generation and, when possible, statement
+/// compilation: the cached statement is reused, with fresh arguments.
+struct SQLQueryCache {
+    /// A cache entry.
+    private final class Entry {
+        let sql: String
+        
+        /// The region selected by the statement, before it is optimized with
+        /// the rowids of the request.
+        let selectedRegion: DatabaseRegion
+        
+        /// The cached statement. It is only reused when it is not retained by
+        /// any cursor or prepared request.
+        var statement: SelectStatement
+        var lastUse: UInt64
+        
+        init(statement: SelectStatement, lastUse: UInt64) {
+            self.sql = statement.sql
+            self.selectedRegion = statement.databaseRegion
+            self.statement = statement
+            self.lastUse = lastUse
+        }
+    }
+    
+    /// The maximum number of cached requests
+    static let capacity = 64
+    
+    private var entries: [SQLFingerprint: Entry] = [:]
+    
+    /// Incremented on each cache access, and used to sort entries by
+    /// last usage.
+    private var clock: UInt64 = 0
+    
+    /// Returns a statement for the given fingerprint, along with the region
+    /// it selects, or nil if the fingerprint is not in the cache.
+    ///
+    /// The arguments and the region of the returned statement must be set.
+    mutating func selectStatement(
+        _ db: Database,
+        fingerprint: SQLFingerprint)
+    throws -> (statement: SelectStatement, selectedRegion: DatabaseRegion)?
+    {
+        guard let entry = entries[fingerprint] else {
+            return nil
+        }
+        clock += 1
+        entry.lastUse = clock
+        if isKnownUniquelyReferenced(&entry.statement) {
+            return (statement: entry.statement, selectedRegion: entry.selectedRegion)
+        } else {
+            // The cached statement is busy (iterated by a cursor, for
+            // example): compile a new one.
+            let statement = try db.makeSelectStatement(sql: entry.sql)
+            return (statement: statement, selectedRegion: entry.selectedRegion)
+        }
+    }
+    
+    /// Caches a statement that has just been compiled, and has not been
+    /// modified yet.
+    mutating func insert(_ statement: SelectStatement, fingerprint: SQLFingerprint) {
+        if entries.count >= Self.capacity,
+           let lruFingerprint = entries.min(by: { $0.value.lastUse < $1.value.lastUse })?.key
+        {
+            entries.removeValue(forKey: lruFingerprint)
+        }
+        clock += 1
+        entries[fingerprint] = Entry(statement: statement, lastUse: clock)
+    }
+    
+    mutating func remove(_ statement: SelectStatement) {
+        entries.removeFirst { $0.value.statement === statement }
+    }
+    
+    mutating func clear() {
+        entries = [:]
+    }
+}
@@ -107,6 +107,20 @@ struct SQLQueryGenerator: Refinable {
     
     /// Returns a select statement
     func makeSelectStatement(_ db: Database) throws -> SelectStatement {
+        // Requests that only differ by their values share the same
+        // generated SQL.
+        let fingerprinted = try fingerprint(db)
+        if let fingerprinted = fingerprinted,
+           let cached = try db.sqlQueryCache.selectStatement(db, fingerprint: fingerprinted.fingerprint)
+        {
+            let statement = cached.statement
+            statement.setUncheckedArguments(StatementArguments(fingerprinted.arguments))
+            statement.databaseRegion = try optimizedSelectedRegion(
+                db, cached.selectedRegion,
+                filter: fingerprinted.filter)
+            return statement
+        }
+        
         // Build
         let context = SQLGenerationContext(db)
         let sql = try requestSQL(context)
@@ -114,10 +128,15 @@ struct SQLQueryGenerator: Refinable {
         // Compile & set arguments
         let statement = try db.makeSelectStatement(sql: sql)
         statement.arguments = context.arguments
+        if let fingerprinted = fingerprinted {
+            db.sqlQueryCache.insert(statement, fingerprint: fingerprinted.fingerprint)
+        }
         
         // Optimize statement region. This allows us to track individual rowids,
         // and also find some provably empty requests such as `Player.none()`.
-        statement.databaseRegion = try optimizedSelectedRegion(db, statement.databaseRegion)
+        statement.databaseRegion = try optimizedSelectedRegion(
+            db, statement.databaseRegion,
+            filter: relation.filterPromise?.resolve(db))
         
         if !statement.databaseRegion.isEmpty {
             // Unless the statement region is provably empty, also append the
@@ -145,7 +164,12 @@ struct SQLQueryGenerator: Refinable {
         return statement
     }
     
-    private func optimizedSelectedRegion(_ db: Database, _ selectedRegion: DatabaseRegion) throws -> DatabaseRegion {
+    private func optimizedSelectedRegion(
+        _ db: Database,
+        _ selectedRegion: DatabaseRegion,
+        filter: SQLExpression?)
+    throws -> DatabaseRegion
+    {
         // Can we intersect the region with rowIds?
         //
         // Give up unless request feeds from a single database table
@@ -155,7 +179,7 @@ struct SQLQueryGenerator: Refinable {
         }
         
         // The filter knows better
-        guard let filter = try relation.filterPromise?.resolve(db),
+        guard let filter = filter,
               let rowIDs = try filter.identifyingRowIDs(db, for: relation.source.alias)
         else {
             return selectedRegion
@@ -164,6 +188,66 @@ struct SQLQueryGenerator: Refinable {
         return selectedRegion.tableIntersection(tableName, rowIds: rowIDs)
     }
     
+    /// Returns the fingerprint of the request, the values of its statement
+    /// arguments, and its resolved filter.
+    ///
+    /// The result is nil when the generated SQL can't be cached: requests
+    /// with joins, prefetched associations, common table expressions, or
+    /// subqueries don't have any fingerprint.
+    private func fingerprint(_ db: Database) throws
+    -> (fingerprint: SQLFingerprint, arguments: [DatabaseValue], filter: SQLExpression?)?
+    {
+        guard relation.joins.isEmpty,
+              relation.ctes.isEmpty,
+              prefetchedAssociations.isEmpty
+        else {
+            return nil
+        }
+        
+        let context = SQLGenerationContext(db, aliases: relation.allAliases)
+        var fingerprinter = SQLFingerprinter(context)
+        
+        fingerprinter.append(.tag(relation.isDistinct ? "SELECT DISTINCT" : "SELECT"))
+        let selection = try relation.selectionPromise.resolve(db)
+        fingerprinter.append(.count(selection.count))
+        for selection in selection {
+            guard selection.fingerprint(&fingerprinter) else { return nil }
+        }
+        
+        fingerprinter.append(.tag("FROM"))
+        fingerprinter.append(.name(relation.source.tableName))
+        fingerprinter.append(.name(context.aliasName(for: relation.source.alias)))
+        
+        let filter = try relation.filterPromise?.resolve(db)
+        if let filter = filter {
+            fingerprinter.append(.tag("WHERE"))
+            guard filter.fingerprint(&fingerprinter) else { return nil }
+        }
+        
+        if let groupExpressions = try relation.groupPromise?.resolve(db) {
+            fingerprinter.append(.tag("GROUP BY"))
+            guard SQLExpression.fingerprint(groupExpressions, &fingerprinter) else { return nil }
+        }
+        
+        if let havingExpression = try relation.havingExpressionPromise?.resolve(db) {
+            fingerprinter.append(.tag("HAVING"))
+            guard havingExpression.fingerprint(&fingerprinter) else { return nil }
+        }
+        
+        let orderings = try relation.ordering.resolve(db)
+        fingerprinter.append(.tag("ORDER BY"))
+        fingerprinter.append(.count(orderings.count))
+        for ordering in orderings {
+            guard ordering.fingerprint(&fingerprinter) else { return nil }
+        }
+        
+        // Limits are not statement arguments
+        fingerprinter.append(.tag(singleResult ? "LIMIT single" : "LIMIT"))
+        fingerprinter.append(.name(relation.limit?.sql))
+        
+        return (fingerprint: fingerprinter.fingerprint, arguments: fingerprinter.arguments, filter: filter)
+    }
+    
     /// If true, executing this query yields at most one row.
     /// If false, we don't know how many rows this query returns.
     private func expectsSingleResult(
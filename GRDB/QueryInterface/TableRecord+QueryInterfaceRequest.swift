@@ -185,6 +185,11 @@ extension TableRecord {
     ///
     ///     // SELECT * FROM player WHERE id IN (1, 2, 3)
     ///     let request = Player.filter(keys: [1, 2, 3])
+    ///
+    /// The request can not contain more keys than
+    /// `Database.maximumStatementArgumentCount`. Prefer methods such as
+    /// `fetchAll(_:keys:)` or `deleteAll(_:keys:)` for large sets of keys:
+    /// they split the keys in several statements.
     public static func filter<Sequence>(keys: Sequence)
     -> QueryInterfaceRequest<Self>
     where Sequence: Swift.Sequence, Sequence.Element: DatabaseValueConvertible
@@ -70,6 +70,10 @@ private struct _RowDecoder<R: FetchableRecord>: Decoder {
         var codingPath: [CodingKey] { decoder.codingPath }
         var decodedRootKey: CodingKey?
         
+        /// The number of column lookups performed so far.
+        /// See `SelectStatement.decodingColumnIndex(forKey:position:)`.
+        private var keyPosition = 0
+        
         init(decoder: _RowDecoder) {
             self.decoder = decoder
         }
@@ -84,7 +88,7 @@ private struct _RowDecoder<R: FetchableRecord>: Decoder {
         
         func contains(_ key: Key) -> Bool {
             let row = decoder.row
-            return row.hasColumn(key.stringValue)
+            return columnIndex(forKey: key) != nil
                 || (row.scopesTree[key.stringValue] != nil)
                 || (row.prefetchedRows[key.stringValue] != nil)
         }
@@ -93,25 +97,28 @@ private struct _RowDecoder<R: FetchableRecord>: Decoder {
             // Nil is only possible for columns and scopes (optional
             // associations), not for prefetched rows.
             let row = decoder.row
-            return row[key.stringValue] == nil && (row.scopesTree[key.stringValue] == nil)
+            if let index = columnIndex(forKey: key), !row.impl.hasNull(atUncheckedIndex: index) {
+                return false
+            }
+            return row.scopesTree[key.stringValue] == nil
         }
         
         // swiftlint:disable comma
         // swiftlint:disable line_length
-        func decode(_ type: Bool.Type,   forKey key: Key) throws -> Bool   { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: Int.Type,    forKey key: Key) throws -> Int    { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: Int8.Type,   forKey key: Key) throws -> Int8   { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: Int16.Type,  forKey key: Key) throws -> Int16  { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: Int32.Type,  forKey key: Key) throws -> Int32  { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: Int64.Type,  forKey key: Key) throws -> Int64  { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: UInt.Type,   forKey key: Key) throws -> UInt   { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: UInt8.Type,  forKey key: Key) throws -> UInt8  { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: Float.Type,  forKey key: Key) throws -> Float  { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try decoder.row.decode(forKey: key.stringValue) }
-        func decode(_ type: String.Type, forKey key: Key) throws -> String { try decoder.row.decode(forKey: key.stringValue) }
+        func decode(_ type: Bool.Type,   forKey key: Key) throws -> Bool   { try decodeColumn(type, forKey: key) }
+        func decode(_ type: Int.Type,    forKey key: Key) throws -> Int    { try decodeColumn(type, forKey: key) }
+        func decode(_ type: Int8.Type,   forKey key: Key) throws -> Int8   { try decodeColumn(type, forKey: key) }
+        func decode(_ type: Int16.Type,  forKey key: Key) throws -> Int16  { try decodeColumn(type, forKey: key) }
+        func decode(_ type: Int32.Type,  forKey key: Key) throws -> Int32  { try decodeColumn(type, forKey: key) }
+        func decode(_ type: Int64.Type,  forKey key: Key) throws -> Int64  { try decodeColumn(type, forKey: key) }
+        func decode(_ type: UInt.Type,   forKey key: Key) throws -> UInt   { try decodeColumn(type, forKey: key) }
+        func decode(_ type: UInt8.Type,  forKey key: Key) throws -> UInt8  { try decodeColumn(type, forKey: key) }
+        func decode(_ type: UInt16.Type, forKey key: Key) throws -> UInt16 { try decodeColumn(type, forKey: key) }
+        func decode(_ type: UInt32.Type, forKey key: Key) throws -> UInt32 { try decodeColumn(type, forKey: key) }
+        func decode(_ type: UInt64.Type, forKey key: Key) throws -> UInt64 { try decodeColumn(type, forKey: key) }
+        func decode(_ type: Float.Type,  forKey key: Key) throws -> Float  { try decodeColumn(type, forKey: key) }
+        func decode(_ type: Double.Type, forKey key: Key) throws -> Double { try decodeColumn(type, forKey: key) }
+        func decode(_ type: String.Type, forKey key: Key) throws -> String { try decodeColumn(type, forKey: key) }
         // swiftlint:enable line_length
         // swiftlint:enable comma
         
@@ -120,7 +127,7 @@ private struct _RowDecoder<R: FetchableRecord>: Decoder {
             let keyName = key.stringValue
             
             // Column?
-            if let index = row.index(forColumn: keyName) {
+            if let index = columnIndex(forKey: key) {
                 // Prefer DatabaseValueConvertible decoding over Decodable.
                 // This allows decoding Date from String, or DatabaseValue from NULL.
                 if type == Date.self {
@@ -152,7 +159,7 @@ private struct _RowDecoder<R: FetchableRecord>: Decoder {
             let keyName = key.stringValue
             
             // Column?
-            if let index = row.index(forColumn: keyName) {
+            if let index = columnIndex(forKey: key) {
                 // Prefer DatabaseValueConvertible decoding over Decodable.
                 // This allows decoding Date from String, or DatabaseValue from NULL.
                 if type == Date.self {
@@ -238,6 +245,32 @@ private struct _RowDecoder<R: FetchableRecord>: Decoder {
         
         // Helper methods
         
+        /// Returns the index of the column for the given key.
+        ///
+        /// Rows that directly map a statement use the decoding plan of the
+        /// statement, which avoids case-insensitive column lookups after the
+        /// first row has been decoded.
+        @inline(__always)
+        private func columnIndex(forKey key: Key) -> Int? {
+            let row = decoder.row
+            guard let statement = row.statement else {
+                return row.index(forColumn: key.stringValue)
+            }
+            defer { keyPosition += 1 }
+            return statement.decodingColumnIndex(forKey: key.stringValue, position: keyPosition)
+        }
+        
+        @inline(__always)
+        private func decodeColumn<T>(_ type: T.Type, forKey key: Key) throws -> T
+        where T: DatabaseValueConvertible & StatementColumnConvertible
+        {
+            let row = decoder.row
+            guard let index = columnIndex(forKey: key) else {
+                throw RowDecodingError.columnNotFound(key.stringValue, context: RowDecodingContext(row: row))
+            }
+            return try T.fastDecode(fromRow: row, atUncheckedIndex: index)
+        }
+        
         @inline(__always)
         private func decode<T>(
             _ type: T.Type,
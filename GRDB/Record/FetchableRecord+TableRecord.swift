@@ -89,6 +89,10 @@ extension FetchableRecord where Self: TableRecord {
     ///
     /// Records are iterated in unspecified order.
     ///
+    /// The cursor is fed by a single statement, which can not contain more
+    /// keys than `Database.maximumStatementArgumentCount`. For large sets of
+    /// keys, use `fetchChunkedCursor(_:keys:)`.
+    ///
     /// - parameters:
     ///     - db: A database connection.
     ///     - keys: A sequence of primary keys.
@@ -101,6 +105,30 @@ extension FetchableRecord where Self: TableRecord {
         try filter(keys: keys).fetchCursor(db)
     }
     
+    /// Returns a cursor over records, given their primary keys.
+    ///
+    ///     let players = try Player.fetchChunkedCursor(db, keys: ids) // Cursor of Player
+    ///     while let player = try players.next() { // Player
+    ///         ...
+    ///     }
+    ///
+    /// Unlike `fetchCursor(_:keys:)`, keys are split in chunks that do not
+    /// exceed `Database.maximumStatementArgumentCount`. Each chunk is fetched
+    /// when the cursor reaches it.
+    ///
+    /// Records are iterated in unspecified order.
+    ///
+    /// - parameters:
+    ///     - db: A database connection.
+    ///     - keys: A sequence of primary keys.
+    /// - returns: A cursor over fetched records.
+    public static func fetchChunkedCursor<Sequence>(_ db: Database, keys: Sequence)
+    -> AnyCursor<Self>
+    where Sequence: Swift.Sequence, Sequence.Element: DatabaseValueConvertible
+    {
+        fetchCursor(db, chunks: chunks(db, keys: Array(keys))) { self.filter(keys: $0) }
+    }
+    
     /// Returns an array of records, given their primary keys.
     ///
     ///     let players = try Player.fetchAll(db, keys: [1, 2, 3]) // [Player]
@@ -121,7 +149,7 @@ extension FetchableRecord where Self: TableRecord {
             // Avoid hitting the database
             return []
         }
-        return try filter(keys: keys).fetchAll(db)
+        return try fetchAll(db, chunks: chunks(db, keys: keys)) { filter(keys: $0) }
     }
     
     /// Returns a single record given its primary key.
@@ -159,6 +187,10 @@ extension FetchableRecord where Self: TableRecord & Identifiable, ID: DatabaseVa
     ///
     /// Records are iterated in unspecified order.
     ///
+    /// The cursor is fed by a single statement, which can not contain more
+    /// ids than `Database.maximumStatementArgumentCount`. For large sets of
+    /// ids, use `fetchChunkedCursor(_:ids:)`.
+    ///
     /// - parameters:
     ///     - db: A database connection.
     ///     - ids: A collection of primary keys.
@@ -171,6 +203,30 @@ extension FetchableRecord where Self: TableRecord & Identifiable, ID: DatabaseVa
         try filter(ids: ids).fetchCursor(db)
     }
     
+    /// Returns a cursor over records, given their primary keys.
+    ///
+    ///     let players = try Player.fetchChunkedCursor(db, ids: ids) // Cursor of Player
+    ///     while let player = try players.next() { // Player
+    ///         ...
+    ///     }
+    ///
+    /// Unlike `fetchCursor(_:ids:)`, ids are split in chunks that do not
+    /// exceed `Database.maximumStatementArgumentCount`. Each chunk is fetched
+    /// when the cursor reaches it.
+    ///
+    /// Records are iterated in unspecified order.
+    ///
+    /// - parameters:
+    ///     - db: A database connection.
+    ///     - ids: A collection of primary keys.
+    /// - returns: A cursor over fetched records.
+    public static func fetchChunkedCursor<Collection>(_ db: Database, ids: Collection)
+    -> AnyCursor<Self>
+    where Collection: Swift.Collection, Collection.Element == ID
+    {
+        fetchCursor(db, chunks: chunks(db, keys: Array(ids))) { self.filter(ids: $0) }
+    }
+    
     /// Returns an array of records, given their primary keys.
     ///
     ///     let players = try Player.fetchAll(db, ids: [1, 2, 3]) // [Player]
@@ -190,7 +246,7 @@ extension FetchableRecord where Self: TableRecord & Identifiable, ID: DatabaseVa
             // Avoid hitting the database
             return []
         }
-        return try filter(ids: ids).fetchAll(db)
+        return try fetchAll(db, chunks: chunks(db, keys: Array(ids))) { filter(ids: $0) }
     }
     
     /// Returns a single record given its primary key.
@@ -225,6 +281,10 @@ where Self: TableRecord & Identifiable,
     ///
     /// Records are iterated in unspecified order.
     ///
+    /// The cursor is fed by a single statement, which can not contain more
+    /// ids than `Database.maximumStatementArgumentCount`. For large sets of
+    /// ids, use `fetchChunkedCursor(_:ids:)`.
+    ///
     /// - parameters:
     ///     - db: A database connection.
     ///     - ids: A collection of primary keys.
@@ -237,6 +297,30 @@ where Self: TableRecord & Identifiable,
         try filter(ids: ids).fetchCursor(db)
     }
     
+    /// Returns a cursor over records, given their primary keys.
+    ///
+    ///     let players = try Player.fetchChunkedCursor(db, ids: ids) // Cursor of Player
+    ///     while let player = try players.next() { // Player
+    ///         ...
+    ///     }
+    ///
+    /// Unlike `fetchCursor(_:ids:)`, ids are split in chunks that do not
+    /// exceed `Database.maximumStatementArgumentCount`. Each chunk is fetched
+    /// when the cursor reaches it.
+    ///
+    /// Records are iterated in unspecified order.
+    ///
+    /// - parameters:
+    ///     - db: A database connection.
+    ///     - ids: A collection of primary keys.
+    /// - returns: A cursor over fetched records.
+    public static func fetchChunkedCursor<Collection>(_ db: Database, ids: Collection)
+    -> AnyCursor<Self>
+    where Collection: Swift.Collection, Collection.Element == ID.Wrapped
+    {
+        fetchCursor(db, chunks: chunks(db, keys: Array(ids))) { self.filter(ids: $0) }
+    }
+    
     /// Returns an array of records, given their primary keys.
     ///
     ///     let players = try Player.fetchAll(db, ids: [1, 2, 3]) // [Player]
@@ -256,7 +340,7 @@ where Self: TableRecord & Identifiable,
             // Avoid hitting the database
             return []
         }
-        return try filter(ids: ids).fetchAll(db)
+        return try fetchAll(db, chunks: chunks(db, keys: Array(ids))) { filter(ids: $0) }
     }
     
     /// Returns a single record given its primary key.
@@ -292,7 +376,7 @@ extension FetchableRecord where Self: TableRecord & Hashable {
             // Avoid hitting the database
             return []
         }
-        return try filter(keys: keys).fetchSet(db)
+        return try fetchSet(db, chunks: chunks(db, keys: keys)) { filter(keys: $0) }
     }
 }
 
@@ -315,7 +399,7 @@ extension FetchableRecord where Self: TableRecord & Hashable & Identifiable, ID:
             // Avoid hitting the database
             return []
         }
-        return try filter(ids: ids).fetchSet(db)
+        return try fetchSet(db, chunks: chunks(db, keys: Array(ids))) { filter(ids: $0) }
     }
 }
 
@@ -342,7 +426,7 @@ where Self: TableRecord & Hashable & Identifiable,
             // Avoid hitting the database
             return []
         }
-        return try filter(ids: ids).fetchSet(db)
+        return try fetchSet(db, chunks: chunks(db, keys: Array(ids))) { filter(ids: $0) }
     }
 }
 
@@ -363,6 +447,10 @@ extension FetchableRecord where Self: TableRecord {
     ///
     /// Records are iterated in unspecified order.
     ///
+    /// The cursor is fed by a single statement, which can not contain more
+    /// values than `Database.maximumStatementArgumentCount`. For large sets
+    /// of keys, use `fetchChunkedCursor(_:keys:)`.
+    ///
     /// - parameters:
     ///     - db: A database connection.
     ///     - keys: An array of key dictionaries.
@@ -374,6 +462,33 @@ extension FetchableRecord where Self: TableRecord {
         try filter(keys: keys).fetchCursor(db)
     }
     
+    /// Returns a cursor over records identified by the provided unique keys
+    /// (primary key or any key with a unique index on it).
+    ///
+    ///     // Cursor of Player
+    ///     let players = try Player.fetchChunkedCursor(db, keys: [
+    ///         ["email": "a@example.com"],
+    ///         ["email": "b@example.com"]])
+    ///     while let player = try players.next() { // Player
+    ///         ...
+    ///     }
+    ///
+    /// Unlike `fetchCursor(_:keys:)`, keys are split in chunks that do not
+    /// exceed `Database.maximumStatementArgumentCount`, or the maximum depth
+    /// of SQL expressions. Each chunk is fetched when the cursor reaches it.
+    ///
+    /// Records are iterated in unspecified order.
+    ///
+    /// - parameters:
+    ///     - db: A database connection.
+    ///     - keys: An array of key dictionaries.
+    /// - returns: A cursor over fetched records.
+    public static func fetchChunkedCursor(_ db: Database, keys: [[String: DatabaseValueConvertible?]])
+    -> AnyCursor<Self>
+    {
+        fetchCursor(db, chunks: chunks(db, keys: keys)) { self.filter(keys: Array($0)) }
+    }
+    
     /// Returns an array of records identified by the provided unique keys
     /// (primary key or any key with a unique index on it).
     ///
@@ -394,7 +509,7 @@ extension FetchableRecord where Self: TableRecord {
             // Avoid hitting the database
             return []
         }
-        return try filter(keys: keys).fetchAll(db)
+        return try fetchAll(db, chunks: chunks(db, keys: keys)) { filter(keys: Array($0)) }
     }
     
     /// Returns a single record identified by a unique key (the primary key or
@@ -435,6 +550,57 @@ extension FetchableRecord where Self: TableRecord & Hashable {
             // Avoid hitting the database
             return []
         }
-        return try filter(keys: keys).fetchSet(db)
+        return try fetchSet(db, chunks: chunks(db, keys: keys)) { filter(keys: Array($0)) }
+    }
+}
+
+// MARK: - Fetching by Chunks of Keys
+
+extension FetchableRecord where Self: TableRecord {
+    /// Returns a cursor that iterates the requests of all chunks, one
+    /// after the other. Each request is executed when the cursor reaches it.
+    static func fetchCursor<Chunk>(
+        _ db: Database,
+        chunks: [Chunk],
+        _ request: @escaping (Chunk) -> QueryInterfaceRequest<Self>)
+    -> AnyCursor<Self>
+    {
+        AnyCursor(AnyCursor(chunks).flatMap { try request($0).fetchCursor(db) })
+    }
+    
+    /// Returns the records fetched by the requests of all chunks.
+    static func fetchAll<Chunk>(
+        _ db: Database,
+        chunks: [Chunk],
+        _ request: (Chunk) -> QueryInterfaceRequest<Self>)
+    throws -> [Self]
+    {
+        if chunks.count == 1 {
+            return try request(chunks[0]).fetchAll(db)
+        }
+        var records: [Self] = []
+        for chunk in chunks {
+            try records.append(contentsOf: request(chunk).fetchAll(db))
+        }
+        return records
+    }
+}
+
+extension FetchableRecord where Self: TableRecord & Hashable {
+    /// Returns the records fetched by the requests of all chunks.
+    static func fetchSet<Chunk>(
+        _ db: Database,
+        chunks: [Chunk],
+        _ request: (Chunk) -> QueryInterfaceRequest<Self>)
+    throws -> Set<Self>
+    {
+        if chunks.count == 1 {
+            return try request(chunks[0]).fetchSet(db)
+        }
+        var records = Set<Self>()
+        for chunk in chunks {
+            try records.formUnion(request(chunk).fetchSet(db))
+        }
+        return records
     }
 }
@@ -27,6 +27,29 @@ public protocol FetchableRecord {
     /// make sure to store a copy: `self.row = row.copy()`.
     init(row: Row)
     
+    /// Updates the record in place from `row`.
+    ///
+    /// This method is called by `RecordCursor.forEach(into:_:)`, which
+    /// reuses a single record during the iteration of a fetch query.
+    ///
+    /// The default implementation assigns `Self(row: row)` to self. You can
+    /// provide a faster implementation that updates properties in place:
+    ///
+    ///     struct Player: FetchableRecord {
+    ///         var id: Int64
+    ///         var score: Int
+    ///
+    ///         mutating func decode(from row: Row) {
+    ///             id = row["id"]
+    ///             score = row["score"]
+    ///         }
+    ///     }
+    ///
+    /// For performance reasons, the row argument may be reused during the
+    /// iteration of a fetch query. If you want to keep the row for later use,
+    /// make sure to store a copy: `self.row = row.copy()`.
+    mutating func decode(from row: Row)
+    
     // MARK: - Customizing the Format of Database Columns
     
     /// When the FetchableRecord type also adopts the standard Decodable
@@ -106,6 +129,12 @@ public protocol FetchableRecord {
 }
 
 extension FetchableRecord {
+    /// Assigns `Self(row: row)` to self.
+    @inlinable
+    public mutating func decode(from row: Row) {
+        self = Self(row: row)
+    }
+    
     public static var databaseDecodingUserInfo: [CodingUserInfoKey: Any] {
         [:]
     }
@@ -446,6 +475,32 @@ extension FetchRequest where RowDecoder: FetchableRecord {
         try RowDecoder.fetchCursor(db, self)
     }
     
+    /// Calls the given closure on each fetched record, after `record` has
+    /// been updated in place with `FetchableRecord.decode(from:)`.
+    ///
+    ///     let request: ... // Some FetchRequest that fetches Player
+    ///     var player = Player(id: 0, score: 0)
+    ///     try request.forEach(db, into: &player) { player in
+    ///         ...
+    ///     }
+    ///
+    /// See `RecordCursor.forEach(into:_:)`.
+    ///
+    /// - parameters:
+    ///     - db: A database connection.
+    ///     - record: The record that is updated with each fetched row.
+    ///     - body: A closure that is called with each fetched record.
+    /// - throws: A DatabaseError is thrown whenever an SQLite error occurs,
+    ///   or the error thrown by `body`.
+    public func forEach(
+        _ db: Database,
+        into record: inout RowDecoder,
+        _ body: (RowDecoder) throws -> Void)
+    throws
+    {
+        try fetchCursor(db).forEach(into: &record, body)
+    }
+    
     /// An array of fetched records.
     ///
     ///     let request: ... // Some FetchRequest that fetches Player
@@ -532,6 +587,43 @@ public final class RecordCursor<Record: FetchableRecord>: Cursor {
             try _statement.didFail(withResultCode: code)
         }
     }
+    
+    /// Calls the given closure on each remaining record of the cursor, after
+    /// `record` has been updated in place with
+    /// `FetchableRecord.decode(from:)`.
+    ///
+    /// Unlike `next()`, this method does not create one record per fetched
+    /// row. This makes it suitable for streaming many rows:
+    ///
+    ///     var player = Player(id: 0, score: 0)
+    ///     let players = try Player.fetchCursor(db)
+    ///     try players.forEach(into: &player) { player in
+    ///         ...
+    ///     }
+    ///
+    /// Rows are adapted by the row adapter of the cursor, and records can
+    /// decode associated records from row scopes.
+    ///
+    /// - parameters:
+    ///     - record: The record that is updated with each fetched row. After
+    ///       the iteration, it contains the last fetched record.
+    ///     - body: A closure that is called with each fetched record.
+    /// - throws: A DatabaseError is thrown whenever an SQLite error occurs,
+    ///   or the error thrown by `body`.
+    @inlinable
+    public func forEach(into record: inout Record, _ body: (Record) throws -> Void) throws {
+        while !_done {
+            switch sqlite3_step(_sqliteStatement) {
+            case SQLITE_DONE:
+                _done = true
+            case SQLITE_ROW:
+                record.decode(from: _row)
+                try body(record)
+            case let code:
+                try _statement.didFail(withResultCode: code)
+            }
+        }
+    }
 }
 
 // MARK: - DatabaseDateDecodingStrategy
@@ -606,7 +606,7 @@ extension MutablePersistableRecord {
             // Avoid hitting the database
             return 0
         }
-        return try filter(keys: keys).deleteAll(db)
+        return try deleteAll(db, chunks: chunks(db, keys: keys)) { filter(keys: $0) }
     }
     
     /// Delete a record, identified by its primary key; returns whether a
@@ -674,7 +674,7 @@ extension MutablePersistableRecord where Self: Identifiable, ID: DatabaseValueCo
             // Avoid hitting the database
             return 0
         }
-        return try filter(ids: ids).deleteAll(db)
+        return try deleteAll(db, chunks: chunks(db, keys: Array(ids))) { filter(ids: $0) }
     }
     
     /// Delete a record, identified by its primary key; returns whether a
@@ -738,7 +738,7 @@ where Self: Identifiable,
             // Avoid hitting the database
             return 0
         }
-        return try filter(ids: ids).deleteAll(db)
+        return try deleteAll(db, chunks: chunks(db, keys: Array(ids))) { filter(ids: $0) }
     }
     
     /// Delete a record, identified by its primary key; returns whether a
@@ -785,7 +785,7 @@ extension MutablePersistableRecord {
             // Avoid hitting the database
             return 0
         }
-        return try filter(keys: keys).deleteAll(db)
+        return try deleteAll(db, chunks: chunks(db, keys: keys)) { filter(keys: Array($0)) }
     }
     
     /// Delete a record, identified by a unique key (the primary key or any key
@@ -803,6 +803,31 @@ extension MutablePersistableRecord {
     }
 }
 
+extension MutablePersistableRecord {
+    /// Deletes the records selected by the requests of all chunks; returns
+    /// the number of deleted rows.
+    ///
+    /// Several chunks are deleted atomically.
+    static func deleteAll<Chunk>(
+        _ db: Database,
+        chunks: [Chunk],
+        _ request: (Chunk) -> QueryInterfaceRequest<Self>)
+    throws -> Int
+    {
+        if chunks.count == 1 {
+            return try request(chunks[0]).deleteAll(db)
+        }
+        var deletedCount = 0
+        try db.inSavepoint {
+            for chunk in chunks {
+                deletedCount += try request(chunk).deleteAll(db)
+            }
+            return .commit
+        }
+        return deletedCount
+    }
+}
+
 // MARK: - PersistableRecord
 
 /// Types that adopt `PersistableRecord` can be inserted, updated, and deleted.
@@ -937,6 +962,151 @@ extension PersistableRecord {
     }
 }
 
+// MARK: - Batch Insertion
+
+extension PersistableRecord {
+    /// Inserts records with multi-row INSERT statements.
+    ///
+    ///     let players: [Player] = ...
+    ///     try Player.insertAll(db, players)
+    ///     // INSERT INTO player (id, name) VALUES (?, ?), (?, ?), ...
+    ///
+    /// Records are inserted by batches of `batchSize` rows. A batch may contain
+    /// fewer rows, so that its number of arguments does not exceed the
+    /// `SQLITE_LIMIT_VARIABLE_NUMBER` limit (see https://www.sqlite.org/limits.html).
+    ///
+    /// Records that encode different columns are inserted in distinct batches.
+    ///
+    /// Unlike `insert(_:)`, this method does not call `didInsert(with:for:)`,
+    /// because multi-row insertions do not tell the rowid of individual rows.
+    /// Custom implementations of `insert(_:)` are not called either.
+    ///
+    /// For best performance, run this method inside a transaction.
+    ///
+    /// - parameter db: A database connection.
+    /// - parameter records: A sequence of records.
+    /// - parameter conflictResolution: The conflict resolution of the INSERT
+    ///   statements. If nil, the `persistenceConflictPolicy` of the record type
+    ///   is used. Use `.replace` in order to insert or replace records.
+    /// - parameter batchSize: The maximum number of rows inserted by a
+    ///   single statement. If nil, batches are only limited by the maximum
+    ///   number of statement arguments.
+    /// - throws: A DatabaseError whenever an SQLite error occurs.
+    public static func insertAll<Records>(
+        _ db: Database,
+        _ records: Records,
+        onConflict conflictResolution: Database.ConflictResolution? = nil,
+        batchSize: Int? = nil)
+    throws
+    where Records: Sequence, Records.Element == Self
+    {
+        if let batchSize = batchSize {
+            GRDBPrecondition(batchSize > 0, "Invalid batch size: \(batchSize)")
+        }
+        var batch = InsertBatch(
+            db,
+            tableName: databaseTableName,
+            onConflict: conflictResolution ?? persistenceConflictPolicy.conflictResolutionForInsert,
+            maximumRowCount: batchSize)
+        let columnCount = try db.columns(in: databaseTableName).count
+        for record in records {
+            var container = PersistenceContainer(minimumCapacity: columnCount)
+            record.encode(to: &container)
+            GRDBPrecondition(!container.isEmpty, "\(Self.self): invalid empty persistence container")
+            try batch.append(container)
+        }
+        try batch.flush()
+    }
+}
+
+/// InsertBatch accumulates persistence containers, and inserts them with
+/// multi-row INSERT statements.
+private struct InsertBatch {
+    let db: Database
+    let tableName: String
+    let onConflict: Database.ConflictResolution
+    let maximumRowCount: Int?
+    let maximumArgumentCount: Int
+    
+    /// The columns of pending containers
+    private var columns: [String] = []
+    
+    /// Pending containers. They all have the same columns, in the same order.
+    private var containers: [PersistenceContainer] = []
+    
+    /// The number of rows of a full batch, given the current columns
+    private var batchRowCount = 0
+    
+    /// The SQL of a full batch, given the current columns
+    private var batchSQL = ""
+    
+    init(
+        _ db: Database,
+        tableName: String,
+        onConflict: Database.ConflictResolution,
+        maximumRowCount: Int?)
+    {
+        self.db = db
+        self.tableName = tableName
+        self.onConflict = onConflict
+        self.maximumRowCount = maximumRowCount
+        self.maximumArgumentCount = db.maximumStatementArgumentCount
+    }
+    
+    mutating func append(_ container: PersistenceContainer) throws {
+        let containerColumns = container.columns
+        if containerColumns != columns {
+            try flush()
+            columns = containerColumns
+            batchRowCount = max(1, maximumArgumentCount / columns.count)
+            if let maximumRowCount = maximumRowCount {
+                batchRowCount = min(batchRowCount, maximumRowCount)
+            }
+            batchSQL = insertQuery.sql(rowCount: batchRowCount)
+            containers.reserveCapacity(batchRowCount)
+        }
+        
+        containers.append(container)
+        if containers.count == batchRowCount {
+            try flush()
+        }
+    }
+    
+    mutating func flush() throws {
+        if containers.isEmpty {
+            return
+        }
+        
+        let statement: UpdateStatement
+        if containers.count == batchRowCount {
+            // Full batches are reused
+            statement = try db.internalCachedUpdateStatement(sql: batchSQL)
+        } else {
+            // Don't pollute the statement cache with the last, incomplete, batch.
+            statement = try db.makeUpdateStatement(sql: insertQuery.sql(rowCount: containers.count))
+        }
+        
+        // Bind values directly, without building any intermediate
+        // StatementArguments.
+        statement.resetBindings()
+        var index: CInt = 1
+        for container in containers {
+            for column in columns {
+                let value = container.storage[column] ?? nil
+                statement.bind(value?.databaseValue ?? .null, at: index)
+                index += 1
+            }
+        }
+        
+        containers.removeAll(keepingCapacity: true)
+        try statement.execute()
+    }
+    
+    private var insertQuery: InsertQuery {
+        InsertQuery(onConflict: onConflict, tableName: tableName, insertedColumns: columns)
+    }
+}
+
 // MARK: - DAO
 
 extension PersistenceContainer {
@@ -1103,24 +1273,29 @@ extension InsertQuery {
         if let sql = Self.sqlCache[self] {
             return sql
         }
+        let sql = self.sql(rowCount: 1)
+        Self.sqlCache[self] = sql
+        return sql
+    }
+    
+    /// Returns the (uncached) SQL that inserts `rowCount` rows.
+    func sql(rowCount: Int) -> String {
         let columnsSQL = insertedColumns.map(\.quotedDatabaseIdentifier).joined(separator: ", ")
-        let valuesSQL = databaseQuestionMarks(count: insertedColumns.count)
-        let sql: String
+        let rowSQL = "(\(databaseQuestionMarks(count: insertedColumns.count)))"
+        let valuesSQL = repeatElement(rowSQL, count: rowCount).joined(separator: ", ")
         switch onConflict {
         case .abort:
-            sql = """
+            return """
             INSERT INTO \(tableName.quotedDatabaseIdentifier) (\(columnsSQL)) \
-            VALUES (\(valuesSQL))
+            VALUES \(valuesSQL)
             """
         default:
-            sql = """
+            return """
             INSERT OR \(onConflict.rawValue) \
             INTO \(tableName.quotedDatabaseIdentifier) (\(columnsSQL)) \
-            VALUES (\(valuesSQL))
+            VALUES \(valuesSQL)
             """
         }
-        Self.sqlCache[self] = sql
-        return sql
     }
 }
 
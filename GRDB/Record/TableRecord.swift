@@ -140,6 +140,67 @@ extension TableRecord {
     }
 }
 
+extension TableRecord {
+    
+    // MARK: - Key Chunks
+    
+    /// Splits unique primary keys in chunks that can be looked up by a single
+    /// `filter(keys:)` request, without exceeding the maximum number of
+    /// statement arguments.
+    ///
+    /// Duplicate keys are removed, so that records are not fetched twice
+    /// when the duplicates belong to distinct chunks.
+    static func chunks<Key>(_ db: Database, keys: [Key]) -> [ArraySlice<Key>]
+    where Key: DatabaseValueConvertible
+    {
+        var knownValues = Set<DatabaseValue>()
+        let keys = keys.filter { knownValues.insert($0.databaseValue).inserted }
+        let chunkSize = max(1, db.maximumStatementArgumentCount)
+        return stride(from: 0, to: keys.count, by: chunkSize).map {
+            keys[$0..<min($0 + chunkSize, keys.count)]
+        }
+    }
+    
+    /// Splits unique keys in chunks that can be looked up by a single
+    /// `filter(keys:)` request, without exceeding the maximum number of
+    /// statement arguments, or the maximum depth of the
+    /// `key1 OR key2 OR ...` expression.
+    ///
+    /// Duplicate keys are removed, so that records are not fetched twice
+    /// when the duplicates belong to distinct chunks.
+    static func chunks(_ db: Database, keys: [[String: DatabaseValueConvertible?]])
+    -> [ArraySlice<[String: DatabaseValueConvertible?]>]
+    {
+        var knownKeys = Set<[String: DatabaseValue]>()
+        let keys = keys.filter { key in
+            knownKeys.insert(key.mapValues { $0?.databaseValue ?? .null }).inserted
+        }
+        let maximumArgumentCount = max(1, db.maximumStatementArgumentCount)
+        // Leave room for the AND expressions of composite keys
+        let maximumKeyCount = db.maximumExpressionDepth.map { max(1, $0 / 2) } ?? Int.max
+        var chunks: [ArraySlice<[String: DatabaseValueConvertible?]>] = []
+        var chunkStart = 0
+        var argumentCount = 0
+        for (index, key) in keys.enumerated() {
+            // Nil values are tested with `IS NULL`, without any argument.
+            let keyArgumentCount = key.values.countElements(where: { $0 != nil })
+            if index > chunkStart
+                && (argumentCount + keyArgumentCount > maximumArgumentCount
+                        || index - chunkStart >= maximumKeyCount)
+            {
+                chunks.append(keys[chunkStart..<index])
+                chunkStart = index
+                argumentCount = 0
+            }
+            argumentCount += keyArgumentCount
+        }
+        if chunkStart < keys.count {
+            chunks.append(keys[chunkStart...])
+        }
+        return chunks
+    }
+}
+
 /// Calculating `defaultDatabaseTableName` is somewhat expensive due to the regular expression evaluation
 ///
 /// This cache mitigates the cost of the calculation by storing the name for later retrieval
@@ -1,4 +1,4 @@
-import Dispatch
+import Foundation
 
 /// A Pool maintains a set of elements that are built them on demand. A pool has
 /// a maximum number of elements.
@@ -35,26 +35,100 @@ import Dispatch
 ///     got 2
 ///     got 1
 ///     got 3
+///
+/// When the pool is given an idle timeout, available elements that have not
+/// been used for this duration are removed from the pool.
 final class Pool<T> {
     private class Item {
         let element: T
         var isAvailable: Bool
         
+        /// The last time the item was made available
+        var releaseTime: DispatchTime
+        
         init(element: T, isAvailable: Bool) {
             self.element = element
             self.isAvailable = isAvailable
+            self.releaseTime = .now()
         }
     }
     
+    /// Statistics about the pool usage.
+    struct Statistics {
+        /// The number of elements in the pool
+        var elementCount = 0
+        
+        /// The number of elements currently used
+        var usedElementCount = 0
+        
+        /// The number of get() and asyncGet() calls currently waiting for an
+        /// available element
+        var waitingCount = 0
+        
+        /// The number of successful get() and asyncGet() calls
+        var acquisitionCount = 0
+        
+        /// The number of get() and asyncGet() calls that had to wait for an
+        /// available element
+        var waitCount = 0
+        
+        /// The total time spent waiting for an available element
+        var totalWaitDuration: TimeInterval = 0
+        
+        /// The longest time spent waiting for an available element
+        var maximumWaitDuration: TimeInterval = 0
+        
+        /// The number of elements removed because they were idle
+        var idleRemovalCount = 0
+    }
+    
+    private struct State {
+        var items: [Item] = []
+        
+        /// asyncGet() calls waiting for an available element
+        var waiters: [() -> Void] = []
+        
+        var statistics = Statistics()
+        var isIdleRemovalScheduled = false
+    }
+    
     private let makeElement: () throws -> T
-    @ReadWriteBox private var items: [Item] = []
+    private let idleTimeout: TimeInterval?
+    @ReadWriteBox private var state = State()
     private let itemsSemaphore: DispatchSemaphore // limits the number of elements
     private let itemsGroup: DispatchGroup         // knows when no element is used
     private let barrierQueue: DispatchQueue
     
-    init(maximumCount: Int, makeElement: @escaping () throws -> T) {
+    /// Statistics about the pool usage.
+    var statistics: Statistics {
+        $state.read { state in
+            var statistics = state.statistics
+            statistics.elementCount = state.items.count
+            return statistics
+        }
+    }
+    
+    /// True if no element is currently used. This property does not block.
+    var isIdle: Bool {
+        itemsGroup.wait(timeout: .now()) == .success
+    }
+    
+    /// Creates a pool.
+    ///
+    /// - parameters:
+    ///     - maximumCount: The maximum number of elements.
+    ///     - idleTimeout: If not nil, available elements are removed from
+    ///       the pool when they are not used for this duration.
+    ///     - makeElement: A function that builds a new element.
+    init(
+        maximumCount: Int,
+        idleTimeout: TimeInterval? = nil,
+        makeElement: @escaping () throws -> T)
+    {
         GRDBPrecondition(maximumCount > 0, "Pool size must be at least 1")
+        GRDBPrecondition(idleTimeout.map { $0 >= 0 } ?? true, "Pool idle timeout must not be negative")
         self.makeElement = makeElement
+        self.idleTimeout = idleTimeout
         self.itemsSemaphore = DispatchSemaphore(value: maximumCount)
         self.itemsGroup = DispatchGroup()
         self.barrierQueue = DispatchQueue(label: "GRDB.Pool.barrier", attributes: [.concurrent])
@@ -64,26 +138,24 @@ final class Pool<T> {
     /// Client must call release(), only once, after the element has been used.
     func get() throws -> (element: T, release: () -> Void) {
         try barrierQueue.sync {
-            itemsSemaphore.wait()
+            waitForAvailableElement()
             itemsGroup.enter()
-            do {
-                let item = try $items.update { items -> Item in
-                    if let item = items.first(where: \.isAvailable) {
-                        item.isAvailable = false
-                        return item
-                    } else {
-                        let element = try makeElement()
-                        let item = Item(element: element, isAvailable: false)
-                        items.append(item)
-                        return item
-                    }
-                }
-                return (element: item.element, release: { self.release(item) })
-            } catch {
-                itemsSemaphore.signal()
-                itemsGroup.leave()
-                throw error
+            return try acquireItem()
+        }
+    }
+    
+    /// Returns a tuple (element, release), or nil if the maximum number of
+    /// elements is reached and no element is available. This method does
+    /// not block.
+    ///
+    /// Client must call release(), only once, after the element has been used.
+    func tryGet() throws -> (element: T, release: () -> Void)? {
+        try barrierQueue.sync {
+            guard itemsSemaphore.wait(timeout: .now()) == .success else {
+                return nil
             }
+            itemsGroup.enter()
+            return try acquireItem()
         }
     }
     
@@ -95,30 +167,223 @@ final class Pool<T> {
         return try block(element)
     }
     
-    private func release(_ item: Item) {
-        $items.update { _ in
+    /// Asynchronously calls `completion` with a tuple (element, release).
+    /// Client must call release(), only once, after the element has been used.
+    ///
+    /// Unlike get(), this method does not block any thread when the maximum
+    /// number of elements is reached: `completion` is called when an element
+    /// is released. Asynchronous waits are served before threads blocked
+    /// in get().
+    func asyncGet(_ completion: @escaping (Result<(element: T, release: () -> Void), Error>) -> Void) {
+        barrierQueue.async {
+            let acquire = { completion(Result { try self.acquireItem() }) }
+            let isAvailable = self.$state.update { state -> Bool in
+                if self.itemsSemaphore.wait(timeout: .now()) == .success {
+                    return true
+                }
+                state.statistics.waitingCount += 1
+                let start = DispatchTime.now()
+                state.waiters.append {
+                    self.recordWait(since: start)
+                    acquire()
+                }
+                return false
+            }
+            if isAvailable {
+                self.itemsGroup.enter()
+                acquire()
+            }
+        }
+    }
+    
+    /// Returns an element, once the caller has acquired the semaphore and
+    /// entered the item group.
+    private func acquireItem() throws -> (element: T, release: () -> Void) {
+        do {
+            let availableItem = $state.update { state -> Item? in
+                guard let item = state.items.first(where: \.isAvailable) else {
+                    return nil
+                }
+                item.isAvailable = false
+                state.statistics.acquisitionCount += 1
+                state.statistics.usedElementCount += 1
+                return item
+            }
+            if let item = availableItem {
+                return (element: item.element, release: { self.release(item) })
+            }
+            
+            // Build the new element outside of the lock, so that several
+            // elements can be built concurrently. The semaphore guarantees
+            // that the maximum number of elements is not exceeded.
+            let item = try Item(element: makeElement(), isAvailable: false)
+            $state.update { state in
+                state.items.append(item)
+                state.statistics.acquisitionCount += 1
+                state.statistics.usedElementCount += 1
+            }
+            return (element: item.element, release: { self.release(item) })
+        } catch {
+            releasePermit()
+            throw error
+        }
+    }
+    
+    /// Waits until the semaphore allows one more element to be used. Waits
+    /// are recorded in statistics.
+    private func waitForAvailableElement() {
+        if itemsSemaphore.wait(timeout: .now()) == .success {
+            return
+        }
+        
+        // Slow path: record the wait
+        $state.update { $0.statistics.waitingCount += 1 }
+        let start = DispatchTime.now()
+        itemsSemaphore.wait()
+        recordWait(since: start)
+    }
+    
+    private func recordWait(since start: DispatchTime) {
+        let duration = TimeInterval(DispatchTime.now().uptimeNanoseconds - start.uptimeNanoseconds) / 1.0e9
+        $state.update { state in
+            state.statistics.waitingCount -= 1
+            state.statistics.waitCount += 1
+            state.statistics.totalWaitDuration += duration
+            state.statistics.maximumWaitDuration = max(state.statistics.maximumWaitDuration, duration)
+        }
+    }
+    
+    private func release(_ item: Item, updatesReleaseTime: Bool = true) {
+        var schedulesIdleRemoval = false
+        releasePermit { state in
             // This is why Item is a class, not a struct: so that we can
             // release it without having to find in it the items array.
             item.isAvailable = true
+            if updatesReleaseTime {
+                item.releaseTime = .now()
+            }
+            state.statistics.usedElementCount -= 1
+            if idleTimeout != nil && !state.isIdleRemovalScheduled {
+                state.isIdleRemovalScheduled = true
+                schedulesIdleRemoval = true
+            }
+        }
+        if schedulesIdleRemoval, let idleTimeout = idleTimeout {
+            scheduleIdleRemoval(deadline: .now() + idleTimeout)
+        }
+    }
+    
+    /// Hands the permit of an element over to the oldest asyncGet() waiter,
+    /// or signals the semaphore if there is none.
+    private func releasePermit(updating update: (inout State) -> Void = { _ in }) {
+        let waiter = $state.update { state -> (() -> Void)? in
+            update(&state)
+            if state.waiters.isEmpty {
+                itemsSemaphore.signal()
+                return nil
+            }
+            return state.waiters.removeFirst()
+        }
+        if let waiter = waiter {
+            // The waiter inherits both the semaphore and the item group.
+            waiter()
+        } else {
+            itemsGroup.leave()
+        }
+    }
+    
+    private func scheduleIdleRemoval(deadline: DispatchTime) {
+        DispatchQueue.global(qos: .utility).asyncAfter(deadline: deadline) { [weak self] in
+            self?.removeIdleElements()
+        }
+    }
+    
+    /// Removes available elements that have not been used for the
+    /// idle timeout, and schedules the next removal if needed.
+    private func removeIdleElements() {
+        guard let idleTimeout = idleTimeout else { return }
+        let now = DispatchTime.now()
+        // Removed elements are returned, so that they are deallocated outside
+        // of the lock.
+        let (_, nextDeadline) = $state.update { state -> ([Item], DispatchTime?) in
+            func isIdle(_ item: Item) -> Bool {
+                item.isAvailable && item.releaseTime + idleTimeout <= now
+            }
+            let removedItems = state.items.filter(isIdle)
+            state.items.removeAll(where: isIdle)
+            state.statistics.idleRemovalCount += removedItems.count
+            
+            // Schedule next removal after the oldest remaining available
+            // item. Used items schedule a removal when they are released.
+            let nextDeadline = state.items
+                .filter(\.isAvailable)
+                .map { $0.releaseTime + idleTimeout }
+                .min()
+            state.isIdleRemovalScheduled = (nextDeadline != nil)
+            return (removedItems, nextDeadline)
+        }
+        
+        if let nextDeadline = nextDeadline {
+            scheduleIdleRemoval(deadline: nextDeadline)
         }
-        itemsSemaphore.signal()
-        itemsGroup.leave()
     }
     
     /// Performs a block on each pool element, available or not.
     /// The block is run is some arbitrary dispatch queue.
     func forEach(_ body: (T) throws -> Void) rethrows {
-        try $items.read { items in
-            for item in items {
+        try $state.read { state in
+            for item in state.items {
                 try body(item.element)
             }
         }
     }
     
+    /// Performs a block on each available element. Used elements are
+    /// skipped. During the block execution, the element is not available.
+    ///
+    /// Unlike `get()`, this method does not block, and does not make the
+    /// elements look recently used to the idle timeout.
+    func forEachAvailableElement(_ body: (T) throws -> Void) rethrows {
+        let items = barrierQueue.sync {
+            $state.update { state -> [Item] in
+                var items: [Item] = []
+                for item in state.items where item.isAvailable {
+                    guard itemsSemaphore.wait(timeout: .now()) == .success else {
+                        break
+                    }
+                    itemsGroup.enter()
+                    item.isAvailable = false
+                    state.statistics.usedElementCount += 1
+                    items.append(item)
+                }
+                return items
+            }
+        }
+        defer {
+            for item in items {
+                release(item, updatesReleaseTime: false)
+            }
+        }
+        for item in items {
+            try body(item.element)
+        }
+    }
+    
+    /// Removes the available elements from the pool.
+    func removeAvailableElements() {
+        // Removed elements are returned, so that they are deallocated outside
+        // of the lock.
+        _ = $state.update { state -> [Item] in
+            let removedItems = state.items.filter(\.isAvailable)
+            state.items.removeAll(where: \.isAvailable)
+            return removedItems
+        }
+    }
+    
     /// Removes all elements from the pool.
     /// Currently used elements won't be reused.
     func removeAll() {
-        items = []
+        $state.update { $0.items = [] }
     }
     
     /// Blocks until no element is used, and runs the `barrier` function before
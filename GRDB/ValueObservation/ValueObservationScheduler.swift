@@ -6,8 +6,15 @@ import Foundation
 public class ValueObservationScheduler {
     private let impl: ValueObservationSchedulerImpl
     
-    private init(impl: ValueObservationSchedulerImpl) {
+    /// The eventual coalescing policy of database changes.
+    let coalescingPolicy: ValueObservationCoalescingPolicy?
+    
+    private init(
+        impl: ValueObservationSchedulerImpl,
+        coalescingPolicy: ValueObservationCoalescingPolicy? = nil)
+    {
         self.impl = impl
+        self.coalescingPolicy = coalescingPolicy
     }
     
     func schedule(_ action: @escaping () -> Void) {
@@ -59,6 +66,79 @@ public class ValueObservationScheduler {
     /// - important: this scheduler requires that the observation is started
     ///  from the main queue. A fatal error is raised otherwise.
     public static let immediate = ValueObservationScheduler(impl: ImmediateImpl())
+    
+    /// Returns a scheduler which coalesces database changes according to
+    /// the given policy.
+    ///
+    /// Coalesced changes trigger a single fetch, and a single notification
+    /// of a fresh value. This reduces the amount of work performed by an
+    /// observation when many transactions are committed in a short
+    /// amount of time.
+    ///
+    /// For example, this observation notifies at most one value every
+    /// 10 milliseconds:
+    ///
+    ///     let cancellable = try observation.start(
+    ///         in: dbQueue,
+    ///         scheduling: .async(onQueue: .main).coalescing(.init(window: 0.01)),
+    ///         onError: { error in ... },
+    ///         onChange: { players: [Player] in
+    ///             print("fresh players: \(players)")
+    ///         })
+    ///
+    /// The initial value is not delayed.
+    public func coalescing(_ policy: ValueObservationCoalescingPolicy) -> ValueObservationScheduler {
+        ValueObservationScheduler(impl: impl, coalescingPolicy: policy)
+    }
+}
+
+/// The coalescing policy of database changes in a `ValueObservation`.
+///
+/// See `ValueObservationScheduler.coalescing(_:)`.
+public struct ValueObservationCoalescingPolicy {
+    /// The edge of the time window when fresh values are fetched.
+    public enum Edge {
+        /// The first change fetches a fresh value immediately, and opens a
+        /// time window. The changes performed during the window are fetched
+        /// once, at the end of the window, and open a new window.
+        case leading
+        
+        /// The first change opens a time window. All changes performed
+        /// during the window are fetched once, at the end of the window.
+        case trailing
+    }
+    
+    /// The duration of the time window, in seconds.
+    public var window: TimeInterval
+    
+    /// When not nil, a fresh value is fetched as soon as this number of
+    /// changes is pending, without waiting for the end of the time window.
+    public var maximumPendingChangeCount: Int?
+    
+    /// The edge of the time window when fresh values are fetched.
+    public var edge: Edge
+    
+    /// Creates a coalescing policy.
+    ///
+    /// - parameters:
+    ///     - window: The duration of the time window, in seconds.
+    ///     - maximumPendingChangeCount: When not nil, a fresh value is
+    ///       fetched as soon as this number of changes is pending.
+    ///     - edge: The edge of the time window when fresh values
+    ///       are fetched.
+    public init(
+        window: TimeInterval,
+        maximumPendingChangeCount: Int? = nil,
+        edge: Edge = .trailing)
+    {
+        GRDBPrecondition(window >= 0, "Invalid negative coalescing window")
+        GRDBPrecondition(
+            maximumPendingChangeCount.map { $0 > 0 } ?? true,
+            "Invalid maximumPendingChangeCount")
+        self.window = window
+        self.maximumPendingChangeCount = maximumPendingChangeCount
+        self.edge = edge
+    }
 }
 
 private protocol ValueObservationSchedulerImpl {
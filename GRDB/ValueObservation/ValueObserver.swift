@@ -5,7 +5,7 @@ import Foundation
 final class ValueObserver<Reducer: ValueReducer> {
     var isCompleted: Bool { synchronized { _isCompleted } }
     let events: ValueObservationEvents
-    private var observedRegion: DatabaseRegion? {
+    private(set) var observedRegion: DatabaseRegion? {
         didSet {
             if let willTrackRegion = events.willTrackRegion,
                let region = observedRegion,
@@ -22,6 +22,10 @@ final class ValueObserver<Reducer: ValueReducer> {
     private let scheduler: ValueObservationScheduler
     private let reduceQueue: DispatchQueue
     private var isChanged = false
+    /// Only accessed from the writer dispatch queue
+    private var coalescingState = CoalescingState()
+    /// Not nil for incremental observations
+    private let rowChangeTracker: RowChangeTracker?
     private let onChange: (Reducer.Value) -> Void
     private var lock = NSRecursiveLock() // protects _isCompleted
     
@@ -36,6 +40,7 @@ final class ValueObserver<Reducer: ValueReducer> {
     {
         self.events = events
         self.reducer = reducer
+        self.rowChangeTracker = (reducer as? IncrementalValueReducer)?.rowChangeTracker
         self.requiresWriteAccess = requiresWriteAccess
         self.writer = writer
         self.scheduler = scheduler
@@ -63,12 +68,16 @@ final class ValueObserver<Reducer: ValueReducer> {
 
 // MARK: - TransactionObserver
 
-extension ValueObserver: TransactionObserver {
+extension ValueObserver: DatabaseRegionTransactionObserver {
     func observes(eventsOfKind eventKind: DatabaseEventKind) -> Bool {
         assert(
             observedRegion != nil,
             "fetchInitialValue() was not called before ValueObserver was added as a transaction observer")
-        return observedRegion!.isModified(byEventsOfKind: eventKind)
+        if observedRegion!.isModified(byEventsOfKind: eventKind) {
+            rowChangeTracker?.statementWillModify(eventKind)
+            return true
+        }
+        return false
     }
     
     func databaseDidChange(with event: DatabaseEvent) {
@@ -77,6 +86,10 @@ extension ValueObserver: TransactionObserver {
             "fetchInitialValue() was not called before ValueObserver was added as a transaction observer")
         if observedRegion!.isModified(by: event) {
             isChanged = true
+            if rowChangeTracker?.track(event) == true {
+                // Keep on collecting the rowids of modified rows
+                return
+            }
             stopObservingDatabaseChangesUntilNextTransaction()
         }
     }
@@ -84,23 +97,60 @@ extension ValueObserver: TransactionObserver {
     func databaseDidCommit(_ db: Database) {
         guard isChanged else { return }
         isChanged = false
+        let modifiedRowIDs = rowChangeTracker?.databaseDidCommit()
         if isCompleted { return }
         
         events.databaseDidChange?()
         
+        if let policy = scheduler.coalescingPolicy {
+            coalesceChange(db, modifiedRowIDs: modifiedRowIDs, policy: policy)
+        } else {
+            fetchAndNotifyChanges(db, modifiedRowIDs: modifiedRowIDs)
+        }
+    }
+    
+    func databaseDidRollback(_ db: Database) {
+        isChanged = false
+        rowChangeTracker?.databaseDidRollback()
+    }
+}
+
+// MARK: - Fetching Changes
+
+extension ValueObserver {
+    /// Fetches and notifies a fresh value after changes have been committed.
+    ///
+    /// This method must be called from the writer dispatch queue, outside of
+    /// any transaction.
+    ///
+    /// - parameter modifiedRowIDs: The rowids of modified rows, for
+    ///   incremental observations, or nil for a full fetch.
+    private func fetchAndNotifyChanges(_ db: Database, modifiedRowIDs: Set<Int64>?) {
         // 1. Fetch
+        let fetch: (Database) throws -> Reducer.Fetched
+        if let modifiedRowIDs = modifiedRowIDs,
+           let reducer = reducer as? IncrementalValueReducer
+        {
+            // Only fetch modified rows
+            fetch = { db in
+                try reducer.fetchModifiedRows(db, rowIDs: modifiedRowIDs) as! Reducer.Fetched
+            }
+        } else {
+            fetch = reducer._fetch
+        }
+        
         let fetchedFuture: DatabaseFuture<Reducer.Fetched>
         if requiresWriteAccess || needsRecordingSelectedRegion {
             // Synchronously
             fetchedFuture = DatabaseFuture(Result {
                 try recordingSelectedRegionIfNeeded(db) {
-                    try reducer.fetch(db, requiringWriteAccess: requiresWriteAccess)
+                    try Reducer.fetch(db, requiringWriteAccess: requiresWriteAccess, using: fetch)
                 }
             })
         } else {
             // Concurrently
             guard let writer = writer else { return }
-            fetchedFuture = writer.concurrentRead(reducer._fetch)
+            fetchedFuture = writer.concurrentRead(fetch)
         }
         
         // 2. Reduce
@@ -121,9 +171,112 @@ extension ValueObserver: TransactionObserver {
             }
         }
     }
+}
+
+// MARK: - Coalescing Changes
+
+/// The state of the changes coalesced by a ValueObserver.
+private struct CoalescingState {
+    /// Identifies the current time window, so that the end of outdated
+    /// windows is ignored.
+    var windowID = 0
     
-    func databaseDidRollback(_ db: Database) {
-        isChanged = false
+    /// True during a time window
+    var isWindowOpen = false
+    
+    /// The number of changes that have not been fetched yet
+    var pendingChangeCount = 0
+    
+    /// The rowids modified by pending changes, or nil if a full fetch
+    /// is needed.
+    var pendingRowIDs: Set<Int64>? = []
+    
+    mutating func addChange(modifiedRowIDs: Set<Int64>?) {
+        if pendingChangeCount == 0 {
+            pendingRowIDs = modifiedRowIDs
+        } else if let rowIDs = modifiedRowIDs {
+            pendingRowIDs?.formUnion(rowIDs)
+        } else {
+            pendingRowIDs = nil
+        }
+        pendingChangeCount += 1
+    }
+    
+    /// Returns the rowids of pending changes, and forgets them.
+    mutating func removePendingChanges() -> Set<Int64>? {
+        defer {
+            pendingChangeCount = 0
+            pendingRowIDs = []
+        }
+        return pendingRowIDs
+    }
+}
+
+extension ValueObserver {
+    /// Coalesces committed changes according to the coalescing policy.
+    ///
+    /// This method must be called from the writer dispatch queue, outside of
+    /// any transaction.
+    private func coalesceChange(
+        _ db: Database,
+        modifiedRowIDs: Set<Int64>?,
+        policy: ValueObservationCoalescingPolicy)
+    {
+        if policy.edge == .leading && !coalescingState.isWindowOpen {
+            // Fetch now, and coalesce the following changes
+            openCoalescingWindow(policy: policy)
+            fetchAndNotifyChanges(db, modifiedRowIDs: modifiedRowIDs)
+            return
+        }
+        
+        coalescingState.addChange(modifiedRowIDs: modifiedRowIDs)
+        if !coalescingState.isWindowOpen {
+            openCoalescingWindow(policy: policy)
+        }
+        if let maximumCount = policy.maximumPendingChangeCount,
+           coalescingState.pendingChangeCount >= maximumCount
+        {
+            fetchPendingChanges(db, policy: policy)
+        }
+    }
+    
+    /// Fetches the pending changes, if any.
+    private func fetchPendingChanges(_ db: Database, policy: ValueObservationCoalescingPolicy) {
+        guard coalescingState.pendingChangeCount > 0 else {
+            closeCoalescingWindow()
+            return
+        }
+        let modifiedRowIDs = coalescingState.removePendingChanges()
+        switch policy.edge {
+        case .leading:
+            // Changes performed during the fetch are coalesced
+            openCoalescingWindow(policy: policy)
+        case .trailing:
+            closeCoalescingWindow()
+        }
+        fetchAndNotifyChanges(db, modifiedRowIDs: modifiedRowIDs)
+    }
+    
+    private func openCoalescingWindow(policy: ValueObservationCoalescingPolicy) {
+        coalescingState.windowID += 1
+        coalescingState.isWindowOpen = true
+        let windowID = coalescingState.windowID
+        DispatchQueue.global(qos: .userInitiated).asyncAfter(deadline: .now() + policy.window) { [weak self] in
+            guard let self = self, let writer = self.writer else { return }
+            writer.asyncWriteWithoutTransaction { db in
+                guard windowID == self.coalescingState.windowID, !self.isCompleted else {
+                    // Outdated window, or completed observation
+                    return
+                }
+                self.fetchPendingChanges(db, policy: policy)
+            }
+        }
+    }
+    
+    private func closeCoalescingWindow() {
+        // Ignore the end of the current window
+        coalescingState.windowID += 1
+        coalescingState.isWindowOpen = false
     }
 }
 
@@ -213,7 +366,12 @@ extension ValueObserver {
         
         var region = DatabaseRegion()
         let result = try db.recordingSelection(&region, fetch)
-        observedRegion = try region.observableRegion(db)
+        let observedRegion = try region.observableRegion(db)
+        if observedRegion != self.observedRegion {
+            self.observedRegion = observedRegion
+            // Observers are indexed by observed region
+            db.observationBroker.observedRegionDidChange()
+        }
         return result
     }
 }
@@ -0,0 +1,309 @@
+extension ValueObservation where Reducer == ValueReducers.Auto {
+    /// Creates a `ValueObservation` that notifies the records fetched by
+    /// `request` whenever a database transaction changes them.
+    ///
+    /// Unlike `ValueObservation.tracking(_:)`, this observation does not
+    /// refetch the whole request after each transaction: it only fetches the
+    /// rows that were inserted or updated, and removes deleted rows from the
+    /// notified value.
+    ///
+    /// For example:
+    ///
+    ///     let request = Player.filter(Column("score") > 1000)
+    ///     let observation = ValueObservation.trackingIncrementally(request)
+    ///
+    ///     let cancellable = try observation.start(
+    ///         in: dbQueue,
+    ///         onError: { error in ... },
+    ///         onChange: { (players: IncrementalRecords<Player>) in
+    ///             print("Players have changed: \(players.updatedRowIDs)")
+    ///         })
+    ///
+    /// The request must select the rows of a single table that has a rowid.
+    /// The ordering of the request is ignored. Requests that involve
+    /// associations, aggregates, limits, distinct rows, or common table
+    /// expressions can not be tracked by rowid: they are fully refetched after
+    /// each transaction. Transactions that modify the rowid of a row, or
+    /// other tables of the tracked region, or many rows, also trigger a
+    /// full refetch.
+    ///
+    /// SQLite does not notify the rows that are deleted by the REPLACE
+    /// conflict resolution algorithm. When the tracked table has unique keys
+    /// besides the rowid, the observation thus fetches the rowids of all
+    /// observed rows after each transaction, in order to remove those rows
+    /// from the notified value.
+    ///
+    /// - parameter request: A request of records.
+    public static func trackingIncrementally<Record>(
+        _ request: QueryInterfaceRequest<Record>)
+    -> ValueObservation<ValueReducers.Incremental<Record>>
+    where Record: FetchableRecord
+    {
+        .init(makeReducer: { .init(request) })
+    }
+}
+
+/// The value notified by an incremental observation.
+///
+/// See `ValueObservation.trackingIncrementally(_:)`.
+public struct IncrementalRecords<Record> {
+    /// All observed records, by rowid.
+    public private(set) var recordsByRowID: [Int64: Record]
+    
+    /// The rowids of the records that were inserted or updated since the
+    /// previous notified value.
+    ///
+    /// The first notified value contains the rowids of all records.
+    public private(set) var updatedRowIDs: Set<Int64>
+    
+    /// The rowids of the records that were deleted, or no longer match the
+    /// observed request, since the previous notified value.
+    public private(set) var deletedRowIDs: Set<Int64>
+}
+
+extension ValueReducers {
+    /// A reducer which, after each transaction, only fetches the rows that
+    /// were modified.
+    ///
+    /// See `ValueObservation.trackingIncrementally(_:)`
+    public struct Incremental<Record: FetchableRecord>: ValueReducer {
+        /// :nodoc:
+        public struct _Fetched {
+            /// The fetched records, by rowid
+            fileprivate var recordsByRowID: [Int64: Record]
+            
+            /// The refetched rowids, or nil for a full fetch
+            fileprivate var rowIDs: Set<Int64>?
+            
+            /// The rowids of all observed rows, when rows may have been
+            /// deleted by REPLACE conflicts, or nil.
+            fileprivate var observedRowIDs: Set<Int64>? = nil
+        }
+        
+        /// The name of the column that contains the rowid of fetched rows.
+        private static var rowIDKey: String { "grdb_rowid" }
+        
+        private let request: QueryInterfaceRequest<Record>
+        let rowChangeTracker: RowChangeTracker
+        private var recordsByRowID: [Int64: Record] = [:]
+        
+        /// :nodoc:
+        public var _isSelectedRegionDeterministic: Bool { true }
+        
+        init(_ request: QueryInterfaceRequest<Record>) {
+            let relation = request.relation
+            let isTrackable = relation.children.isEmpty
+                && relation.limit == nil
+                && relation.groupPromise == nil
+                && relation.havingExpressionPromise == nil
+                && !relation.isDistinct
+                && relation.ctes.isEmpty
+            self.request = request
+            self.rowChangeTracker = RowChangeTracker(
+                tableName: isTrackable ? relation.source.tableName : nil)
+        }
+        
+        /// :nodoc:
+        public func _fetch(_ db: Database) throws -> _Fetched {
+            try rowChangeTracker.prepare(db)
+            return try _Fetched(recordsByRowID: fetchRecords(db, request), rowIDs: nil)
+        }
+        
+        /// :nodoc:
+        public mutating func _value(_ fetched: _Fetched) -> IncrementalRecords<Record>? {
+            let updatedRowIDs = Set(fetched.recordsByRowID.keys)
+            var deletedRowIDs: Set<Int64> = []
+            if let rowIDs = fetched.rowIDs {
+                var removedRowIDs = rowIDs.subtracting(updatedRowIDs)
+                if let observedRowIDs = fetched.observedRowIDs {
+                    // Rows deleted by REPLACE conflicts, without notification
+                    removedRowIDs.formUnion(recordsByRowID.keys.filter { !observedRowIDs.contains($0) })
+                }
+                for rowID in removedRowIDs {
+                    if recordsByRowID.removeValue(forKey: rowID) != nil {
+                        deletedRowIDs.insert(rowID)
+                    }
+                }
+                if updatedRowIDs.isEmpty && deletedRowIDs.isEmpty {
+                    // No observed record was modified
+                    return nil
+                }
+                recordsByRowID.merge(fetched.recordsByRowID, uniquingKeysWith: { $1 })
+            } else {
+                deletedRowIDs = Set(recordsByRowID.keys).subtracting(updatedRowIDs)
+                recordsByRowID = fetched.recordsByRowID
+            }
+            return IncrementalRecords(
+                recordsByRowID: recordsByRowID,
+                updatedRowIDs: updatedRowIDs,
+                deletedRowIDs: deletedRowIDs)
+        }
+        
+        private func fetchRecords(
+            _ db: Database,
+            _ request: QueryInterfaceRequest<Record>)
+        throws -> [Int64: Record]
+        {
+            let rowIDKey = Self.rowIDKey
+            let rows = try Row.fetchCursor(
+                db,
+                request.annotated(with: Column.rowID.forKey(rowIDKey)))
+            var recordsByRowID: [Int64: Record] = [:]
+            while let row = try rows.next() {
+                try recordsByRowID[row.decode(forKey: rowIDKey)] = Record(row: row)
+            }
+            return recordsByRowID
+        }
+    }
+}
+
+extension ValueReducers.Incremental: IncrementalValueReducer {
+    func fetchModifiedRows(_ db: Database, rowIDs: Set<Int64>) throws -> Any {
+        // Leave room for the arguments of the observed request
+        let chunkSize = max(1, db.maximumStatementArgumentCount / 2)
+        let rowIDArray = Array(rowIDs)
+        var recordsByRowID: [Int64: Record] = [:]
+        for start in stride(from: 0, to: rowIDArray.count, by: chunkSize) {
+            let chunk = rowIDArray[start..<min(start + chunkSize, rowIDArray.count)]
+            let chunkRecords = try fetchRecords(db, request.filter(chunk.contains(Column.rowID)))
+            recordsByRowID.merge(chunkRecords, uniquingKeysWith: { $1 })
+        }
+        var fetched = _Fetched(recordsByRowID: recordsByRowID, rowIDs: rowIDs)
+        if rowChangeTracker.mayReplaceRows {
+            fetched.observedRowIDs = try request.select(Column.rowID, as: Int64.self).fetchSet(db)
+        }
+        return fetched
+    }
+}
+
+// MARK: - Incremental Fetches Support
+
+/// A reducer that can fetch only the rows modified by a transaction.
+///
+/// ValueObserver feeds the `rowChangeTracker` with database events, and calls
+/// `fetchModifiedRows(_:rowIDs:)` instead of `_fetch(_:)` when the tracker has
+/// collected the rowids of all modified rows.
+protocol IncrementalValueReducer {
+    /// The tracker of the rowids of modified rows.
+    var rowChangeTracker: RowChangeTracker { get }
+    
+    /// Returns the fetched value for the given modified rows. The result has
+    /// the `Fetched` type of the reducer.
+    func fetchModifiedRows(_ db: Database, rowIDs: Set<Int64>) throws -> Any
+}
+
+/// Collects the rowids of the rows modified by a transaction in a
+/// tracked table.
+///
+/// All methods but `prepare(_:)` must be called from the writer
+/// dispatch queue.
+final class RowChangeTracker {
+    /// Above this number of modified rows, a full fetch is performed.
+    static let maximumRowIDCount = 10_000
+    
+    /// The tracked table, or nil if changes can not be tracked by rowid.
+    private let tableName: String?
+    
+    /// The columns whose update modifies the rowid. Nil until `prepare(_:)`
+    /// has been called.
+    @LockedBox private var rowIDColumns: Set<String>? = nil
+    
+    /// True if the tracked table has unique keys besides the rowid: the
+    /// REPLACE conflict resolution algorithm may delete rows without
+    /// any notification.
+    ///
+    /// See https://www.sqlite.org/lang_conflict.html
+    @LockedBox private(set) var mayReplaceRows = false
+    
+    /// The rowids of modified rows during the current transaction
+    private var rowIDs: Set<Int64> = []
+    
+    /// True when modified rows can not be tracked by rowid during the
+    /// current transaction
+    private var needsFullFetch = false
+    
+    init(tableName: String?) {
+        self.tableName = tableName
+    }
+    
+    /// Loads the schema information needed for tracking changes.
+    func prepare(_ db: Database) throws {
+        guard let tableName = tableName, rowIDColumns == nil else {
+            return
+        }
+        // The standard aliases of the rowid, and the eventual INTEGER
+        // PRIMARY KEY column.
+        var columns: Set<String> = ["rowid", "oid", "_rowid_"]
+        // Views are not tables: their changes are notified as changes of
+        // other tables, which trigger full fetches.
+        if try db.tableExists(tableName) {
+            if let rowIDColumn = try db.primaryKey(tableName).rowIDColumn {
+                columns.insert(rowIDColumn.lowercased())
+            }
+            // Unique indexes, including the ones of unique constraints and
+            // non-rowid primary keys.
+            // [seq:0 name:"index" unique:1 origin:"u" partial:0]
+            mayReplaceRows = try Row
+                .fetchAll(db, sql: "PRAGMA index_list(\(tableName.quotedDatabaseIdentifier))")
+                .contains { $0["unique"] as Bool }
+        }
+        rowIDColumns = columns
+    }
+    
+    /// Called for each statement that may modify the tracked region.
+    func statementWillModify(_ eventKind: DatabaseEventKind) {
+        guard case let .update(tableName: _, columnNames: columnNames) = eventKind else {
+            return
+        }
+        // Updated rowids can not be tracked, because SQLite only notifies
+        // the new rowid.
+        guard let rowIDColumns = rowIDColumns else {
+            needsFullFetch = true
+            return
+        }
+        if columnNames.contains(where: { rowIDColumns.contains($0.lowercased()) }) {
+            needsFullFetch = true
+        }
+    }
+    
+    /// Records a change in the tracked region. Returns false if the
+    /// changes of the current transaction can no longer be tracked by rowid.
+    func track(_ event: DatabaseEvent) -> Bool {
+        if needsFullFetch {
+            return false
+        }
+        guard let tableName = tableName,
+              event.tableName.lowercased() == tableName.lowercased()
+        else {
+            // A change in another table impacts the observed request.
+            needsFullFetch = true
+            return false
+        }
+        rowIDs.insert(event.rowID)
+        if rowIDs.count > Self.maximumRowIDCount {
+            needsFullFetch = true
+            return false
+        }
+        return true
+    }
+    
+    /// Returns the rowids of the rows modified by the committed transaction,
+    /// or nil if a full fetch is needed, and prepares for the
+    /// next transaction.
+    func databaseDidCommit() -> Set<Int64>? {
+        defer { reset() }
+        if needsFullFetch || tableName == nil {
+            return nil
+        }
+        return rowIDs
+    }
+    
+    func databaseDidRollback() {
+        reset()
+    }
+    
+    private func reset() {
+        rowIDs = []
+        needsFullFetch = false
+    }
+}
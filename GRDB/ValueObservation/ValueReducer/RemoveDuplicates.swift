@@ -39,3 +39,11 @@ extension ValueReducers {
         }
     }
 }
+
+extension ValueReducers.RemoveDuplicates: IncrementalValueReducer where Base: IncrementalValueReducer {
+    var rowChangeTracker: RowChangeTracker { base.rowChangeTracker }
+    
+    func fetchModifiedRows(_ db: Database, rowIDs: Set<Int64>) throws -> Any {
+        try base.fetchModifiedRows(db, rowIDs: rowIDs)
+    }
+}
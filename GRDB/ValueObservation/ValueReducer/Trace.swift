@@ -23,3 +23,12 @@ extension ValueReducers {
         }
     }
 }
+
+extension ValueReducers.Trace: IncrementalValueReducer where Base: IncrementalValueReducer {
+    var rowChangeTracker: RowChangeTracker { base.rowChangeTracker }
+    
+    func fetchModifiedRows(_ db: Database, rowIDs: Set<Int64>) throws -> Any {
+        willFetch()
+        return try base.fetchModifiedRows(db, rowIDs: rowIDs)
+    }
+}
@@ -38,16 +38,25 @@ public protocol ValueReducer: _ValueReducer { }
 
 extension ValueReducer {
     func fetch(_ db: Database, requiringWriteAccess: Bool) throws -> Fetched {
+        try Self.fetch(db, requiringWriteAccess: requiringWriteAccess, using: _fetch)
+    }
+    
+    static func fetch(
+        _ db: Database,
+        requiringWriteAccess: Bool,
+        using fetch: (Database) throws -> Fetched)
+    throws -> Fetched
+    {
         if requiringWriteAccess {
             var fetchedValue: Fetched?
             try db.inSavepoint {
-                fetchedValue = try _fetch(db)
+                fetchedValue = try fetch(db)
                 return .commit
             }
             return fetchedValue!
         } else {
             return try db.readOnly {
-                try _fetch(db)
+                try fetch(db)
             }
         }
     }
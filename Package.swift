@@ -24,6 +24,10 @@ let package = Package(
             name: "GRDB",
             dependencies: ["CSQLite"],
             path: "GRDB"),
+        .target(
+            name: "GRDBBenchmarks",
+            dependencies: ["GRDB"],
+            path: "Tests/Performance/GRDBBenchmarks"),
         .testTarget(
             name: "GRDBTests",
             dependencies: ["GRDB"],
@@ -1187,4 +1187,69 @@ class AssociationPrefetchingRowTests: GRDBTestCase {
             }
         }
     }
+    
+    func testIncludingAllHasManyUnsortedKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let request = A
+                .including(all: A
+                    .hasMany(B.self)
+                    .order(Column("colb3").desc))
+                .order(Column("cola1").desc)
+            
+            let rows = try Row.fetchAll(db, request)
+            XCTAssertEqual(rows.count, 3)
+            
+            XCTAssertEqual(rows[0].unscoped, ["cola1": 3, "cola2": "a3"])
+            XCTAssertEqual(rows[0].prefetchedRows["bs"]!.count, 0)
+            
+            XCTAssertEqual(rows[1].unscoped, ["cola1": 2, "cola2": "a2"])
+            XCTAssertEqual(rows[1].prefetchedRows["bs"]!.count, 1)
+            XCTAssertEqual(rows[1].prefetchedRows["bs"]![0], ["colb1": 6, "colb2": 2, "colb3": "b3", "grdb_colb2": 2])
+            
+            XCTAssertEqual(rows[2].unscoped, ["cola1": 1, "cola2": "a1"])
+            XCTAssertEqual(rows[2].prefetchedRows["bs"]!.count, 2)
+            XCTAssertEqual(rows[2].prefetchedRows["bs"]![0], ["colb1": 5, "colb2": 1, "colb3": "b2", "grdb_colb2": 1])
+            XCTAssertEqual(rows[2].prefetchedRows["bs"]![1], ["colb1": 4, "colb2": 1, "colb3": "b1", "grdb_colb2": 1])
+        }
+    }
+    
+    func testIncludingAllHasManyNonIntegerKeys() throws {
+        struct Parent: TableRecord {
+            static let children = hasMany(Child.self)
+        }
+        struct Child: TableRecord { }
+        
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.create(table: "parent") { t in
+                t.column("code", .text).primaryKey()
+            }
+            try db.create(table: "child") { t in
+                t.autoIncrementedPrimaryKey("id")
+                t.column("parentCode", .text).references("parent")
+            }
+            try db.execute(sql: """
+                INSERT INTO parent (code) VALUES ('b'), ('a'), ('c');
+                INSERT INTO child (id, parentCode) VALUES (1, 'a'), (2, 'b'), (3, 'a');
+                """)
+            
+            let request = Parent
+                .including(all: Parent.children.orderByPrimaryKey())
+                .orderByPrimaryKey()
+                .asRequest(of: Row.self)
+            
+            let rows = try request.fetchAll(db)
+            XCTAssertEqual(rows.count, 3)
+            XCTAssertEqual(rows[0].unscoped, ["code": "a"])
+            XCTAssertEqual(rows[0].prefetchedRows["children"]!, [
+                ["id": 1, "parentCode": "a", "grdb_parentCode": "a"],
+                ["id": 3, "parentCode": "a", "grdb_parentCode": "a"]])
+            XCTAssertEqual(rows[1].unscoped, ["code": "b"])
+            XCTAssertEqual(rows[1].prefetchedRows["children"]!, [
+                ["id": 2, "parentCode": "b", "grdb_parentCode": "b"]])
+            XCTAssertEqual(rows[2].unscoped, ["code": "c"])
+            XCTAssertEqual(rows[2].prefetchedRows["children"]!, [])
+        }
+    }
 }
@@ -0,0 +1,77 @@
+import XCTest
+import GRDB
+
+private struct T: TableRecord {
+    static let databaseTableName = "t"
+}
+
+class ColumnarResultTests: GRDBTestCase {
+    func testEmptyResult() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: "CREATE TABLE t(a, b)")
+            let result = try ColumnarResult.fetch(db, sql: "SELECT a, b FROM t")
+            XCTAssertEqual(result.columnNames, ["a", "b"])
+            XCTAssertEqual(result.rowCount, 0)
+            XCTAssertEqual(result[0].integers, [])
+            XCTAssertNil(result[0].nullFlags)
+        }
+    }
+    
+    func testStorageClasses() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let result = try ColumnarResult.fetch(db, sql: """
+                SELECT 1 AS i, 1.5 AS d, 'foo' AS t, x'0102' AS b
+                UNION ALL
+                SELECT 2, 2.5, 'barbaz', x''
+                """)
+            XCTAssertEqual(result.rowCount, 2)
+            XCTAssertEqual(result["i"]?.integers, [1, 2])
+            XCTAssertEqual(result["D"]?.doubles, [1.5, 2.5])
+            XCTAssertEqual(result["t"]?.texts?.strings, ["foo", "barbaz"])
+            XCTAssertEqual(result["t"]?.texts?.bytes, Array("foobarbaz".utf8))
+            XCTAssertEqual(result["t"]?.texts?.offsets, [0, 3, 9])
+            XCTAssertEqual(result["b"]?.blobs?.map { Array($0) }, [[1, 2], []])
+            XCTAssertNil(result["missing"])
+        }
+    }
+    
+    func testNullValues() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: """
+                CREATE TABLE t(id INTEGER PRIMARY KEY, a, b);
+                INSERT INTO t VALUES (1, NULL, NULL);
+                INSERT INTO t VALUES (2, 'foo', NULL);
+                INSERT INTO t VALUES (3, NULL, NULL);
+                INSERT INTO t VALUES (4, 'bar', NULL);
+                """)
+            let result = try ColumnarResult.fetch(db, T.select(Column("a"), Column("b")).order(Column("id")))
+            XCTAssertEqual(result.rowCount, 4)
+            XCTAssertEqual(result[0].texts?.strings, ["", "foo", "", "bar"])
+            XCTAssertEqual(result[0].nullFlags, [true, false, true, false])
+            XCTAssertTrue(result[0].isNull(atIndex: 0))
+            XCTAssertFalse(result[0].isNull(atIndex: 1))
+            XCTAssertEqual(result[1].integers, [0, 0, 0, 0])
+            XCTAssertEqual(result[1].nullFlags, [true, true, true, true])
+        }
+    }
+    
+    func testMixedStorageClassesAreConvertedBySQLite() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let result = try ColumnarResult.fetch(db, sql: "SELECT 1 UNION ALL SELECT 2.5 UNION ALL SELECT '3'")
+            XCTAssertEqual(result[0].integers, [1, 2, 3])
+        }
+    }
+    
+    func testStatementArguments() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let statement = try db.makeSelectStatement(sql: "SELECT ? * 2")
+            XCTAssertEqual(try ColumnarResult.fetch(statement, arguments: [1])[0].integers, [2])
+            XCTAssertEqual(try ColumnarResult.fetch(statement, arguments: [2])[0].integers, [4])
+        }
+    }
+}
@@ -0,0 +1,134 @@
+import XCTest
+import GRDB
+
+class DatabaseBlobTests: GRDBTestCase {
+    private func setup(_ db: Database) throws {
+        try db.execute(sql: "CREATE TABLE document (id INTEGER PRIMARY KEY, content BLOB)")
+    }
+    
+    func testRead() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try setup(db)
+            try db.execute(sql: "INSERT INTO document (id, content) VALUES (1, ?)", arguments: ["Hello world".data(using: .utf8)!])
+            
+            let blob = try db.openBlob(table: "document", column: "content", rowID: 1)
+            XCTAssertEqual(blob.count, 11)
+            XCTAssertEqual(try blob.read(count: 5), "Hello".data(using: .utf8)!)
+            XCTAssertEqual(try blob.read(count: 5, at: 6), "world".data(using: .utf8)!)
+            
+            do {
+                _ = try blob.read(count: 12)
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_ERROR)
+            }
+        }
+    }
+    
+    func testReadChunks() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try setup(db)
+            let data = Data((0..<1000).map { UInt8($0 % 256) })
+            try db.execute(sql: "INSERT INTO document (id, content) VALUES (1, ?)", arguments: [data])
+            
+            let blob = try db.openBlob(table: "document", column: "content", rowID: 1)
+            var chunkSizes: [Int] = []
+            var readData = Data()
+            try blob.readChunks(chunkSize: 300) { bytes in
+                chunkSizes.append(bytes.count)
+                readData.append(contentsOf: bytes)
+            }
+            XCTAssertEqual(chunkSizes, [300, 300, 300, 100])
+            XCTAssertEqual(readData, data)
+            
+            let stream = OutputStream.toMemory()
+            stream.open()
+            try blob.read(to: stream, chunkSize: 300)
+            stream.close()
+            XCTAssertEqual(stream.property(forKey: .dataWrittenToMemoryStreamKey) as? Data, data)
+        }
+    }
+    
+    func testWriteZeroBlob() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try setup(db)
+            try db.execute(sql: "INSERT INTO document (id, content) VALUES (1, ZEROBLOB(?))", arguments: [10])
+            
+            let blob = try db.openBlob(table: "document", column: "content", rowID: 1, mode: .readWrite)
+            try blob.write("Hello".data(using: .utf8)!)
+            try blob.write("world".data(using: .utf8)!, at: 5)
+            blob.close()
+            
+            let content = try Data.fetchOne(db, sql: "SELECT content FROM document WHERE id = 1")
+            XCTAssertEqual(content, "Helloworld".data(using: .utf8)!)
+        }
+    }
+    
+    func testWriteFromStream() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try setup(db)
+            let data = Data((0..<1000).map { UInt8($0 % 256) })
+            try db.execute(literal: """
+                INSERT INTO document (id, content) VALUES (1, \(zeroBlob(data.count)))
+                """)
+            
+            let blob = try db.openBlob(table: "document", column: "content", rowID: 1, mode: .readWrite)
+            let stream = InputStream(data: data)
+            stream.open()
+            let writtenCount = try blob.write(from: stream, chunkSize: 300)
+            stream.close()
+            XCTAssertEqual(writtenCount, 1000)
+            
+            let content = try Data.fetchOne(db, sql: "SELECT content FROM document WHERE id = 1")
+            XCTAssertEqual(content, data)
+        }
+    }
+    
+    func testWriteReadOnlyBlob() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try setup(db)
+            try db.execute(sql: "INSERT INTO document (id, content) VALUES (1, ZEROBLOB(10))")
+            
+            let blob = try db.openBlob(table: "document", column: "content", rowID: 1)
+            do {
+                try blob.write("Hello".data(using: .utf8)!)
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_READONLY)
+            }
+        }
+    }
+    
+    func testReopen() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try setup(db)
+            try db.execute(sql: "INSERT INTO document (id, content) VALUES (1, ?)", arguments: ["foo".data(using: .utf8)!])
+            try db.execute(sql: "INSERT INTO document (id, content) VALUES (2, ?)", arguments: ["barbaz".data(using: .utf8)!])
+            
+            let blob = try db.openBlob(table: "document", column: "content", rowID: 1)
+            XCTAssertEqual(try blob.read(count: blob.count), "foo".data(using: .utf8)!)
+            try blob.reopen(rowID: 2)
+            XCTAssertEqual(blob.rowID, 2)
+            XCTAssertEqual(try blob.read(count: blob.count), "barbaz".data(using: .utf8)!)
+        }
+    }
+    
+    func testOpenMissingRow() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try setup(db)
+            do {
+                _ = try db.openBlob(table: "document", column: "content", rowID: 1)
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_ERROR)
+            }
+        }
+    }
+}
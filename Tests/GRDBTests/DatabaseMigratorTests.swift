@@ -830,4 +830,125 @@ class DatabaseMigratorTests : GRDBTestCase {
         try migrator2.migrate(dbQueue)
         try XCTAssertEqual(dbQueue.read { try Int.fetchOne($0, sql: "SELECT id FROM t1") }, 2)
     }
+    
+    // MARK: - Chunked Migrations
+    
+    /// A migrator that creates ten players, and fills their score, two
+    /// players per chunk.
+    private func makeChunkedMigrator(failAfter failingCheckpoint: Int64? = nil) -> DatabaseMigrator {
+        var migrator = DatabaseMigrator()
+        migrator.registerMigration("createPlayers") { db in
+            try db.execute(sql: "CREATE TABLE player(id INTEGER PRIMARY KEY, score INTEGER)")
+            for id in 1...10 {
+                try db.execute(sql: "INSERT INTO player(id) VALUES (?)", arguments: [id])
+            }
+        }
+        migrator.registerChunkedMigration("fillScores", migrateSchema: { db in
+            try db.create(index: "player_score", on: "player", columns: ["score"])
+        }, migrateChunk: { db, checkpoint in
+            let lastId = Int64.fromDatabaseValue(checkpoint) ?? 0
+            if lastId == failingCheckpoint {
+                throw DatabaseError(message: "interrupted")
+            }
+            let ids = try Int64.fetchAll(db, sql: """
+                SELECT id FROM player WHERE id > ? ORDER BY id LIMIT 2
+                """, arguments: [lastId])
+            guard let newLastId = ids.last else {
+                return nil
+            }
+            try db.execute(
+                sql: "UPDATE player SET score = id * 10 WHERE id > ? AND id <= ?",
+                arguments: [lastId, newLastId])
+            return newLastId.databaseValue
+        })
+        return migrator
+    }
+    
+    func testChunkedMigrationSync() throws {
+        func test(writer: DatabaseWriter) throws {
+            let migrator = makeChunkedMigrator()
+            try migrator.migrate(writer)
+            try writer.read { db in
+                try XCTAssertEqual(migrator.appliedMigrations(db), ["createPlayers", "fillScores"])
+                try XCTAssertTrue(migrator.hasCompletedMigrations(db))
+                try XCTAssertEqual(migrator.pendingChunkedMigrations(db), ["fillScores"])
+                try XCTAssertTrue(db.indexes(on: "player").contains { $0.name == "player_score" })
+                try XCTAssertEqual(Int.fetchOne(db, sql: "SELECT COUNT(*) FROM player WHERE score IS NULL"), 10)
+            }
+            
+            try migrator.migrateChunks(writer)
+            try writer.read { db in
+                try XCTAssertEqual(migrator.pendingChunkedMigrations(db), [])
+                try XCTAssertEqual(Int.fetchAll(db, sql: "SELECT score FROM player ORDER BY id"), Array(stride(from: 10, through: 100, by: 10)))
+            }
+            
+            // Completed data migrations are not run again
+            try migrator.migrateChunks(writer)
+        }
+        
+        try Test(test)
+            .run { DatabaseQueue() }
+            .runAtTemporaryDatabasePath { try DatabaseQueue(path: $0) }
+            .runAtTemporaryDatabasePath { try DatabasePool(path: $0) }
+    }
+    
+    func testChunkedMigrationAsync() throws {
+        func test(writer: DatabaseWriter) throws {
+            let migrator = makeChunkedMigrator()
+            try migrator.migrate(writer)
+            
+            let expectation = self.expectation(description: "")
+            migrator.asyncMigrateChunks(writer, completion: { db, error in
+                XCTAssertNil(error)
+                try! XCTAssertEqual(migrator.pendingChunkedMigrations(db), [])
+                try! XCTAssertEqual(Int.fetchOne(db, sql: "SELECT COUNT(*) FROM player WHERE score IS NULL"), 0)
+                expectation.fulfill()
+            })
+            waitForExpectations(timeout: 1, handler: nil)
+        }
+        
+        try Test(test)
+            .run { DatabaseQueue() }
+            .runAtTemporaryDatabasePath { try DatabaseQueue(path: $0) }
+            .runAtTemporaryDatabasePath { try DatabasePool(path: $0) }
+    }
+    
+    func testChunkedMigrationCommitsEachChunk() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let migrator = makeChunkedMigrator()
+        try migrator.migrate(dbQueue)
+        
+        sqlQueries.removeAll()
+        try migrator.migrateChunks(dbQueue)
+        
+        // 5 chunks, the completing chunk, and the final check
+        XCTAssertEqual(sqlQueries.filter { $0 == "COMMIT TRANSACTION" }.count, 7)
+    }
+    
+    func testChunkedMigrationResumesFromCheckpoint() throws {
+        let dbQueue = try makeDatabaseQueue()
+        do {
+            let migrator = makeChunkedMigrator(failAfter: 6)
+            try migrator.migrate(dbQueue)
+            do {
+                try migrator.migrateChunks(dbQueue)
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.message, "interrupted")
+            }
+            try dbQueue.read { db in
+                try XCTAssertEqual(migrator.pendingChunkedMigrations(db), ["fillScores"])
+                try XCTAssertEqual(Int.fetchOne(db, sql: "SELECT MAX(id) FROM player WHERE score IS NOT NULL"), 6)
+            }
+        }
+        do {
+            let migrator = makeChunkedMigrator()
+            try migrator.migrate(dbQueue)
+            try migrator.migrateChunks(dbQueue)
+            try dbQueue.read { db in
+                try XCTAssertEqual(migrator.pendingChunkedMigrations(db), [])
+                try XCTAssertEqual(Int.fetchAll(db, sql: "SELECT score FROM player ORDER BY id"), Array(stride(from: 10, through: 100, by: 10)))
+            }
+        }
+    }
 }
@@ -0,0 +1,126 @@
+import XCTest
+import GRDB
+
+class DatabasePoolCheckpointTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.execute(sql: "CREATE TABLE t(a)")
+        }
+    }
+    
+    func testNoStatisticsWithoutPolicy() throws {
+        let dbPool = try makeDatabasePool()
+        XCTAssertNil(dbPool.checkpointStatistics)
+    }
+    
+    func testWALPageThreshold() throws {
+        dbConfiguration.checkpointPolicy = DatabasePool.CheckpointPolicy(
+            walPageThreshold: 1,
+            escalationThreshold: nil)
+        let dbPool = try makeDatabasePool()
+        try dbPool.write { db in
+            try db.execute(sql: "INSERT INTO t(a) VALUES (1)")
+        }
+        waitUntil { dbPool.checkpointStatistics!.checkpointCount > 0 }
+        let statistics = dbPool.checkpointStatistics!
+        XCTAssertGreaterThan(statistics.walPageCount, 0)
+        XCTAssertEqual(statistics.escalatedCheckpointCount, 0)
+    }
+    
+    func testInterval() throws {
+        dbConfiguration.checkpointPolicy = DatabasePool.CheckpointPolicy(
+            walPageThreshold: nil,
+            interval: 0.05,
+            escalationThreshold: nil)
+        let dbPool = try makeDatabasePool()
+        try dbPool.write { db in
+            try db.execute(sql: "INSERT INTO t(a) VALUES (1)")
+        }
+        waitUntil { dbPool.checkpointStatistics!.checkpointCount > 0 }
+    }
+    
+    func testIntervalSkipsCheckpointedWAL() throws {
+        dbConfiguration.checkpointPolicy = DatabasePool.CheckpointPolicy(
+            walPageThreshold: nil,
+            interval: 0.05,
+            escalationThreshold: nil)
+        let dbPool = try makeDatabasePool()
+        try dbPool.write { db in
+            try db.execute(sql: "INSERT INTO t(a) VALUES (1)")
+        }
+        waitUntil { dbPool.checkpointStatistics!.checkpointCount > 0 }
+        
+        // Without any reader, the WAL is fully checkpointed: there is
+        // nothing left to checkpoint.
+        let checkpointCount = dbPool.checkpointStatistics!.checkpointCount
+        Thread.sleep(forTimeInterval: 0.3)
+        XCTAssertEqual(dbPool.checkpointStatistics!.checkpointCount, checkpointCount)
+        
+        try dbPool.write { db in
+            try db.execute(sql: "INSERT INTO t(a) VALUES (2)")
+        }
+        waitUntil { dbPool.checkpointStatistics!.checkpointCount > checkpointCount }
+    }
+    
+    func testNoCheckpointDuringSuspension() throws {
+        dbConfiguration.observesSuspensionNotifications = true
+        dbConfiguration.checkpointPolicy = DatabasePool.CheckpointPolicy(
+            walPageThreshold: nil,
+            interval: 0.5,
+            escalationThreshold: nil)
+        // The commit of setup(_:) fills the WAL
+        let dbPool = try makeDatabasePool()
+        NotificationCenter.default.post(name: Database.suspendNotification, object: nil)
+        Thread.sleep(forTimeInterval: 1)
+        XCTAssertEqual(dbPool.checkpointStatistics!.checkpointCount, 0)
+        
+        NotificationCenter.default.post(name: Database.resumeNotification, object: nil)
+        waitUntil { dbPool.checkpointStatistics!.checkpointCount > 0 }
+    }
+    
+    func testEscalatedCheckpointTruncatesWAL() throws {
+        dbConfiguration.checkpointPolicy = DatabasePool.CheckpointPolicy(
+            walPageThreshold: 1,
+            escalationThreshold: 1,
+            escalationMode: .truncate)
+        // The commit of setup(_:) triggers the checkpoint
+        let dbPool = try makeDatabasePool()
+        waitUntil { dbPool.checkpointStatistics!.escalatedCheckpointCount > 0 }
+        XCTAssertEqual(dbPool.checkpointStatistics!.walPageCount, 0)
+        let walSize = try FileManager.default.attributesOfItem(atPath: dbPool.path + "-wal")[.size] as! NSNumber
+        XCTAssertEqual(walSize.intValue, 0)
+    }
+    
+    func testCheckpointIsNotEscalatedWhileReadersAreBusy() throws {
+        dbConfiguration.checkpointPolicy = DatabasePool.CheckpointPolicy(
+            walPageThreshold: 1,
+            escalationThreshold: 1)
+        let dbPool = try makeDatabasePool()
+        
+        // Wait for the checkpoint triggered by the commit of setup(_:)
+        waitUntil { dbPool.checkpointStatistics!.checkpointCount > 0 }
+        let initialStatistics = dbPool.checkpointStatistics!
+        
+        let readerIsBusy = DispatchSemaphore(value: 0)
+        let readerCanEnd = DispatchSemaphore(value: 0)
+        let readerDidEnd = DispatchSemaphore(value: 0)
+        DispatchQueue.global().async {
+            try! dbPool.read { _ in
+                readerIsBusy.signal()
+                readerCanEnd.wait()
+            }
+            readerDidEnd.signal()
+        }
+        readerIsBusy.wait()
+        
+        try dbPool.write { db in
+            try db.execute(sql: "INSERT INTO t(a) VALUES (1)")
+        }
+        waitUntil { dbPool.checkpointStatistics!.checkpointCount > initialStatistics.checkpointCount }
+        XCTAssertEqual(
+            dbPool.checkpointStatistics!.escalatedCheckpointCount,
+            initialStatistics.escalatedCheckpointCount)
+        readerCanEnd.signal()
+        readerDidEnd.wait()
+    }
+}
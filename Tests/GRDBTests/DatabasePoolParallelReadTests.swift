@@ -0,0 +1,88 @@
+import XCTest
+import GRDB
+
+class DatabasePoolParallelReadTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.execute(sql: "CREATE TABLE t(a)")
+            for i in 0..<100 {
+                try db.execute(sql: "INSERT INTO t(a) VALUES (?)", arguments: [i])
+            }
+        }
+    }
+    
+    func testEmptyPartitions() throws {
+        let dbPool = try makeDatabasePool()
+        let results = try dbPool.parallelRead(partitions: [Int]()) { db, partition in
+            partition
+        }
+        XCTAssertEqual(results, [])
+    }
+    
+    func testResultsAreOrderedByPartition() throws {
+        dbConfiguration.maximumReaderCount = 3
+        let dbPool = try makeDatabasePool()
+        let partitions = Array(0..<10)
+        let counts = try dbPool.parallelRead(partitions: partitions) { db, partition in
+            try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM t WHERE a % 10 = ?", arguments: [partition])!
+        }
+        XCTAssertEqual(counts, Array(repeating: 10, count: 10))
+        
+        let sums = try dbPool.parallelRead(partitions: partitions) { db, partition in
+            try Int.fetchOne(db, sql: "SELECT SUM(a) FROM t WHERE a / 10 = ?", arguments: [partition])!
+        }
+        XCTAssertEqual(sums, partitions.map { 100 * $0 + 45 })
+    }
+    
+    func testPartitionsRunConcurrently() throws {
+        dbConfiguration.maximumReaderCount = 3
+        let dbPool = try makeDatabasePool()
+        
+        // Each partition waits until all partitions have started
+        let group = DispatchGroup()
+        for _ in 0..<3 { group.enter() }
+        let results = try dbPool.parallelRead(partitions: [0, 1, 2]) { db, partition -> Bool in
+            group.leave()
+            return group.wait(timeout: .now() + 5) == .success
+        }
+        XCTAssertEqual(results, [true, true, true])
+    }
+    
+    func testPartitionsShareTheSameSnapshot() throws {
+        let dbPool = try makeDatabasePool()
+        let writeSemaphore = DispatchSemaphore(value: 0)
+        let counts = try dbPool.parallelRead(partitions: [0, 1, 2]) { db, partition -> Int in
+            if partition == 0 {
+                // Write while partitions are processed
+                DispatchQueue.global().async {
+                    try! dbPool.write { db in
+                        try db.execute(sql: "DELETE FROM t")
+                    }
+                    writeSemaphore.signal()
+                }
+                writeSemaphore.wait()
+            }
+            return try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM t")!
+        }
+        XCTAssertEqual(counts, [100, 100, 100])
+        try XCTAssertEqual(dbPool.read { try Int.fetchOne($0, sql: "SELECT COUNT(*) FROM t")! }, 0)
+    }
+    
+    func testErrorIsRethrown() throws {
+        struct TestError: Error { }
+        let dbPool = try makeDatabasePool()
+        do {
+            _ = try dbPool.parallelRead(partitions: Array(0..<10)) { db, partition -> Int in
+                if partition == 5 {
+                    throw TestError()
+                }
+                return partition
+            }
+            XCTFail("Expected error")
+        } catch is TestError {
+        }
+        
+        // Connections are released
+        try XCTAssertEqual(dbPool.read { try Int.fetchOne($0, sql: "SELECT COUNT(*) FROM t")! }, 100)
+    }
+}
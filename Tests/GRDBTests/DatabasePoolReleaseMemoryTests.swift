@@ -40,6 +40,42 @@ class DatabasePoolReleaseMemoryTests: GRDBTestCase {
         // All connections are closed
         XCTAssertEqual(openConnectionCount, 0)
     }
+    
+    func testReaderIdleTimeoutClosesReaderConnections() throws {
+        let countQueue = DispatchQueue(label: "GRDB")
+        var openConnectionCount = 0
+        
+        dbConfiguration.SQLiteConnectionDidOpen = {
+            countQueue.sync {
+                openConnectionCount += 1
+            }
+        }
+        
+        dbConfiguration.SQLiteConnectionDidClose = {
+            countQueue.sync {
+                openConnectionCount -= 1
+            }
+        }
+        
+        dbConfiguration.readerIdleTimeout = 0.1
+        let dbPool = try makeDatabasePool()
+        try dbPool.read { _ in }
+        
+        // One reader, one writer
+        XCTAssertEqual(countQueue.sync { openConnectionCount }, 2)
+        XCTAssertEqual(dbPool.readerStatistics.readerCount, 1)
+        XCTAssertEqual(dbPool.readerStatistics.acquisitionCount, 1)
+        
+        // Reader is closed
+        Thread.sleep(forTimeInterval: 0.5)
+        XCTAssertEqual(countQueue.sync { openConnectionCount }, 1)
+        XCTAssertEqual(dbPool.readerStatistics.readerCount, 0)
+        XCTAssertEqual(dbPool.readerStatistics.idleCloseCount, 1)
+        
+        // New reader
+        try dbPool.read { _ in }
+        XCTAssertEqual(countQueue.sync { openConnectionCount }, 2)
+    }
 
     // TODO: fix flaky test
 //    func testDatabasePoolReleaseMemoryClosesReaderConnections() throws {
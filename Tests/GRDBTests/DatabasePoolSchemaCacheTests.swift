@@ -222,4 +222,68 @@ class DatabasePoolSchemaCacheTests : GRDBTestCase {
             XCTAssertFalse(db.schemaCache[.main].indexes(on: "items") == nil)
         }
     }
+    
+    func testReadersShareCache() throws {
+        let dbPool = try makeDatabasePool()
+        try dbPool.write { db in
+            try db.execute(sql: "CREATE TABLE items (id INTEGER PRIMARY KEY, email TEXT UNIQUE, foo INT, bar DOUBLE)")
+        }
+        
+        // Warm cache in a reader, and keep it busy so that another reader
+        // connection is used below.
+        let s1 = DispatchSemaphore(value: 0)
+        let s2 = DispatchSemaphore(value: 0)
+        let expectation = self.expectation(description: "")
+        dbPool.asyncRead { dbResult in
+            let db = try! dbResult.get()
+            _ = try! db.primaryKey("items")
+            _ = try! db.columns(in: "items")
+            s1.signal()
+            _ = s2.wait(timeout: .distantFuture)
+            expectation.fulfill()
+        }
+        _ = s1.wait(timeout: .distantFuture)
+        
+        try dbPool.read { db in
+            // Assert that the other reader cache is warm
+            XCTAssertTrue(db.schemaCache[.main].primaryKey("items") != nil)
+            XCTAssertTrue(db.schemaCache[.main].columns(in: "items") != nil)
+        }
+        s2.signal()
+        waitForExpectations(timeout: 1, handler: nil)
+        
+        try dbPool.write { db in
+            // Assert that the writer cache is not shared
+            XCTAssertTrue(db.schemaCache[.main].primaryKey("items") == nil)
+            
+            // Change schema
+            try db.execute(sql: "ALTER TABLE items ADD COLUMN baz TEXT")
+        }
+        
+        try dbPool.read { db in
+            // Assert that reader cache is cleared
+            XCTAssertTrue(db.schemaCache[.main].columns(in: "items") == nil)
+            XCTAssertEqual(try db.columns(in: "items").count, 5)
+        }
+    }
+    
+    func testClearSchemaCacheClearsReaderCaches() throws {
+        let dbPool = try makeDatabasePool()
+        try dbPool.write { db in
+            try db.execute(sql: "CREATE TABLE items (id INTEGER PRIMARY KEY)")
+        }
+        
+        try dbPool.read { db in
+            _ = try db.primaryKey("items")
+            XCTAssertTrue(db.schemaCache[.main].primaryKey("items") != nil)
+        }
+        
+        try dbPool.writeWithoutTransaction { db in
+            db.clearSchemaCache()
+        }
+        
+        try dbPool.read { db in
+            XCTAssertTrue(db.schemaCache[.main].primaryKey("items") == nil)
+        }
+    }
 }
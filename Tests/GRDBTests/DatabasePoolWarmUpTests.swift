@@ -0,0 +1,92 @@
+import XCTest
+@testable import GRDB
+
+class DatabasePoolWarmUpTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.execute(sql: "CREATE TABLE player(id INTEGER PRIMARY KEY, name TEXT, score INTEGER)")
+        }
+    }
+    
+    private func warmUp(
+        _ dbPool: DatabasePool,
+        readerCount: Int,
+        tables: [String] = [],
+        statements: [String] = [])
+    throws -> DatabasePool.WarmUpStatistics
+    {
+        let expectation = self.expectation(description: "warm-up")
+        var result: Result<DatabasePool.WarmUpStatistics, Error>?
+        dbPool.asyncWarmUp(readerCount: readerCount, tables: tables, statements: statements) {
+            result = $0
+            expectation.fulfill()
+        }
+        waitForExpectations(timeout: 5, handler: nil)
+        return try result!.get()
+    }
+    
+    func testWarmUpOpensReaders() throws {
+        dbConfiguration.maximumReaderCount = 3
+        let dbPool = try makeDatabasePool()
+        let statistics = try warmUp(dbPool, readerCount: 5)
+        XCTAssertEqual(statistics.readerCount, 3)
+        XCTAssertEqual(dbPool.readerStatistics.readerCount, 3)
+        XCTAssertEqual(dbPool.readerStatistics.busyReaderCount, 0)
+    }
+    
+    func testWarmUpPreparesDatabase() throws {
+        let prepareCount = LockedBox(wrappedValue: 0)
+        dbConfiguration.maximumReaderCount = 2
+        dbConfiguration.prepareDatabase { _ in
+            prepareCount.increment()
+        }
+        let dbPool = try makeDatabasePool()
+        let initialCount = prepareCount.wrappedValue // writer
+        
+        _ = try warmUp(dbPool, readerCount: 2)
+        XCTAssertEqual(prepareCount.wrappedValue, initialCount + 2)
+        
+        // Warmed-up readers are reused
+        try dbPool.read { _ in }
+        XCTAssertEqual(prepareCount.wrappedValue, initialCount + 2)
+    }
+    
+    func testWarmUpFillsSchemaCache() throws {
+        dbConfiguration.maximumReaderCount = 1
+        let dbPool = try makeDatabasePool()
+        _ = try warmUp(dbPool, readerCount: 1, tables: ["player"])
+        
+        try dbPool.read { db in
+            XCTAssertTrue(db.schemaCache[.main].primaryKey("player") != nil)
+            XCTAssertTrue(db.schemaCache[.main].columns(in: "player") != nil)
+            XCTAssertTrue(db.schemaCache[.main].indexes(on: "player") != nil)
+            XCTAssertTrue(db.schemaCache[.main].foreignKeys(on: "player") != nil)
+        }
+    }
+    
+    func testWarmUpFillsStatementCache() throws {
+        dbConfiguration.maximumReaderCount = 1
+        let dbPool = try makeDatabasePool()
+        let sql = "SELECT * FROM player ORDER BY score DESC LIMIT 10"
+        _ = try warmUp(dbPool, readerCount: 1, statements: [sql])
+        
+        try dbPool.read { db in
+            let hitCount = db.statementCacheStatistics.hitCount
+            _ = try Row.fetchAll(db.cachedSelectStatement(sql: sql))
+            XCTAssertEqual(db.statementCacheStatistics.hitCount, hitCount + 1)
+        }
+    }
+    
+    func testWarmUpError() throws {
+        let dbPool = try makeDatabasePool()
+        do {
+            _ = try warmUp(dbPool, readerCount: 1, statements: ["SELECT * FROM missing"])
+            XCTFail("Expected error")
+        } catch let error as DatabaseError {
+            XCTAssertEqual(error.resultCode, .SQLITE_ERROR)
+        }
+        
+        // Readers were released
+        XCTAssertEqual(dbPool.readerStatistics.busyReaderCount, 0)
+    }
+}
@@ -0,0 +1,129 @@
+import XCTest
+import GRDB
+
+class DatabaseProfilingTests : GRDBTestCase {
+    func testProfilingIsDisabledByDefault() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: "CREATE TABLE t(a)")
+            let statistics = db.profilingStatistics
+            XCTAssertTrue(statistics.statements.isEmpty)
+            XCTAssertEqual(statistics.transactionDurations.count, 0)
+        }
+    }
+    
+    func testStatementStatistics() throws {
+        guard #available(OSX 10.12, tvOS 10.0, watchOS 3.0, *) else {
+            throw XCTSkip("sqlite3_trace_v2 is not available")
+        }
+        
+        dbConfiguration.profilingEnabled = true
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: "CREATE TABLE t(a)")
+            db.resetProfilingStatistics()
+            
+            for i in 0..<3 {
+                try db.execute(sql: "INSERT INTO t (a) VALUES (?)", arguments: [i])
+            }
+            _ = try Row.fetchAll(db, sql: "SELECT * FROM t ORDER BY a")
+            
+            let statistics = db.profilingStatistics
+            let insertStatistics = try XCTUnwrap(statistics.statements["INSERT INTO t (a) VALUES (?)"])
+            XCTAssertEqual(insertStatistics.executionCount, 3)
+            XCTAssertEqual(insertStatistics.durations.bucketCounts.reduce(0, +), 3)
+            XCTAssertGreaterThan(insertStatistics.virtualMachineStepCount, 0)
+            XCTAssertLessThanOrEqual(insertStatistics.medianDuration, insertStatistics.durations.maximumDuration)
+            XCTAssertLessThanOrEqual(insertStatistics.p99Duration, insertStatistics.durations.maximumDuration)
+            XCTAssertEqual(
+                insertStatistics.averageDuration,
+                insertStatistics.totalDuration / 3,
+                accuracy: 1e-9)
+            
+            let selectStatistics = try XCTUnwrap(statistics.statements["SELECT * FROM t ORDER BY a"])
+            XCTAssertEqual(selectStatistics.executionCount, 1)
+            XCTAssertGreaterThan(selectStatistics.fullScanStepCount, 0)
+            XCTAssertEqual(selectStatistics.sortCount, 1)
+            
+            db.resetProfilingStatistics()
+            XCTAssertTrue(db.profilingStatistics.statements.isEmpty)
+        }
+    }
+    
+    func testTransactionStatistics() throws {
+        guard #available(OSX 10.12, tvOS 10.0, watchOS 3.0, *) else {
+            throw XCTSkip("sqlite3_trace_v2 is not available")
+        }
+        
+        dbConfiguration.profilingEnabled = true
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: "CREATE TABLE t(a)")
+            db.resetProfilingStatistics()
+        }
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO t DEFAULT VALUES")
+        }
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: "INSERT INTO t DEFAULT VALUES")
+            try db.inTransaction {
+                try db.execute(sql: "INSERT INTO t DEFAULT VALUES")
+                return .rollback
+            }
+        }
+        try dbQueue.inDatabase { db in
+            XCTAssertEqual(db.profilingStatistics.transactionDurations.count, 2)
+        }
+    }
+    
+    func testProfilingDoesNotPreventTracing() throws {
+        guard #available(OSX 10.12, tvOS 10.0, watchOS 3.0, *) else {
+            throw XCTSkip("sqlite3_trace_v2 is not available")
+        }
+        
+        dbConfiguration.profilingEnabled = true
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            var tracedSQL: [String] = []
+            db.trace(options: .statement) { event in
+                switch event {
+                case let .statement(statement):
+                    tracedSQL.append(statement.sql)
+                default:
+                    XCTFail("Unexpected event")
+                }
+            }
+            try db.execute(sql: "CREATE TABLE t(a)")
+            XCTAssertEqual(tracedSQL, ["CREATE TABLE t(a)"])
+            XCTAssertNotNil(db.profilingStatistics.statements["CREATE TABLE t(a)"])
+            
+            // Stop tracing
+            db.trace(options: [])
+            try db.execute(sql: "DROP TABLE t")
+            XCTAssertEqual(tracedSQL, ["CREATE TABLE t(a)"])
+            XCTAssertNotNil(db.profilingStatistics.statements["DROP TABLE t"])
+        }
+    }
+    
+    func testDatabasePoolStatistics() throws {
+        guard #available(OSX 10.12, tvOS 10.0, watchOS 3.0, *) else {
+            throw XCTSkip("sqlite3_trace_v2 is not available")
+        }
+        
+        dbConfiguration.profilingEnabled = true
+        let dbPool = try makeDatabasePool()
+        try dbPool.write { db in
+            try db.execute(sql: "CREATE TABLE t(a)")
+        }
+        try dbPool.read { db in
+            _ = try Row.fetchAll(db, sql: "SELECT * FROM t")
+        }
+        
+        let statistics = dbPool.profilingStatistics
+        XCTAssertEqual(statistics.statements["CREATE TABLE t(a)"]?.executionCount, 1)
+        XCTAssertEqual(statistics.statements["SELECT * FROM t"]?.executionCount, 1)
+        
+        dbPool.resetProfilingStatistics()
+        XCTAssertTrue(dbPool.profilingStatistics.statements.isEmpty)
+    }
+}
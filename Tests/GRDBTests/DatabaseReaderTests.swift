@@ -217,3 +217,89 @@ class DatabaseReaderTests : GRDBTestCase {
         try test(setup(makeDatabasePool(configuration: Configuration())).makeSnapshot())
     }
 }
+
+#if swift(>=5.5) && canImport(_Concurrency)
+@available(OSX 10.15, iOS 13, tvOS 13, watchOS 6, *)
+extension DatabaseReaderTests {
+    // MARK: - Async Await
+    
+    func testAsyncAwaitRead() async throws {
+        func setup<T: DatabaseWriter>(_ dbWriter: T) throws -> T {
+            try dbWriter.write { db in
+                try db.execute(sql: "CREATE TABLE t (id INTEGER PRIMARY KEY)")
+            }
+            return dbWriter
+        }
+        func test(_ dbReader: DatabaseReader) async throws {
+            let count = try await dbReader.read { db in
+                try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM t")
+            }
+            XCTAssertEqual(count, 0)
+        }
+        
+        try await test(setup(makeDatabaseQueue()))
+        try await test(setup(makeDatabasePool()))
+        try await test(setup(makeDatabasePool()).makeSnapshot())
+    }
+    
+    func testAsyncAwaitReadPreventsDatabaseModification() async throws {
+        func test(_ dbReader: DatabaseReader) async throws {
+            do {
+                try await dbReader.read { db in
+                    try db.execute(sql: "CREATE TABLE t (id INTEGER PRIMARY KEY)")
+                }
+                XCTFail("Expected error")
+            } catch let error as DatabaseError where error.resultCode == .SQLITE_READONLY {
+            }
+        }
+        
+        try await test(makeDatabaseQueue())
+        try await test(makeDatabasePool())
+        try await test(makeDatabasePool().makeSnapshot())
+    }
+    
+    func testAsyncAwaitConcurrentReads() async throws {
+        dbConfiguration.maximumReaderCount = 2
+        let dbPool = try makeDatabasePool()
+        let counts = try await withThrowingTaskGroup(of: Int.self) { group -> [Int] in
+            for _ in 0..<100 {
+                group.addTask {
+                    try await dbPool.read { db in
+                        try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM sqlite_master")!
+                    }
+                }
+            }
+            return try await group.reduce(into: []) { $0.append($1) }
+        }
+        XCTAssertEqual(counts, Array(repeating: 0, count: 100))
+        XCTAssertEqual(dbPool.readerStatistics.acquisitionCount, 100)
+        XCTAssertLessThanOrEqual(dbPool.readerStatistics.readerCount, 2)
+    }
+    
+    func testAsyncAwaitReadCancellation() async throws {
+        func test(_ dbReader: DatabaseReader) async throws {
+            let task = Task {
+                try await dbReader.read { db in
+                    // Infinite loop
+                    try Int.fetchOne(db, sql: """
+                        WITH RECURSIVE c(x) AS (VALUES(1) UNION ALL SELECT x+1 FROM c)
+                        SELECT COUNT(*) FROM c
+                        """)
+                }
+            }
+            DispatchQueue.global().asyncAfter(deadline: .now() + 0.1) {
+                task.cancel()
+            }
+            do {
+                _ = try await task.value
+                XCTFail("Expected error")
+            } catch is CancellationError {
+            } catch let error as DatabaseError where error.resultCode == .SQLITE_INTERRUPT {
+            }
+        }
+        
+        try await test(makeDatabaseQueue())
+        try await test(makeDatabasePool())
+    }
+}
+#endif
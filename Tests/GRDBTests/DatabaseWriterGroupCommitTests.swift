@@ -0,0 +1,138 @@
+import XCTest
+@testable import GRDB
+
+class DatabaseWriterGroupCommitTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.execute(sql: "CREATE TABLE t(a UNIQUE)")
+        }
+    }
+    
+    /// Schedules writes while the writer is busy, and returns the
+    /// completion results.
+    private func groupedWrites(
+        _ dbWriter: DatabaseWriter,
+        values: [Int])
+    -> [Result<Void, Error>]
+    {
+        let expectation = self.expectation(description: "completion")
+        expectation.expectedFulfillmentCount = values.count
+        let semaphore = DispatchSemaphore(value: 0)
+        let results = LockedBox<[Int: Result<Void, Error>]>(wrappedValue: [:])
+        
+        // Block the writer until all writes are scheduled
+        dbWriter.asyncWriteWithoutTransaction { _ in
+            semaphore.wait()
+        }
+        for (index, value) in values.enumerated() {
+            dbWriter.asyncWrite({ db in
+                try db.execute(sql: "INSERT INTO t(a) VALUES (?)", arguments: [value])
+            }, completion: { db, result in
+                XCTAssertFalse(db.isInsideTransaction)
+                results.update { $0[index] = result }
+                expectation.fulfill()
+            })
+        }
+        semaphore.signal()
+        waitForExpectations(timeout: 5, handler: nil)
+        return values.indices.map { results.wrappedValue[$0]! }
+    }
+    
+    private var commitCount: Int {
+        sqlQueries.filter { $0 == "COMMIT TRANSACTION" }.count
+    }
+    
+    func testWritesAreCommittedTogether() throws {
+        func test(_ dbWriter: DatabaseWriter) throws {
+            sqlQueries = []
+            let results = groupedWrites(dbWriter, values: [1, 2, 3, 4, 5])
+            XCTAssertTrue(results.allSatisfy { (try? $0.get()) != nil })
+            XCTAssertEqual(commitCount, 1)
+            try XCTAssertEqual(dbWriter.read { try Int.fetchAll($0, sql: "SELECT a FROM t ORDER BY a") }, [1, 2, 3, 4, 5])
+        }
+        
+        dbConfiguration.groupCommitMaximumCount = 10
+        try test(makeDatabaseQueue())
+        try test(makeDatabasePool())
+    }
+    
+    func testMaximumCount() throws {
+        func test(_ dbWriter: DatabaseWriter) throws {
+            sqlQueries = []
+            let results = groupedWrites(dbWriter, values: [1, 2, 3, 4, 5])
+            XCTAssertTrue(results.allSatisfy { (try? $0.get()) != nil })
+            XCTAssertEqual(commitCount, 3)
+            try XCTAssertEqual(dbWriter.read { try Int.fetchCount($0, sql: "SELECT * FROM t") }, 5)
+        }
+        
+        dbConfiguration.groupCommitMaximumCount = 2
+        try test(makeDatabaseQueue())
+        try test(makeDatabasePool())
+    }
+    
+    func testFailedWriteDoesNotPreventOtherWrites() throws {
+        func test(_ dbWriter: DatabaseWriter) throws {
+            sqlQueries = []
+            // Second write violates the unique constraint
+            let results = groupedWrites(dbWriter, values: [1, 1, 2])
+            XCTAssertNotNil(try? results[0].get())
+            XCTAssertNotNil(try? results[2].get())
+            do {
+                try results[1].get()
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_CONSTRAINT)
+            }
+            XCTAssertEqual(commitCount, 1)
+            try XCTAssertEqual(dbWriter.read { try Int.fetchAll($0, sql: "SELECT a FROM t ORDER BY a") }, [1, 2])
+        }
+        
+        dbConfiguration.groupCommitMaximumCount = 10
+        try test(makeDatabaseQueue())
+        try test(makeDatabasePool())
+    }
+    
+    func testMaximumDelay() throws {
+        func test(_ dbWriter: DatabaseWriter) throws {
+            // Writes scheduled within the delay share their transaction,
+            // even if the writer is idle.
+            do {
+                sqlQueries = []
+                let expectation = self.expectation(description: "completion")
+                expectation.expectedFulfillmentCount = 3
+                for value in [1, 2, 3] {
+                    dbWriter.asyncWrite({ db in
+                        try db.execute(sql: "INSERT INTO t(a) VALUES (?)", arguments: [value])
+                    }, completion: { db, result in
+                        XCTAssertNotNil(try? result.get())
+                        expectation.fulfill()
+                    })
+                }
+                waitForExpectations(timeout: 5, handler: nil)
+                XCTAssertEqual(commitCount, 1)
+                try XCTAssertEqual(dbWriter.read { try Int.fetchAll($0, sql: "SELECT a FROM t ORDER BY a") }, [1, 2, 3])
+            }
+            
+            // A lone write waits for other writes
+            do {
+                let expectation = self.expectation(description: "completion")
+                let start = Date()
+                let duration = LockedBox<TimeInterval?>(wrappedValue: nil)
+                dbWriter.asyncWrite({ db in
+                    try db.execute(sql: "INSERT INTO t(a) VALUES (4)")
+                }, completion: { db, result in
+                    XCTAssertNotNil(try? result.get())
+                    duration.wrappedValue = Date().timeIntervalSince(start)
+                    expectation.fulfill()
+                })
+                waitForExpectations(timeout: 5, handler: nil)
+                XCTAssertGreaterThanOrEqual(duration.wrappedValue!, 0.9 * dbConfiguration.groupCommitMaximumDelay)
+            }
+        }
+        
+        dbConfiguration.groupCommitMaximumCount = 10
+        dbConfiguration.groupCommitMaximumDelay = 0.5
+        try test(makeDatabaseQueue())
+        try test(makeDatabasePool())
+    }
+}
@@ -224,3 +224,55 @@ class DatabaseWriterTests : GRDBTestCase {
         try DatabaseQueue().backup(to: dbQueue)
     }
 }
+
+#if swift(>=5.5) && canImport(_Concurrency)
+@available(OSX 10.15, iOS 13, tvOS 13, watchOS 6, *)
+extension DatabaseWriterTests {
+    // MARK: - Async Await
+    
+    func testAsyncAwaitWrite() async throws {
+        func test(_ dbWriter: DatabaseWriter) async throws {
+            let count = try await dbWriter.write { db -> Int in
+                try db.execute(sql: "CREATE TABLE t (id INTEGER PRIMARY KEY)")
+                try db.execute(sql: "INSERT INTO t DEFAULT VALUES")
+                return try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM t")!
+            }
+            XCTAssertEqual(count, 1)
+        }
+        
+        try await test(makeDatabaseQueue())
+        try await test(makeDatabasePool())
+    }
+    
+    func testAsyncAwaitWriteError() async throws {
+        func test(_ dbWriter: DatabaseWriter) async throws {
+            do {
+                try await dbWriter.write { db in
+                    try db.execute(sql: "CREATE TABLE t (id INTEGER PRIMARY KEY)")
+                    try db.execute(sql: "THIS IS NOT SQL")
+                }
+                XCTFail("Expected error")
+            } catch is DatabaseError { }
+            
+            // Transaction was rollbacked
+            let exists = try await dbWriter.read { db in try db.tableExists("t") }
+            XCTAssertFalse(exists)
+        }
+        
+        try await test(makeDatabaseQueue())
+        try await test(makeDatabasePool())
+    }
+    
+    func testAsyncAwaitWriteWithoutTransaction() async throws {
+        func test(_ dbWriter: DatabaseWriter) async throws {
+            let isInsideTransaction = try await dbWriter.writeWithoutTransaction { db in
+                db.isInsideTransaction
+            }
+            XCTAssertFalse(isInsideTransaction)
+        }
+        
+        try await test(makeDatabaseQueue())
+        try await test(makeDatabasePool())
+    }
+}
+#endif
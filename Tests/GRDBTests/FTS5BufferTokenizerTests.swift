@@ -0,0 +1,82 @@
+#if SQLITE_ENABLE_FTS5
+import XCTest
+@testable import GRDB
+
+// A custom buffer tokenizer that splits text on commas
+private final class CommaTokenizer: FTS5BufferTokenizer {
+    static let name = "comma"
+    
+    init(db: Database, arguments: [String]) throws { }
+    
+    func tokenize(_ text: UnsafeBufferPointer<UInt8>, for tokenization: FTS5Tokenization, into tokens: inout FTS5TokenSink) throws {
+        var start = 0
+        for (index, byte) in text.enumerated() where byte == UInt8(ascii: ",") {
+            if start < index {
+                try tokens.append(start..<index)
+            }
+            start = index + 1
+        }
+        if start < text.count {
+            try tokens.append(start..<text.count)
+        }
+    }
+}
+
+// A custom buffer tokenizer that reverses space-separated words
+private final class ReversedTokenizer: FTS5BufferTokenizer {
+    static let name = "reversed"
+    
+    init(db: Database, arguments: [String]) throws { }
+    
+    func tokenize(_ text: UnsafeBufferPointer<UInt8>, for tokenization: FTS5Tokenization, into tokens: inout FTS5TokenSink) throws {
+        var start = 0
+        for index in 0...text.count where index == text.count || text[index] == UInt8(ascii: " ") {
+            if start < index {
+                try tokens.append(text[start..<index].reversed(), range: start..<index)
+            }
+            start = index + 1
+        }
+    }
+}
+
+class FTS5BufferTokenizerTests: GRDBTestCase {
+    func testBufferTokenizer() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            db.add(tokenizer: CommaTokenizer.self)
+            let tokenizer = try db.makeTokenizer(CommaTokenizer.tokenizerDescriptor())
+            XCTAssertEqual(try tokenizer.tokenize("", for: .document).map { $0.0 }, [])
+            XCTAssertEqual(try tokenizer.tokenize("foo bar,,baz,", for: .document).map { $0.0 }, ["foo bar", "baz"])
+            
+            try db.create(virtualTable: "documents", using: FTS5()) { t in
+                t.tokenizer = CommaTokenizer.tokenizerDescriptor()
+                t.column("content")
+            }
+            try db.execute(sql: "INSERT INTO documents VALUES (?)", arguments: ["foo bar,baz"])
+            XCTAssertEqual(try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM documents WHERE documents MATCH ?", arguments: ["\"foo bar\""]), 1)
+            XCTAssertEqual(try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM documents WHERE documents MATCH ?", arguments: ["foo"]), 0)
+            XCTAssertEqual(
+                try String.fetchOne(db, sql: "SELECT highlight(documents, 0, '[', ']') FROM documents WHERE documents MATCH ?", arguments: ["baz"]),
+                "foo bar,[baz]")
+        }
+    }
+    
+    func testBufferTokenizerWithModifiedTokens() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            db.add(tokenizer: ReversedTokenizer.self)
+            let tokenizer = try db.makeTokenizer(ReversedTokenizer.tokenizerDescriptor())
+            XCTAssertEqual(try tokenizer.tokenize("foo  bar", for: .document).map { $0.0 }, ["oof", "rab"])
+            
+            try db.create(virtualTable: "documents", using: FTS5()) { t in
+                t.tokenizer = ReversedTokenizer.tokenizerDescriptor()
+                t.column("content")
+            }
+            try db.execute(sql: "INSERT INTO documents VALUES (?)", arguments: ["foo bar"])
+            XCTAssertEqual(
+                try String.fetchOne(db, sql: "SELECT highlight(documents, 0, '[', ']') FROM documents WHERE documents MATCH ?", arguments: ["bar"]),
+                "foo [bar]")
+        }
+    }
+}
+#endif
@@ -0,0 +1,73 @@
+#if SQLITE_ENABLE_FTS5
+import XCTest
+@testable import GRDB
+
+class FTS5LatinTokenizerTests: GRDBTestCase {
+    private func tokens(_ db: Database, _ string: String, removeDiacritics: Bool = true) throws -> [String] {
+        let tokenizer = try db.makeTokenizer(FTS5LatinTokenizer.tokenizerDescriptor(removeDiacritics: removeDiacritics))
+        return try tokenizer.tokenize(string, for: .document).map { $0.0 }
+    }
+    
+    func testTokens() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            db.add(tokenizer: FTS5LatinTokenizer.self)
+            XCTAssertEqual(try tokens(db, ""), [])
+            XCTAssertEqual(try tokens(db, "  "), [])
+            XCTAssertEqual(try tokens(db, "Élève 42 Crème-BRÛLÉE"), ["eleve", "42", "creme", "brulee"])
+            XCTAssertEqual(try tokens(db, "Straße Æther þorn"), ["strasse", "aether", "thorn"])
+            XCTAssertEqual(try tokens(db, "foo_bar ¡hola! 3×4÷2 «oui»"), ["foo", "bar", "hola", "3", "4", "2", "oui"])
+            
+            // Characters outside of Latin-1 are left untouched
+            XCTAssertEqual(try tokens(db, "Ωmega 東京 Diyarbakır"), ["Ωmega", "東京", "diyarbakır"])
+        }
+    }
+    
+    func testLongTokens() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            db.add(tokenizer: FTS5LatinTokenizer.self)
+            XCTAssertEqual(
+                try tokens(db, "abcdefghijklmnopqrstuvwxyz0123456789 ABCDEFGHIJKLMNOPQRSTUVWXYZ hello, world! How are you?"),
+                ["abcdefghijklmnopqrstuvwxyz0123456789", "abcdefghijklmnopqrstuvwxyz", "hello", "world", "how", "are", "you"])
+            XCTAssertEqual(
+                try tokens(db, String(repeating: "a", count: 20) + "É" + String(repeating: "b", count: 20)),
+                [String(repeating: "a", count: 20) + "e" + String(repeating: "b", count: 20)])
+        }
+    }
+    
+    func testDiacriticsAreKept() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            db.add(tokenizer: FTS5LatinTokenizer.self)
+            XCTAssertEqual(try tokens(db, "Élève ÆSIR Straße 3×4", removeDiacritics: false), ["élève", "æsir", "straße", "3", "4"])
+        }
+    }
+    
+    func testInvalidArguments() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            db.add(tokenizer: FTS5LatinTokenizer.self)
+            XCTAssertThrowsError(try db.makeTokenizer(FTS5LatinTokenizer.tokenizerDescriptor(arguments: ["foo"])))
+            XCTAssertThrowsError(try db.makeTokenizer(FTS5LatinTokenizer.tokenizerDescriptor(arguments: ["remove_diacritics", "2"])))
+        }
+    }
+    
+    func testMatch() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            db.add(tokenizer: FTS5LatinTokenizer.self)
+            try db.create(virtualTable: "documents", using: FTS5()) { t in
+                t.tokenizer = FTS5LatinTokenizer.tokenizerDescriptor()
+                t.column("content")
+            }
+            try db.execute(sql: "INSERT INTO documents VALUES (?)", arguments: ["Élève au Café"])
+            XCTAssertEqual(try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM documents WHERE documents MATCH ?", arguments: ["ELEVE"]), 1)
+            XCTAssertEqual(try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM documents WHERE documents MATCH ?", arguments: ["caf*"]), 1)
+            XCTAssertEqual(
+                try String.fetchOne(db, sql: "SELECT highlight(documents, 0, '[', ']') FROM documents WHERE documents MATCH ?", arguments: ["cafe"]),
+                "Élève au [Café]")
+        }
+    }
+}
+#endif
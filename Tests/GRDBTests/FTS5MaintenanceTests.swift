@@ -0,0 +1,87 @@
+#if SQLITE_ENABLE_FTS5
+import XCTest
+import GRDB
+
+class FTS5MaintenanceTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.create(virtualTable: "documents", using: FTS5()) { t in
+                t.column("content")
+            }
+            // Prevent automatic merges, so that b-trees accumulate
+            try db.setFTS5MergeOption(.automerge(0), forTable: "documents")
+        }
+        for i in 0..<20 {
+            try dbWriter.write { db in
+                try db.execute(sql: "INSERT INTO documents VALUES (?)", arguments: ["foo \(i)"])
+            }
+        }
+    }
+    
+    private func matchCount(_ db: Database, _ pattern: String) throws -> Int? {
+        try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM documents WHERE documents MATCH ?", arguments: [pattern])
+    }
+    
+    func testMergeOptions() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try db.setFTS5MergeOption(.automerge(8), forTable: "documents")
+            try db.setFTS5MergeOption(.crisismerge(20), forTable: "documents")
+            try db.setFTS5MergeOption(.usermerge(2), forTable: "documents")
+            
+            let options = try Dictionary(uniqueKeysWithValues: Row
+                .fetchAll(db, sql: "SELECT k, v FROM documents_config")
+                .map { ($0["k"] as String, $0["v"] as Int?) })
+            XCTAssertEqual(options["automerge"], 8)
+            XCTAssertEqual(options["crisismerge"], 20)
+            XCTAssertEqual(options["usermerge"], 2)
+        }
+    }
+    
+    func testMerge() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            XCTAssertTrue(try db.mergeFTS5Index("documents", pageCount: 1000))
+            while try db.mergeFTS5Index("documents", pageCount: 1000) { }
+            XCTAssertFalse(try db.mergeFTS5Index("documents", pageCount: 1000))
+            XCTAssertEqual(try matchCount(db, "foo"), 20)
+        }
+    }
+    
+    func testOptimize() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try db.optimizeFTS5Index("documents")
+            XCTAssertFalse(try db.mergeFTS5Index("documents", pageCount: 1000))
+            XCTAssertEqual(try matchCount(db, "foo"), 20)
+        }
+    }
+    
+    func testRebuild() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try db.rebuildFTS5Index("documents")
+            XCTAssertEqual(try matchCount(db, "foo"), 20)
+        }
+    }
+    
+    func testAsyncMerge() throws {
+        let dbPool = try makeDatabasePool()
+        let expectation = self.expectation(description: "merge")
+        dbPool.asyncMergeFTS5Index("documents", pageCount: 1) { result in
+            if case let .failure(error) = result {
+                XCTFail("Unexpected error: \(error)")
+            }
+            expectation.fulfill()
+        }
+        waitForExpectations(timeout: 5, handler: nil)
+        
+        try dbPool.write { db in
+            XCTAssertFalse(try db.mergeFTS5Index("documents", pageCount: 1000))
+        }
+        try dbPool.read { db in
+            XCTAssertEqual(try matchCount(db, "foo"), 20)
+        }
+    }
+}
+#endif
@@ -19,6 +19,25 @@ class FetchRequestTests: GRDBTestCase {
         }
     }
     
+    func testRequestExists() throws {
+        let request: SQLRequest<Int> = "SELECT * FROM table1"
+        
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.create(table: "table1") { t in
+                t.column("id", .integer).primaryKey()
+            }
+            
+            try XCTAssertFalse(request.exists(db))
+            XCTAssertEqual(lastSQLQuery, "SELECT EXISTS (SELECT * FROM table1)")
+            try XCTAssertTrue(request.isEmpty(db))
+            
+            try db.execute(sql: "INSERT INTO table1 DEFAULT VALUES")
+            try XCTAssertTrue(request.exists(db))
+            try XCTAssertFalse(request.isEmpty(db))
+        }
+    }
+    
     func testRequestAsSQLExpression() throws {
         let request: SQLRequest<Int> = "SELECT id FROM table1"
         
@@ -1184,6 +1184,59 @@ extension FetchableRecordDecodableTests {
     }
 }
 
+// MARK: - Decoding Plan
+
+extension FetchableRecordDecodableTests {
+    func testDecodingPlanWithSeveralRows() throws {
+        struct Player: Decodable, FetchableRecord {
+            var id: Int64
+            var name: String
+            var score: Int?
+        }
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let statement = try db.makeSelectStatement(sql: """
+                SELECT 1 AS ID, 'Arthur' AS Name, 100 AS score
+                UNION ALL
+                SELECT 2, 'Barbara', NULL
+                """)
+            for _ in 0..<2 {
+                let players = try Player.fetchAll(statement)
+                XCTAssertEqual(players.count, 2)
+                XCTAssertEqual(players[0].id, 1)
+                XCTAssertEqual(players[0].name, "Arthur")
+                XCTAssertEqual(players[0].score, 100)
+                XCTAssertEqual(players[1].id, 2)
+                XCTAssertEqual(players[1].name, "Barbara")
+                XCTAssertNil(players[1].score)
+            }
+        }
+    }
+    
+    func testDecodingPlanWithSeveralRecordTypes() throws {
+        struct Record1: Decodable, FetchableRecord {
+            var a: String
+            var b: String
+        }
+        struct Record2: Decodable, FetchableRecord {
+            var b: String
+            var c: String?
+        }
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let statement = try db.makeSelectStatement(sql: "SELECT 'a' AS a, 'b' AS b")
+            for _ in 0..<2 {
+                let record1 = try Record1.fetchOne(statement)!
+                XCTAssertEqual(record1.a, "a")
+                XCTAssertEqual(record1.b, "b")
+                let record2 = try Record2.fetchOne(statement)!
+                XCTAssertEqual(record2.b, "b")
+                XCTAssertNil(record2.c)
+            }
+        }
+    }
+}
+
 fileprivate extension CodingUserInfoKey {
     static let testKey = CodingUserInfoKey(rawValue: "correct")!
 }
@@ -13,6 +13,28 @@ extension Fetched : FetchableRecord {
     }
 }
 
+/// A record that is updated in place, and counts its initializations
+private struct InPlaceRecord: FetchableRecord {
+    static var initCount = 0
+    var name: String
+    var teamName: String?
+    
+    init(name: String) {
+        self.name = name
+    }
+    
+    init(row: Row) {
+        InPlaceRecord.initCount += 1
+        name = row["name"]
+        teamName = row.scopes["team"]?["name"]
+    }
+    
+    mutating func decode(from row: Row) {
+        name = row["name"]
+        teamName = row.scopes["team"]?["name"]
+    }
+}
+
 class FetchableRecordTests: GRDBTestCase {
 
     func testRowInitializer() {
@@ -479,4 +501,75 @@ class FetchableRecordTests: GRDBTestCase {
             }
         }
     }
+    
+    func testCursorForEachInto() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let sql = "SELECT 'Arthur' AS name UNION ALL SELECT 'Barbara'"
+            var record = InPlaceRecord(name: "")
+            var names: [String] = []
+            InPlaceRecord.initCount = 0
+            let cursor = try InPlaceRecord.fetchCursor(db, sql: sql)
+            try cursor.forEach(into: &record) { record in
+                names.append(record.name)
+            }
+            XCTAssertEqual(names, ["Arthur", "Barbara"])
+            XCTAssertEqual(record.name, "Barbara")
+            XCTAssertEqual(InPlaceRecord.initCount, 0)
+            XCTAssertNil(try cursor.next())
+        }
+    }
+    
+    func testCursorForEachIntoWithDefaultImplementation() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let sql = "SELECT 'Arthur' AS firstName, 'Martin' AS lastName UNION ALL SELECT 'Barbara', 'Gourde'"
+            var record = Fetched(firstName: "", lastName: "")
+            var records: [Fetched] = []
+            try Fetched.fetchCursor(db, sql: sql).forEach(into: &record) { record in
+                records.append(record)
+            }
+            XCTAssertEqual(records, [
+                Fetched(firstName: "Arthur", lastName: "Martin"),
+                Fetched(firstName: "Barbara", lastName: "Gourde")])
+        }
+    }
+    
+    func testRequestForEachIntoWithScopes() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let sql = """
+                SELECT 'Arthur' AS name, 'Reds' AS name
+                UNION ALL SELECT 'Barbara', 'Blues'
+                """
+            let adapter = ScopeAdapter([
+                "team": SuffixRowAdapter(fromIndex: 1)])
+            let request = SQLRequest<InPlaceRecord>(sql: sql, adapter: adapter)
+            var record = InPlaceRecord(name: "")
+            var names: [String] = []
+            InPlaceRecord.initCount = 0
+            try request.forEach(db, into: &record) { record in
+                names.append("\(record.name)/\(record.teamName!)")
+            }
+            XCTAssertEqual(names, ["Arthur/Reds", "Barbara/Blues"])
+            XCTAssertEqual(InPlaceRecord.initCount, 0)
+        }
+    }
+    
+    func testCursorForEachIntoError() throws {
+        struct TestError: Error { }
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let sql = "SELECT 'Arthur' AS name UNION ALL SELECT 'Barbara'"
+            var record = InPlaceRecord(name: "")
+            do {
+                try InPlaceRecord.fetchCursor(db, sql: sql).forEach(into: &record) { record in
+                    throw TestError()
+                }
+                XCTFail("Expected error")
+            } catch is TestError {
+                XCTAssertEqual(record.name, "Arthur")
+            }
+        }
+    }
 }
@@ -314,6 +314,65 @@ class FoundationDateTests : GRDBTestCase {
         }
     }
     
+    func testDateStorageFormatMatchesCalendarDecoding() throws {
+        // Dates in the storage format are decoded without Calendar: the
+        // result must be the same as the one computed by Calendar.
+        var calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = TimeZone(secondsFromGMT: 0)!
+        let strings = [
+            "1970-01-01 00:00:00.000",
+            "1969-12-31 23:59:59.999",
+            "1583-01-01 00:00:00.000",
+            "2000-02-29 12:34:56.789",
+            "2018-04-20 14:47:12.345",
+            "2018-04-20T14:47:12.345",
+            "2100-02-28 23:59:59.001",
+            "9999-12-31 23:59:59.999",
+        ]
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            for string in strings {
+                let components = DatabaseDateComponents.fromDatabaseValue(string.databaseValue)!
+                let expectedDate = calendar.date(from: components.dateComponents)!
+                
+                let date = try Date.fetchOne(db, sql: "SELECT ?", arguments: [string])!
+                XCTAssertEqual(
+                    date.timeIntervalSinceReferenceDate,
+                    expectedDate.timeIntervalSinceReferenceDate,
+                    accuracy: 1e-6, string)
+                
+                let dbValueDate = Date.fromDatabaseValue(string.databaseValue)!
+                XCTAssertEqual(
+                    dbValueDate.timeIntervalSinceReferenceDate,
+                    expectedDate.timeIntervalSinceReferenceDate,
+                    accuracy: 1e-6, string)
+            }
+        }
+    }
+    
+    func testDateStorageFormatFallback() throws {
+        // Strings that look like the storage format, but require Calendar
+        var calendar = Calendar(identifier: .gregorian)
+        calendar.timeZone = TimeZone(secondsFromGMT: 0)!
+        let strings = [
+            "2018-02-30 00:00:00.000", // Invalid day
+            "1500-06-01 12:00:00.000", // Julian calendar
+        ]
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            for string in strings {
+                let components = DatabaseDateComponents.fromDatabaseValue(string.databaseValue)!
+                let expectedDate = calendar.date(from: components.dateComponents)!
+                let date = try Date.fetchOne(db, sql: "SELECT ?", arguments: [string])!
+                XCTAssertEqual(date, expectedDate, string)
+                XCTAssertEqual(Date.fromDatabaseValue(string.databaseValue), expectedDate, string)
+            }
+            
+            XCTAssertNil(try Date.fetchOne(db, sql: "SELECT ?", arguments: ["2018-04-20 14:47:12;345"]))
+            XCTAssertNil(Date.fromDatabaseValue("2018-04-2a 14:47:12.345".databaseValue))
+        }
+    }
+    
     func testJulianDaySQLFunction() throws {
         // 00:30:00.0 UT January 1, 2013 according to https://en.wikipedia.org/wiki/Julian_day
         let jdn = 2_456_293.520833
@@ -0,0 +1,20 @@
+import Foundation
+import XCTest
+
+extension GRDBTestCase {
+    /// Waits until condition is true, or fails after a timeout.
+    func waitUntil(
+        _ condition: () throws -> Bool,
+        file: StaticString = #file,
+        line: UInt = #line) rethrows
+    {
+        let deadline = Date().addingTimeInterval(5)
+        while try !condition() {
+            if Date() > deadline {
+                XCTFail("Timeout", file: file, line: line)
+                return
+            }
+            Thread.sleep(forTimeInterval: 0.01)
+        }
+    }
+}
@@ -0,0 +1,187 @@
+import XCTest
+import GRDB
+
+private struct Player: Codable, FetchableRecord, TableRecord, Equatable {
+    var id: Int64
+    var name: String
+    var score: Int?
+}
+
+class KeysetPaginationTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.execute(sql: "CREATE TABLE player(id INTEGER PRIMARY KEY, name TEXT NOT NULL, score INTEGER)")
+            let scores: [Int?] = [100, nil, 200, 100, nil, 300, 200, 100, nil, 400]
+            for (index, score) in scores.enumerated() {
+                try db.execute(
+                    sql: "INSERT INTO player(id, name, score) VALUES (?, ?, ?)",
+                    arguments: [index + 1, "Player \(index + 1)", score])
+            }
+        }
+    }
+    
+    /// Fetches all pages, and checks they contain the same players as the
+    /// full request.
+    private func assertPagesMatch(
+        _ db: Database,
+        _ request: QueryInterfaceRequest<Player>,
+        limit: Int,
+        file: StaticString = #file,
+        line: UInt = #line)
+    throws
+    {
+        var players: [Player] = []
+        var page = try request.fetchPage(db, limit: limit)
+        var pageCount = 1
+        players.append(contentsOf: page.elements)
+        while let token = page.nextPageToken {
+            XCTAssertEqual(page.elements.count, limit, file: file, line: line)
+            page = try request.fetchPage(db, after: token, limit: limit)
+            pageCount += 1
+            players.append(contentsOf: page.elements)
+        }
+        try XCTAssertEqual(players, request.fetchAll(db), file: file, line: line)
+        XCTAssertEqual(pageCount, (players.count + limit - 1) / limit, file: file, line: line)
+    }
+    
+    func testFetchPageAscending() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            try assertPagesMatch(db, Player.order(Column("id")), limit: 3)
+            try assertPagesMatch(db, Player.order(Column("score"), Column("id")), limit: 3)
+            try assertPagesMatch(db, Player.order(Column("score"), Column("id")), limit: 5)
+            try assertPagesMatch(db, Player.order(Column("score"), Column("id")), limit: 20)
+        }
+    }
+    
+    func testFetchPageDescending() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            try assertPagesMatch(db, Player.order(Column("id").desc), limit: 3)
+            try assertPagesMatch(db, Player.order(Column("score").desc, Column("id").desc), limit: 3)
+        }
+    }
+    
+    func testFetchPageMixedOrdering() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            try assertPagesMatch(db, Player.order(Column("score").desc, Column("id")), limit: 2)
+            try assertPagesMatch(db, Player.order(Column("score"), Column("id").desc), limit: 2)
+            try assertPagesMatch(db, Player.order(Column("score").desc, Column("name"), Column("id")), limit: 4)
+        }
+    }
+    
+    func testFetchPageNullsOrdering() throws {
+        #if GRDBCUSTOMSQLITE
+        let isAvailable = true
+        #elseif !GRDBCIPHER
+        var isAvailable = false
+        if #available(OSX 10.16, iOS 14, tvOS 14, watchOS 7, *) {
+            isAvailable = true
+        }
+        #else
+        let isAvailable = false
+        #endif
+        guard isAvailable else {
+            throw XCTSkip("NULLS FIRST/LAST are not available")
+        }
+        
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            try assertPagesMatch(db, Player.order(Column("score").ascNullsLast, Column("id")), limit: 2)
+            try assertPagesMatch(db, Player.order(Column("score").descNullsFirst, Column("id")), limit: 2)
+        }
+    }
+    
+    func testFetchPageFiltered() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            try assertPagesMatch(db, Player.filter(Column("score") != nil).order(Column("score").desc, Column("id")), limit: 2)
+        }
+    }
+    
+    func testNextPageToken() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let request = Player.order(Column("score").desc, Column("id"))
+            
+            let page = try request.fetchPage(db, limit: 4)
+            XCTAssertEqual(page.elements.map(\.id), [10, 6, 3, 7])
+            XCTAssertEqual(page.nextPageToken, KeysetPageToken(values: [200.databaseValue, 7.databaseValue]))
+            
+            let lastPage = try request.fetchPage(db, after: KeysetPageToken(values: [100.databaseValue, 8.databaseValue]), limit: 3)
+            XCTAssertEqual(lastPage.elements.map(\.id), [2, 5, 9])
+            XCTAssertNil(lastPage.nextPageToken)
+        }
+    }
+    
+    func testAfter() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            // Ascending, no NULL
+            do {
+                let token = KeysetPageToken(values: [100.databaseValue, 4.databaseValue])
+                let request = Player.order(Column("score"), Column("id")).after(token)
+                try XCTAssertEqual(request.fetchAll(db).map(\.id), [8, 3, 7, 6, 10])
+            }
+            // Ascending, NULL
+            do {
+                let token = KeysetPageToken(values: [DatabaseValue.null, 5.databaseValue])
+                let request = Player.order(Column("score"), Column("id")).after(token)
+                try XCTAssertEqual(request.fetchAll(db).map(\.id), [9, 1, 4, 8, 3, 7, 6, 10])
+            }
+            // Descending, NULL
+            do {
+                let token = KeysetPageToken(values: [DatabaseValue.null, 2.databaseValue])
+                let request = Player.order(Column("score").desc, Column("id")).after(token)
+                try XCTAssertEqual(request.fetchAll(db).map(\.id), [5, 9])
+            }
+            // Descending, last row
+            do {
+                let token = KeysetPageToken(values: [DatabaseValue.null, 9.databaseValue])
+                let request = Player.order(Column("score").desc, Column("id")).after(token)
+                try XCTAssertEqual(request.fetchAll(db), [])
+            }
+        }
+    }
+    
+    func testMalformedTokenThrows() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let request = Player.order(Column("score").desc, Column("id"))
+            let token = KeysetPageToken(values: [200.databaseValue])
+            do {
+                _ = try request.fetchPage(db, after: token, limit: 3)
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_MISUSE)
+            }
+            do {
+                _ = try request.after(token).fetchAll(db)
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_MISUSE)
+            }
+        }
+    }
+    
+    func testUnsupportedOrderingThrows() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            // Unordered request
+            do {
+                _ = try Player.all().fetchPage(db, limit: 3)
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_MISUSE)
+            }
+            // Ordering literal
+            do {
+                _ = try Player.order(sql: "id").fetchPage(db, limit: 3)
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_MISUSE)
+            }
+        }
+    }
+}
@@ -0,0 +1,64 @@
+import XCTest
+import GRDB
+
+class MemoryBudgetTests: GRDBTestCase {
+    func testNoTrimmingBelowSoftLimit() throws {
+        dbConfiguration.memoryBudget = MemoryBudget(
+            softLimit: Int.max,
+            hardLimit: Int.max,
+            checkInterval: 0.01)
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            _ = try db.cachedSelectStatement(sql: "SELECT 1")
+        }
+        Thread.sleep(forTimeInterval: 0.1)
+        try dbQueue.inDatabase { db in
+            XCTAssertEqual(db.statementCacheStatistics.evictionCount, 0)
+        }
+    }
+    
+    func testSoftLimitEvictsColdStatements() throws {
+        dbConfiguration.memoryBudget = MemoryBudget(
+            softLimit: 0,
+            hardLimit: Int.max,
+            checkInterval: 0.01)
+        let dbQueue = try makeDatabaseQueue()
+        let cacheSize = try dbQueue.inDatabase { db in
+            try Int.fetchOne(db, sql: "PRAGMA cache_size")!
+        }
+        try dbQueue.inDatabase { db in
+            _ = try db.cachedSelectStatement(sql: "SELECT 1")
+        }
+        try waitUntil {
+            try dbQueue.inDatabase { $0.statementCacheStatistics.evictionCount > 0 }
+        }
+        
+        // Page cache is not constrained
+        try XCTAssertEqual(dbQueue.inDatabase { try Int.fetchOne($0, sql: "PRAGMA cache_size")! }, cacheSize)
+    }
+    
+    func testHardLimitConstrainsPageCache() throws {
+        dbConfiguration.memoryBudget = MemoryBudget(
+            softLimit: 0,
+            hardLimit: 0,
+            constrainedCacheSize: -100,
+            checkInterval: 0.01)
+        let dbQueue = try makeDatabaseQueue()
+        try waitUntil {
+            try dbQueue.inDatabase { try Int.fetchOne($0, sql: "PRAGMA cache_size")! } == -100
+        }
+    }
+    
+    func testHardLimitClosesAvailableReaders() throws {
+        dbConfiguration.memoryBudget = MemoryBudget(
+            softLimit: 0,
+            hardLimit: 0,
+            checkInterval: 0.01)
+        let dbPool = try makeDatabasePool()
+        try dbPool.read { _ in }
+        waitUntil { dbPool.readerStatistics.readerCount == 0 }
+        
+        // Readers are opened again when needed
+        try XCTAssertEqual(dbPool.read { try Int.fetchOne($0, sql: "SELECT 1") }, 1)
+    }
+}
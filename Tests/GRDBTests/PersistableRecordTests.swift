@@ -737,6 +737,101 @@ class PersistableRecordTests: GRDBTestCase {
         }
     }
 
+    
+    // MARK: - Batch Insertion
+    
+    func testInsertAll() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let persons = (0..<10).map { PersistableRecordPerson(name: "Person\($0)", age: $0) }
+            sqlQueries.removeAll()
+            try PersistableRecordPerson.insertAll(db, persons, batchSize: 4)
+            
+            let insertQueries = sqlQueries.filter { $0.hasPrefix("INSERT") }
+            XCTAssertEqual(insertQueries.count, 3)
+            XCTAssertEqual(insertQueries.last, """
+                INSERT INTO "persons" ("name", "age") VALUES ('Person8',8), ('Person9',9)
+                """)
+            
+            let names = try String.fetchAll(db, sql: "SELECT name FROM persons ORDER BY id")
+            XCTAssertEqual(names, persons.map { $0.name! })
+        }
+    }
+    
+    func testInsertAllEmpty() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            sqlQueries.removeAll()
+            try PersistableRecordPerson.insertAll(db, [])
+            XCTAssertTrue(sqlQueries.filter { $0.hasPrefix("INSERT") }.isEmpty)
+        }
+    }
+    
+    func testInsertAllHonorsArgumentLimit() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let argumentLimit = Int(sqlite3_limit(db.sqliteConnection, SQLITE_LIMIT_VARIABLE_NUMBER, -1))
+            let personCount = argumentLimit // two columns per person: needs two statements
+            let persons = (0..<personCount).map { PersistableRecordPerson(name: "Person\($0)", age: $0) }
+            sqlQueries.removeAll()
+            try PersistableRecordPerson.insertAll(db, persons)
+            
+            XCTAssertEqual(sqlQueries.filter { $0.hasPrefix("INSERT") }.count, 2)
+            XCTAssertEqual(try PersistableRecordPerson.fetchCount(db), personCount)
+        }
+    }
+    
+    func testInsertAllWithConflictResolution() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try PersistableRecordCountry(isoCode: "FR", name: "France").insert(db)
+            
+            do {
+                try PersistableRecordCountry.insertAll(db, [
+                    PersistableRecordCountry(isoCode: "FR", name: "France Métropolitaine"),
+                    PersistableRecordCountry(isoCode: "US", name: "United States")])
+                XCTFail("Expected error")
+            } catch let error as DatabaseError {
+                XCTAssertEqual(error.resultCode, .SQLITE_CONSTRAINT)
+            }
+            
+            try PersistableRecordCountry.insertAll(db, [
+                PersistableRecordCountry(isoCode: "FR", name: "France Métropolitaine"),
+                PersistableRecordCountry(isoCode: "US", name: "United States")],
+                onConflict: .replace)
+            let names = try String.fetchAll(db, sql: "SELECT name FROM countries ORDER BY isoCode")
+            XCTAssertEqual(names, ["France Métropolitaine", "United States"])
+        }
+    }
+    
+    func testInsertAllWithHeterogeneousColumns() throws {
+        struct Person: PersistableRecord {
+            var name: String
+            var age: Int?
+            static let databaseTableName = "persons"
+            func encode(to container: inout PersistenceContainer) {
+                container["name"] = name
+                if let age = age {
+                    container["age"] = age
+                }
+            }
+        }
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: "DROP TABLE citizenships; DROP TABLE persons; CREATE TABLE persons (id INTEGER PRIMARY KEY, name TEXT, age INT)")
+            sqlQueries.removeAll()
+            try Person.insertAll(db, [
+                Person(name: "Arthur", age: 42),
+                Person(name: "Barbara", age: 36),
+                Person(name: "Craig", age: nil),
+                Person(name: "David", age: 12)])
+            XCTAssertEqual(sqlQueries.filter { $0.hasPrefix("INSERT") }, [
+                #"INSERT INTO "persons" ("name", "age") VALUES ('Arthur',42), ('Barbara',36)"#,
+                #"INSERT INTO "persons" ("name") VALUES ('Craig')"#,
+                #"INSERT INTO "persons" ("name", "age") VALUES ('David',12)"#])
+        }
+    }
+
 
     // MARK: - Errors
 
@@ -237,4 +237,64 @@ class PoolTests: XCTestCase {
         XCTAssertEqual(second.element, 2)
         second.release()
     }
+    
+    func testStatistics() throws {
+        let pool = makeCounterPool(maximumCount: 1)
+        XCTAssertEqual(pool.statistics.elementCount, 0)
+        XCTAssertEqual(pool.statistics.acquisitionCount, 0)
+        
+        let first = try pool.get()
+        XCTAssertEqual(pool.statistics.elementCount, 1)
+        XCTAssertEqual(pool.statistics.usedElementCount, 1)
+        XCTAssertEqual(pool.statistics.acquisitionCount, 1)
+        XCTAssertEqual(pool.statistics.waitCount, 0)
+        
+        // Wait for an available element
+        let s = DispatchSemaphore(value: 0)
+        DispatchQueue.global().async {
+            let second = try! pool.get()
+            second.release()
+            s.signal()
+        }
+        while pool.statistics.waitingCount == 0 {
+            Thread.sleep(forTimeInterval: 0.01)
+        }
+        first.release()
+        s.wait()
+        
+        let statistics = pool.statistics
+        XCTAssertEqual(statistics.elementCount, 1)
+        XCTAssertEqual(statistics.usedElementCount, 0)
+        XCTAssertEqual(statistics.waitingCount, 0)
+        XCTAssertEqual(statistics.acquisitionCount, 2)
+        XCTAssertEqual(statistics.waitCount, 1)
+        XCTAssertGreaterThan(statistics.totalWaitDuration, 0)
+        XCTAssertEqual(statistics.maximumWaitDuration, statistics.totalWaitDuration)
+    }
+    
+    func testIdleTimeout() throws {
+        let count = ReadWriteBox(wrappedValue: 0)
+        let pool = Pool(maximumCount: 2, idleTimeout: 0.1, makeElement: count.increment)
+        
+        let first = try pool.get()
+        XCTAssertEqual(first.element, 1)
+        let second = try pool.get()
+        XCTAssertEqual(second.element, 2)
+        first.release()
+        
+        // Used elements are not removed
+        Thread.sleep(forTimeInterval: 0.5)
+        XCTAssertEqual(pool.statistics.elementCount, 1)
+        XCTAssertEqual(pool.statistics.idleRemovalCount, 1)
+        
+        second.release()
+        Thread.sleep(forTimeInterval: 0.5)
+        XCTAssertEqual(pool.statistics.elementCount, 0)
+        XCTAssertEqual(pool.statistics.idleRemovalCount, 2)
+        
+        // Get new element
+        let third = try pool.get()
+        XCTAssertEqual(third.element, 3)
+        third.release()
+    }
 }
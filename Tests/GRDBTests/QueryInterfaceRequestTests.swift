@@ -13,6 +13,22 @@ private struct Reader : TableRecord {
 }
 private let tableRequest = Reader.all()
 
+private struct Book: TableRecord {
+    static let reader = belongsTo(Reader.self)
+}
+
+private struct WithoutRowID: TableRecord {
+    static let databaseTableName = "withoutRowID"
+}
+
+private struct RowID: TableRecord {
+    static let databaseTableName = "rowID"
+}
+
+private struct ReadersView: TableRecord {
+    static let databaseTableName = "readersView"
+}
+
 class QueryInterfaceRequestTests: GRDBTestCase {
     
     let collation = DatabaseCollation("localized_case_insensitive") { (lhs, rhs) in
@@ -105,13 +121,13 @@ class QueryInterfaceRequestTests: GRDBTestCase {
             XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM \"readers\"")
             
             XCTAssertEqual(try tableRequest.limit(10).fetchCount(db), 0)
-            XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM (SELECT * FROM \"readers\" LIMIT 10)")
+            XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM (SELECT 1 FROM \"readers\" LIMIT 10)")
             
             XCTAssertEqual(try tableRequest.filter(Col.age == 42).fetchCount(db), 0)
             XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM \"readers\" WHERE \"age\" = 42")
             
             XCTAssertEqual(try tableRequest.distinct().fetchCount(db), 0)
-            XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM (SELECT DISTINCT * FROM \"readers\")")
+            XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM \"readers\"")
             
             XCTAssertEqual(try tableRequest.select(Col.name).fetchCount(db), 0)
             XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM \"readers\"")
@@ -136,6 +152,120 @@ class QueryInterfaceRequestTests: GRDBTestCase {
         }
     }
     
+    func testFetchCountDistinctAllColumns() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: """
+                CREATE TABLE withoutRowID (a TEXT, b TEXT, PRIMARY KEY (a, b)) WITHOUT ROWID;
+                CREATE TABLE rowID (name TEXT);
+                CREATE VIEW readersView AS SELECT * FROM readers;
+                INSERT INTO rowID (name) VALUES ('Arthur'), ('Arthur');
+                """)
+            
+            // Rows are unique
+            XCTAssertEqual(try WithoutRowID.all().distinct().fetchCount(db), 0)
+            XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM \"withoutRowID\"")
+            
+            // Rows are not unique
+            XCTAssertEqual(try RowID.all().distinct().fetchCount(db), 1)
+            XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM (SELECT DISTINCT * FROM \"rowID\")")
+            
+            // Views have no primary key
+            XCTAssertEqual(try ReadersView.all().distinct().fetchCount(db), 0)
+            XCTAssertEqual(lastSQLQuery, "SELECT COUNT(*) FROM (SELECT DISTINCT * FROM \"readersView\")")
+        }
+    }
+    
+    func testFetchCountDistinctJoin() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: """
+                CREATE TABLE book (
+                    id INTEGER PRIMARY KEY,
+                    readerId INTEGER REFERENCES readers(id),
+                    title TEXT);
+                INSERT INTO readers (id, name, age) VALUES (1, 'Arthur', 42), (2, 'Barbara', 36);
+                INSERT INTO book (readerId, title) VALUES (1, 'Foo'), (1, 'Bar'), (NULL, 'Baz');
+                """)
+            
+            do {
+                let request = Book.joining(required: Book.reader).distinct()
+                XCTAssertEqual(try request.fetchCount(db), 2)
+                XCTAssertEqual(lastSQLQuery, """
+                    SELECT COUNT(DISTINCT "book"."id") FROM "book" \
+                    JOIN "readers" ON "readers"."id" = "book"."readerId"
+                    """)
+            }
+            do {
+                // Joined columns are selected
+                let request = Book.including(required: Book.reader).distinct()
+                XCTAssertEqual(try request.fetchCount(db), 2)
+                XCTAssertEqual(lastSQLQuery, """
+                    SELECT COUNT(*) FROM (SELECT DISTINCT "book".*, "readers".* FROM "book" \
+                    JOIN "readers" ON "readers"."id" = "book"."readerId")
+                    """)
+            }
+        }
+    }
+    
+    // MARK: - Exists
+    
+    func testExists() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            XCTAssertFalse(try tableRequest.exists(db))
+            XCTAssertEqual(lastSQLQuery, "SELECT EXISTS (SELECT 1 FROM \"readers\" LIMIT 1)")
+            XCTAssertTrue(try tableRequest.isEmpty(db))
+            
+            try db.execute(sql: "INSERT INTO readers (name, age) VALUES (?, ?)", arguments: ["Arthur", 42])
+            XCTAssertTrue(try tableRequest.exists(db))
+            XCTAssertFalse(try tableRequest.isEmpty(db))
+            
+            XCTAssertFalse(try tableRequest.filter(Col.age == 36).order(Col.name).exists(db))
+            XCTAssertEqual(lastSQLQuery, "SELECT EXISTS (SELECT 1 FROM \"readers\" WHERE \"age\" = 36 LIMIT 1)")
+            
+            XCTAssertTrue(try tableRequest.select(Col.name).distinct().exists(db))
+            XCTAssertEqual(lastSQLQuery, "SELECT EXISTS (SELECT 1 FROM \"readers\" LIMIT 1)")
+            
+            XCTAssertFalse(try tableRequest.limit(1, offset: 1).exists(db))
+            XCTAssertEqual(lastSQLQuery, "SELECT EXISTS (SELECT * FROM \"readers\" LIMIT 1 OFFSET 1)")
+            
+            XCTAssertFalse(try tableRequest.group(Col.name).having(count(Col.id) > 1).exists(db))
+            XCTAssertEqual(lastSQLQuery, """
+                SELECT EXISTS (SELECT * FROM "readers" GROUP BY "name" HAVING COUNT("id") > 1 LIMIT 1)
+                """)
+        }
+    }
+    
+    func testExistsWithDistinctAndOffset() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            try db.execute(sql: "INSERT INTO readers (name, age) VALUES (?, ?)", arguments: ["Arthur", 42])
+            try db.execute(sql: "INSERT INTO readers (name, age) VALUES (?, ?)", arguments: ["Arthur", 36])
+            
+            // One distinct name: the offset skips it.
+            let request = tableRequest.select(Col.name).distinct().limit(1, offset: 1)
+            XCTAssertFalse(try request.exists(db))
+            XCTAssertEqual(lastSQLQuery, """
+                SELECT EXISTS (SELECT DISTINCT "name" FROM "readers" LIMIT 1 OFFSET 1)
+                """)
+            XCTAssertTrue(try request.isEmpty(db))
+        }
+    }
+    
+    func testExistsWithAggregateSelection() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            // Aggregates fetch one row, even from an empty table.
+            let request = tableRequest.select(max(Col.age))
+            XCTAssertTrue(try request.exists(db))
+            XCTAssertEqual(lastSQLQuery, """
+                SELECT EXISTS (SELECT MAX("age") FROM "readers" LIMIT 1)
+                """)
+            XCTAssertFalse(try request.isEmpty(db))
+        }
+    }
+    
     
     // MARK: - Select
     
@@ -342,6 +342,27 @@ class AdapterRowTests : RowTestCase {
         }
     }
 
+    func testNestedScopesTree() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let adapter = ScopeAdapter([
+                "foo": RangeRowAdapter(0..<1).addingScopes([
+                    "bar": RangeRowAdapter(1..<2).addingScopes([
+                        "baz": RangeRowAdapter(2..<3)])]),
+                "baz": RangeRowAdapter(3..<4)])
+            let row = try Row.fetchOne(db, sql: "SELECT 1 AS a, 2 AS b, 3 AS c, 4 AS d", adapter: adapter)!
+            
+            XCTAssertEqual(row.scopesTree.names, ["foo", "bar", "baz"])
+            XCTAssertEqual(row.scopesTree["foo"]!, ["a": 1])
+            XCTAssertEqual(row.scopesTree["bar"]!, ["b": 2])
+            XCTAssertEqual(row.scopesTree["bar"]!.scopesTree["baz"]!, ["c": 3])
+            
+            // Breadth-first search
+            XCTAssertEqual(row.scopesTree["baz"]!, ["d": 4])
+            XCTAssertTrue(row.scopesTree["missing"] == nil)
+        }
+    }
+    
     func testMergeScopes() throws {
         let dbQueue = try makeDatabaseQueue()
         try dbQueue.inDatabase { db in
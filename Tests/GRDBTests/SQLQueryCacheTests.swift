@@ -0,0 +1,139 @@
+import XCTest
+import GRDB
+
+private struct Player: Codable, FetchableRecord, PersistableRecord {
+    var id: Int64
+    var name: String
+    var score: Int?
+}
+
+class SQLQueryCacheTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.create(table: "player") { t in
+                t.autoIncrementedPrimaryKey("id")
+                t.column("name", .text).notNull()
+                t.column("score", .integer)
+            }
+            try Player(id: 1, name: "Arthur", score: 1000).insert(db)
+            try Player(id: 2, name: "Barbara", score: 2000).insert(db)
+            try Player(id: 3, name: "Craig", score: nil).insert(db)
+        }
+    }
+    
+    func testRequestsWithDifferentValues() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            for (score, expectedNames) in [(0, ["Arthur", "Barbara"]), (1500, ["Barbara"]), (3000, [])] {
+                let request = Player
+                    .filter(Column("score") > score)
+                    .order(Column("name"))
+                XCTAssertEqual(try request.fetchAll(db).map(\.name), expectedNames)
+                XCTAssertEqual(lastSQLQuery, """
+                    SELECT * FROM "player" WHERE "score" > \(score) ORDER BY "name"
+                    """)
+            }
+        }
+    }
+    
+    func testNullValuesDoNotShareSQL() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let score: Int? = nil
+            XCTAssertEqual(try Player.filter(Column("score") == 1000).fetchAll(db).map(\.name), ["Arthur"])
+            XCTAssertEqual(try Player.filter(Column("score") == score).fetchAll(db).map(\.name), ["Craig"])
+            XCTAssertEqual(lastSQLQuery, """
+                SELECT * FROM "player" WHERE "score" IS NULL
+                """)
+        }
+    }
+    
+    func testFetchOneAndFetchAllDoNotShareSQL() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let request = Player.filter(Column("name") == "Arthur")
+            _ = try request.fetchAll(db)
+            XCTAssertEqual(lastSQLQuery, """
+                SELECT * FROM "player" WHERE "name" = 'Arthur'
+                """)
+            _ = try request.fetchOne(db)
+            XCTAssertEqual(lastSQLQuery, """
+                SELECT * FROM "player" WHERE "name" = 'Arthur' LIMIT 1
+                """)
+        }
+    }
+    
+    func testCollectionsOfDifferentSizes() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            XCTAssertEqual(try Player.fetchAll(db, keys: [1, 2]).map(\.name), ["Arthur", "Barbara"])
+            XCTAssertEqual(try Player.fetchAll(db, keys: [2, 3]).map(\.name), ["Barbara", "Craig"])
+            XCTAssertEqual(try Player.fetchAll(db, keys: [1, 2, 3]).map(\.name), ["Arthur", "Barbara", "Craig"])
+        }
+    }
+    
+    func testStatementIsReused() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let identifier: ObjectIdentifier
+            do {
+                let statement1 = try Player.filter(key: 1).makePreparedRequest(db).statement
+                identifier = ObjectIdentifier(statement1)
+                
+                // Statement is retained: a new one is compiled
+                let statement2 = try Player.filter(key: 2).makePreparedRequest(db).statement
+                XCTAssertTrue(statement1 !== statement2)
+                XCTAssertEqual(statement1.arguments, [1])
+                XCTAssertEqual(statement2.arguments, [2])
+            }
+            
+            // Statement is released: it is reused with new arguments
+            let statement3 = try Player.filter(key: 3).makePreparedRequest(db).statement
+            XCTAssertEqual(ObjectIdentifier(statement3), identifier)
+            XCTAssertEqual(statement3.arguments, [3])
+        }
+    }
+    
+    func testNestedIteration() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let request = Player.filter(Column("score") >= 0).order(Column("id"))
+            var names: [String] = []
+            let cursor = try request.fetchCursor(db)
+            while let player = try cursor.next() {
+                names.append(player.name)
+                // Same SQL, while the outer cursor is iterated
+                XCTAssertEqual(try Player.filter(Column("score") >= 1500).fetchCount(db), 1)
+                XCTAssertEqual(try request.fetchCount(db), 2)
+                XCTAssertEqual(try Player.filter(Column("score") >= 1500).order(Column("id")).fetchAll(db).map(\.name), ["Barbara"])
+            }
+            XCTAssertEqual(names, ["Arthur", "Barbara"])
+        }
+    }
+    
+    func testSelectedRegionIsOptimizedWithValues() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            XCTAssertEqual(try Player.filter(key: 1).databaseRegion(db).description, "player(id,name,score)[1]")
+            XCTAssertEqual(try Player.filter(key: 2).databaseRegion(db).description, "player(id,name,score)[2]")
+        }
+    }
+    
+    func testSchemaChange() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            let request = Player.filter(Column("name") == "Arthur")
+            _ = try request.fetchOne(db)
+            XCTAssertEqual(lastSQLQuery, """
+                SELECT * FROM "player" WHERE "name" = 'Arthur' LIMIT 1
+                """)
+            
+            // The name column becomes unique: LIMIT 1 is no longer needed
+            try db.create(index: "player_name", on: "player", columns: ["name"], unique: true)
+            _ = try request.fetchOne(db)
+            XCTAssertEqual(lastSQLQuery, """
+                SELECT * FROM "player" WHERE "name" = 'Arthur'
+                """)
+        }
+    }
+}
@@ -0,0 +1,65 @@
+import XCTest
+import GRDB
+
+class StatementCacheTests: GRDBTestCase {
+    func testDefaultCapacityIsUnbounded() throws {
+        XCTAssertNil(Configuration().statementCacheCapacity)
+        
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let initialStatistics = db.statementCacheStatistics
+            for i in 0..<100 {
+                _ = try db.cachedSelectStatement(sql: "SELECT \(i)")
+            }
+            let statistics = db.statementCacheStatistics
+            XCTAssertEqual(statistics.evictionCount, initialStatistics.evictionCount)
+            XCTAssertEqual(statistics.statementCount - initialStatistics.statementCount, 100)
+        }
+    }
+    
+    func testHitAndMissCounts() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let initialStatistics = db.statementCacheStatistics
+            let statement1 = try db.cachedSelectStatement(sql: "SELECT 1")
+            let statement2 = try db.cachedSelectStatement(sql: "SELECT 1")
+            _ = try db.cachedUpdateStatement(sql: "CREATE TABLE t(a)")
+            XCTAssertTrue(statement1 === statement2)
+            
+            let statistics = db.statementCacheStatistics
+            XCTAssertEqual(statistics.hitCount - initialStatistics.hitCount, 1)
+            XCTAssertEqual(statistics.missCount - initialStatistics.missCount, 2)
+            XCTAssertGreaterThan(statistics.prepareDuration, initialStatistics.prepareDuration)
+        }
+    }
+    
+    func testLeastRecentlyUsedEviction() throws {
+        dbConfiguration.statementCacheCapacity = 2
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let statement1 = try db.cachedSelectStatement(sql: "SELECT 1")
+            let statement2 = try db.cachedSelectStatement(sql: "SELECT 2")
+            
+            // Use statement1, so that statement2 becomes the least recently used
+            XCTAssertTrue(try db.cachedSelectStatement(sql: "SELECT 1") === statement1)
+            
+            // Evicts statement2
+            _ = try db.cachedUpdateStatement(sql: "CREATE TABLE t(a)")
+            XCTAssertTrue(try db.cachedSelectStatement(sql: "SELECT 1") === statement1)
+            XCTAssertFalse(try db.cachedSelectStatement(sql: "SELECT 2") === statement2)
+            XCTAssertLessThanOrEqual(db.statementCacheStatistics.statementCount, 4) // public + internal caches
+            XCTAssertGreaterThanOrEqual(db.statementCacheStatistics.evictionCount, 2)
+        }
+    }
+    
+    func testZeroCapacity() throws {
+        dbConfiguration.statementCacheCapacity = 0
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let statement1 = try db.cachedSelectStatement(sql: "SELECT 1")
+            let statement2 = try db.cachedSelectStatement(sql: "SELECT 1")
+            XCTAssertFalse(statement1 === statement2)
+            XCTAssertEqual(db.statementCacheStatistics.statementCount, 0)
+        }
+    }
+}
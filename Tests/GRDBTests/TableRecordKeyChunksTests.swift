@@ -0,0 +1,179 @@
+import XCTest
+import GRDB
+
+private struct Player: Codable, Hashable, FetchableRecord, PersistableRecord {
+    var id: Int64
+    var email: String
+}
+
+class TableRecordKeyChunksTests: GRDBTestCase {
+    override func setUp() {
+        super.setUp()
+        dbConfiguration.prepareDatabase { db in
+            // Force requests to be split in chunks of ten arguments
+            sqlite3_limit(db.sqliteConnection, SQLITE_LIMIT_VARIABLE_NUMBER, 10)
+        }
+    }
+    
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.create(table: "player") { t in
+                t.autoIncrementedPrimaryKey("id")
+                t.column("email", .text).notNull().unique()
+            }
+            for id in 1...25 {
+                try Player(id: Int64(id), email: "\(id)@example.com").insert(db)
+            }
+        }
+    }
+    
+    private func playerSelectionCount() -> Int {
+        sqlQueries.filter { $0.hasPrefix("SELECT * FROM \"player\"") }.count
+    }
+    
+    func testFetchAllWithPrimaryKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            sqlQueries = []
+            let players = try Player.fetchAll(db, keys: 0...30)
+            XCTAssertEqual(players.map(\.id).sorted(), Array(1...25))
+            XCTAssertEqual(playerSelectionCount(), 4)
+        }
+    }
+    
+    func testFetchAllWithRepeatedPrimaryKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            // Duplicates belong to distinct chunks
+            let keys = Array(1...25) + Array(1...25)
+            
+            sqlQueries = []
+            let players = try Player.fetchAll(db, keys: keys)
+            XCTAssertEqual(players.map(\.id).sorted(), Array(1...25))
+            XCTAssertEqual(playerSelectionCount(), 3)
+        }
+    }
+    
+    func testFetchSetWithPrimaryKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let players = try Player.fetchSet(db, keys: Array(1...25) + Array(1...25))
+            XCTAssertEqual(Set(players.map(\.id)), Set(1...25))
+        }
+    }
+    
+    func testFetchCursorWithPrimaryKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            sqlQueries = []
+            let cursor: RecordCursor<Player> = try Player.fetchCursor(db, keys: 1...10)
+            XCTAssertEqual(try cursor.map(\.id).reduce(0, +), 55)
+            XCTAssertEqual(playerSelectionCount(), 1)
+        }
+    }
+    
+    func testFetchChunkedCursorWithPrimaryKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            sqlQueries = []
+            let cursor = Player.fetchChunkedCursor(db, keys: 1...25)
+            
+            // Chunks are fetched when the cursor reaches them
+            XCTAssertNotNil(try cursor.next())
+            XCTAssertEqual(playerSelectionCount(), 1)
+            
+            var ids: Set<Int64> = [1]
+            while let player = try cursor.next() {
+                ids.insert(player.id)
+            }
+            XCTAssertEqual(ids, Set(1...25))
+            XCTAssertEqual(playerSelectionCount(), 3)
+        }
+    }
+    
+    func testDeleteAllWithPrimaryKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            let deletedCount = try Player.deleteAll(db, keys: 2...30)
+            XCTAssertEqual(deletedCount, 24)
+            XCTAssertEqual(try Player.fetchAll(db).map(\.id), [1])
+        }
+    }
+    
+    func testDeleteAllWithPrimaryKeysIsAtomic() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.writeWithoutTransaction { db in
+            try db.execute(sql: """
+                CREATE TRIGGER player_delete BEFORE DELETE ON player
+                WHEN OLD.id = 25
+                BEGIN
+                    SELECT RAISE(ABORT, 'forbidden');
+                END
+                """)
+            do {
+                try Player.deleteAll(db, keys: 1...25)
+                XCTFail("Expected error")
+            } catch DatabaseError.SQLITE_CONSTRAINT {
+            }
+            XCTAssertEqual(try Player.fetchCount(db), 25)
+        }
+    }
+    
+    func testFetchWithUniqueKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let keys: [[String: DatabaseValueConvertible?]] = (1...25).map { ["email": "\($0)@example.com"] }
+            
+            sqlQueries = []
+            let players = try Player.fetchAll(db, keys: keys)
+            XCTAssertEqual(players.map(\.id).sorted(), Array(1...25))
+            XCTAssertEqual(playerSelectionCount(), 3)
+            
+            XCTAssertEqual(try Player.fetchSet(db, keys: keys).count, 25)
+            XCTAssertEqual(try Player.fetchChunkedCursor(db, keys: keys).map(\.id).reduce(0, +), 325)
+        }
+    }
+    
+    func testFetchAllWithRepeatedUniqueKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            let keys: [[String: DatabaseValueConvertible?]] = (Array(1...25) + Array(1...25)).map { ["email": "\($0)@example.com"] }
+            let players = try Player.fetchAll(db, keys: keys)
+            XCTAssertEqual(players.map(\.id).sorted(), Array(1...25))
+        }
+    }
+    
+    func testFetchWithUniqueKeysAndNilValues() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            // Nil values do not consume any statement argument
+            let keys: [[String: DatabaseValueConvertible?]] = [["email": nil]] + (1...10).map { ["email": "\($0)@example.com"] }
+            
+            sqlQueries = []
+            let players = try Player.fetchAll(db, keys: keys)
+            XCTAssertEqual(players.count, 10)
+            XCTAssertEqual(playerSelectionCount(), 1)
+        }
+    }
+    
+    func testDeleteAllWithUniqueKeys() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            let keys: [[String: DatabaseValueConvertible?]] = (2...25).map { ["email": "\($0)@example.com"] }
+            let deletedCount = try Player.deleteAll(db, keys: keys)
+            XCTAssertEqual(deletedCount, 24)
+            XCTAssertEqual(try Player.fetchAll(db).map(\.id), [1])
+        }
+    }
+    
+    func testManyUniqueKeysDoNotExceedExpressionDepth() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.read { db in
+            sqlite3_limit(db.sqliteConnection, SQLITE_LIMIT_VARIABLE_NUMBER, 999)
+            
+            // More keys than the default SQLITE_MAX_EXPR_DEPTH (1000)
+            let keys: [[String: DatabaseValueConvertible?]] = (1...3000).map { ["email": "\($0)@example.com"] }
+            XCTAssertEqual(try Player.fetchAll(db, keys: keys).count, 25)
+        }
+    }
+}
@@ -0,0 +1,217 @@
+import XCTest
+import GRDB
+
+private class ChangeSetObserver: TransactionChangeSetObserver {
+    var observedTableName: String?
+    var commitError: Error?
+    var changes: DatabaseChangeSet?
+    var committedChanges: [DatabaseChangeSet] = []
+    var rollbackCount = 0
+    
+    init(observedTableName: String? = nil) {
+        self.observedTableName = observedTableName
+    }
+    
+    func observes(eventsOfKind eventKind: DatabaseEventKind) -> Bool {
+        observedTableName.map { $0 == eventKind.tableName } ?? true
+    }
+    
+    func databaseWillCommit(with changes: DatabaseChangeSet) throws {
+        if let commitError = commitError {
+            throw commitError
+        }
+        self.changes = changes
+    }
+    
+    func databaseDidCommit(_ db: Database) {
+        if let changes = changes {
+            committedChanges.append(changes)
+        }
+        changes = nil
+    }
+    
+    func databaseDidRollback(_ db: Database) {
+        rollbackCount += 1
+        changes = nil
+    }
+}
+
+private class EventObserver: TransactionObserver {
+    var events: [DatabaseEvent] = []
+    
+    func observes(eventsOfKind eventKind: DatabaseEventKind) -> Bool { true }
+    func databaseDidChange(with event: DatabaseEvent) { events.append(event.copy()) }
+    func databaseDidCommit(_ db: Database) { }
+    func databaseDidRollback(_ db: Database) { }
+}
+
+class TransactionChangeSetObserverTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.execute(sql: """
+                CREATE TABLE player(id INTEGER PRIMARY KEY, name TEXT);
+                CREATE TABLE team(id INTEGER PRIMARY KEY, name TEXT);
+                """)
+        }
+    }
+    
+    func testChangesAreNotifiedOnCommit() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let observer = ChangeSetObserver()
+        dbQueue.add(transactionObserver: observer)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: """
+                INSERT INTO player(id, name) VALUES (1, 'Arthur');
+                INSERT INTO player(id, name) VALUES (2, 'Barbara');
+                INSERT INTO team(id, name) VALUES (1, 'Reds');
+                """)
+            XCTAssertNil(observer.changes)
+        }
+        
+        XCTAssertEqual(observer.committedChanges.count, 1)
+        let changes = observer.committedChanges[0]
+        XCTAssertEqual(Array(changes), [
+            DatabaseChange(kind: .insert, databaseName: "main", tableName: "player", rowID: 1),
+            DatabaseChange(kind: .insert, databaseName: "main", tableName: "player", rowID: 2),
+            DatabaseChange(kind: .insert, databaseName: "main", tableName: "team", rowID: 1),
+        ])
+        XCTAssertEqual(changes.tableNames, ["player", "team"])
+        XCTAssertEqual(changes.rowIDs(in: "player"), [1, 2])
+        XCTAssertEqual(changes.rowIDs(in: "team"), [1])
+        XCTAssertEqual(changes.rowIDs(in: "missing"), [])
+    }
+    
+    func testChangesAreDeduplicated() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try db.execute(sql: """
+                INSERT INTO player(id, name) VALUES (1, 'Arthur');
+                INSERT INTO player(id, name) VALUES (2, 'Barbara');
+                """)
+        }
+        
+        let observer = ChangeSetObserver()
+        dbQueue.add(transactionObserver: observer)
+        try dbQueue.write { db in
+            try db.execute(sql: """
+                UPDATE player SET name = 'Arthur2' WHERE id = 1;
+                UPDATE player SET name = 'Arthur3' WHERE id = 1;
+                DELETE FROM player WHERE id = 2;
+                INSERT INTO player(id, name) VALUES (2, 'Barbara2');
+                INSERT INTO player(id, name) VALUES (3, 'Craig');
+                UPDATE player SET name = 'Craig2' WHERE id = 3;
+                INSERT INTO player(id, name) VALUES (4, 'David');
+                DELETE FROM player WHERE id = 4;
+                """)
+        }
+        
+        XCTAssertEqual(observer.committedChanges.count, 1)
+        XCTAssertEqual(Array(observer.committedChanges[0]), [
+            DatabaseChange(kind: .update, databaseName: "main", tableName: "player", rowID: 1),
+            DatabaseChange(kind: .update, databaseName: "main", tableName: "player", rowID: 2),
+            DatabaseChange(kind: .insert, databaseName: "main", tableName: "player", rowID: 3),
+            DatabaseChange(kind: .delete, databaseName: "main", tableName: "player", rowID: 4),
+        ])
+    }
+    
+    func testObservedEventKinds() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let observer = ChangeSetObserver(observedTableName: "team")
+        dbQueue.add(transactionObserver: observer)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: """
+                INSERT INTO player(id, name) VALUES (1, 'Arthur');
+                INSERT INTO team(id, name) VALUES (1, 'Reds');
+                """)
+        }
+        
+        XCTAssertEqual(observer.committedChanges.count, 1)
+        XCTAssertEqual(observer.committedChanges[0].tableNames, ["team"])
+        XCTAssertEqual(observer.committedChanges[0].count, 1)
+    }
+    
+    func testRollbackedSavepointChangesAreNotNotified() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let observer = ChangeSetObserver()
+        dbQueue.add(transactionObserver: observer)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO player(id, name) VALUES (1, 'Arthur')")
+            try db.inSavepoint {
+                try db.execute(sql: "INSERT INTO player(id, name) VALUES (2, 'Barbara')")
+                try db.inSavepoint {
+                    try db.execute(sql: "INSERT INTO player(id, name) VALUES (3, 'Craig')")
+                    return .rollback
+                }
+                return .commit
+            }
+            try db.inSavepoint {
+                try db.execute(sql: "INSERT INTO player(id, name) VALUES (4, 'David')")
+                return .rollback
+            }
+        }
+        
+        XCTAssertEqual(observer.committedChanges.count, 1)
+        XCTAssertEqual(observer.committedChanges[0].rowIDs(in: "player"), [1, 2])
+    }
+    
+    func testRollbackedTransactionChangesAreNotNotified() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let observer = ChangeSetObserver()
+        dbQueue.add(transactionObserver: observer)
+        
+        try dbQueue.inTransaction { db in
+            try db.execute(sql: "INSERT INTO player(id, name) VALUES (1, 'Arthur')")
+            return .rollback
+        }
+        XCTAssertEqual(observer.rollbackCount, 1)
+        XCTAssertTrue(observer.committedChanges.isEmpty)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO player(id, name) VALUES (2, 'Barbara')")
+        }
+        XCTAssertEqual(observer.committedChanges.count, 1)
+        XCTAssertEqual(observer.committedChanges[0].rowIDs(in: "player"), [2])
+    }
+    
+    func testErrorRollbacksTransaction() throws {
+        struct TestError: Error { }
+        let dbQueue = try makeDatabaseQueue()
+        let observer = ChangeSetObserver()
+        observer.commitError = TestError()
+        dbQueue.add(transactionObserver: observer)
+        
+        do {
+            try dbQueue.write { db in
+                try db.execute(sql: "INSERT INTO player(id, name) VALUES (1, 'Arthur')")
+            }
+            XCTFail("Expected error")
+        } catch is TestError {
+        }
+        XCTAssertEqual(observer.rollbackCount, 1)
+        try XCTAssertEqual(dbQueue.read { try Int.fetchOne($0, sql: "SELECT COUNT(*) FROM player") }, 0)
+    }
+    
+    func testChangeSetObserversAndRegularObservers() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let changeSetObserver = ChangeSetObserver()
+        let eventObserver = EventObserver()
+        dbQueue.add(transactionObserver: changeSetObserver)
+        dbQueue.add(transactionObserver: eventObserver)
+        
+        try dbQueue.write { db in
+            for id in 1...1000 {
+                try db.execute(sql: "INSERT INTO player(id, name) VALUES (?, 'Arthur')", arguments: [id])
+            }
+            try db.execute(sql: "UPDATE player SET name = 'Barbara'")
+        }
+        
+        XCTAssertEqual(eventObserver.events.count, 2000)
+        XCTAssertEqual(changeSetObserver.committedChanges.count, 1)
+        let changes = changeSetObserver.committedChanges[0]
+        XCTAssertEqual(changes.count, 1000)
+        XCTAssertTrue(changes.allSatisfy { $0.kind == .insert })
+    }
+}
@@ -0,0 +1,144 @@
+import XCTest
+@testable import GRDB
+
+private class RegionObserver: DatabaseRegionTransactionObserver {
+    let name: String
+    var observedRegion: DatabaseRegion?
+    var observesCount = 0
+    var changeCount = 0
+    var log: LockedBox<[String]>
+    
+    init(_ name: String, region: DatabaseRegion?, log: LockedBox<[String]>) {
+        self.name = name
+        self.observedRegion = region
+        self.log = log
+    }
+    
+    func observes(eventsOfKind eventKind: DatabaseEventKind) -> Bool {
+        observesCount += 1
+        return observedRegion.map { $0.isModified(byEventsOfKind: eventKind) } ?? true
+    }
+    
+    func databaseDidChange(with event: DatabaseEvent) {
+        changeCount += 1
+        log.wrappedValue.append(name)
+    }
+    
+    func databaseDidCommit(_ db: Database) { }
+    func databaseDidRollback(_ db: Database) { }
+}
+
+class TransactionObservationIndexTests: GRDBTestCase {
+    override func setup(_ dbWriter: DatabaseWriter) throws {
+        try dbWriter.write { db in
+            try db.execute(sql: """
+                CREATE TABLE player(id INTEGER PRIMARY KEY, name TEXT);
+                CREATE TABLE team(id INTEGER PRIMARY KEY, name TEXT);
+                CREATE TABLE award(id INTEGER PRIMARY KEY, name TEXT);
+                """)
+        }
+    }
+    
+    func testOnlyObserversOfModifiedTablesAreQueried() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let log = LockedBox<[String]>(wrappedValue: [])
+        let playerObservers = (0..<100).map { RegionObserver("player\($0)", region: DatabaseRegion(table: "player"), log: log) }
+        let teamObserver = RegionObserver("team", region: DatabaseRegion(table: "TEAM"), log: log)
+        for observer in playerObservers {
+            dbQueue.add(transactionObserver: observer)
+        }
+        dbQueue.add(transactionObserver: teamObserver)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO team(id, name) VALUES (1, 'Reds')")
+        }
+        XCTAssertTrue(playerObservers.allSatisfy { $0.observesCount == 0 })
+        XCTAssertEqual(teamObserver.observesCount, 1)
+        XCTAssertEqual(teamObserver.changeCount, 1)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO award(id, name) VALUES (1, 'Gold')")
+        }
+        XCTAssertTrue(playerObservers.allSatisfy { $0.observesCount == 0 })
+        XCTAssertEqual(teamObserver.observesCount, 1)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO player(id, name) VALUES (1, 'Arthur')")
+        }
+        XCTAssertTrue(playerObservers.allSatisfy { $0.observesCount == 1 && $0.changeCount == 1 })
+        XCTAssertEqual(teamObserver.observesCount, 1)
+    }
+    
+    func testUnindexedObserversAreAlwaysQueried() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let log = LockedBox<[String]>(wrappedValue: [])
+        let unknownRegionObserver = RegionObserver("unknown", region: nil, log: log)
+        let fullDatabaseObserver = RegionObserver("full", region: .fullDatabase, log: log)
+        let emptyRegionObserver = RegionObserver("empty", region: DatabaseRegion(), log: log)
+        dbQueue.add(transactionObserver: unknownRegionObserver)
+        dbQueue.add(transactionObserver: fullDatabaseObserver)
+        dbQueue.add(transactionObserver: emptyRegionObserver)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO award(id, name) VALUES (1, 'Gold')")
+        }
+        XCTAssertEqual(unknownRegionObserver.changeCount, 1)
+        XCTAssertEqual(fullDatabaseObserver.changeCount, 1)
+        XCTAssertEqual(emptyRegionObserver.observesCount, 0)
+    }
+    
+    func testObserversAreNotifiedInRegistrationOrder() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let log = LockedBox<[String]>(wrappedValue: [])
+        let observers = [
+            RegionObserver("team", region: DatabaseRegion(table: "team"), log: log),
+            RegionObserver("full", region: .fullDatabase, log: log),
+            RegionObserver("player+team", region: DatabaseRegion(table: "player").union(DatabaseRegion(table: "team")), log: log),
+            RegionObserver("player", region: DatabaseRegion(table: "player"), log: log),
+        ]
+        for observer in observers {
+            dbQueue.add(transactionObserver: observer)
+        }
+        
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO player(id, name) VALUES (1, 'Arthur')")
+        }
+        XCTAssertEqual(log.wrappedValue, ["full", "player+team", "player"])
+    }
+    
+    func testObserversOfSeveralModifiedTablesAreNotifiedOnce() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let log = LockedBox<[String]>(wrappedValue: [])
+        let observer = RegionObserver("player+team", region: DatabaseRegion(table: "player").union(DatabaseRegion(table: "team")), log: log)
+        dbQueue.add(transactionObserver: observer)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: """
+                CREATE TRIGGER player_insert AFTER INSERT ON player
+                BEGIN
+                    INSERT INTO team(id, name) VALUES (NEW.id, NEW.name);
+                END
+                """)
+            try db.execute(sql: "INSERT INTO player(id, name) VALUES (1, 'Arthur')")
+        }
+        XCTAssertEqual(observer.changeCount, 2)
+    }
+    
+    func testObservedRegionChange() throws {
+        let dbQueue = try makeDatabaseQueue()
+        let log = LockedBox<[String]>(wrappedValue: [])
+        let observer = RegionObserver("observer", region: DatabaseRegion(table: "player"), log: log)
+        dbQueue.add(transactionObserver: observer)
+        
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO team(id, name) VALUES (1, 'Reds')")
+            XCTAssertEqual(observer.observesCount, 0)
+            
+            observer.observedRegion = DatabaseRegion(table: "team")
+            db.observationBroker.observedRegionDidChange()
+            try db.execute(sql: "INSERT INTO team(id, name) VALUES (2, 'Blues')")
+            XCTAssertEqual(observer.observesCount, 1)
+            XCTAssertEqual(observer.changeCount, 1)
+        }
+    }
+}
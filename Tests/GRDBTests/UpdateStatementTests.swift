@@ -376,4 +376,51 @@ class UpdateStatementTests : GRDBTestCase {
             XCTAssertEqual(value, 3)
         }
     }
+    
+    func testExecuteBindings() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inTransaction { db in
+            let statement = try db.makeUpdateStatement(sql: "INSERT INTO persons (name, age) VALUES (?, ?)")
+            let age: Int? = nil
+            try statement.execute(bindings: "Arthur", 41)
+            try statement.execute(bindings: "Barbara", age)
+            try statement.execute(bindings: ["Craig", 32])
+            XCTAssertEqual(statement.arguments, [])
+            return .commit
+        }
+        
+        try dbQueue.inDatabase { db in
+            let rows = try Row.fetchAll(db, sql: "SELECT name, age FROM persons ORDER BY name")
+            XCTAssertEqual(rows, [
+                ["name": "Arthur", "age": 41],
+                ["name": "Barbara", "age": nil],
+                ["name": "Craig", "age": 32]])
+        }
+    }
+    
+    func testExecuteBindingsWithNamedArguments() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let statement = try db.makeUpdateStatement(sql: "INSERT INTO persons (name, age) VALUES (:name, :age)")
+            try statement.execute(bindings: "Arthur", 41)
+            let row = try Row.fetchOne(db, sql: "SELECT name, age FROM persons")
+            XCTAssertEqual(row, ["name": "Arthur", "age": 41])
+        }
+    }
+    
+    func testExecuteBindingsAfterArguments() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.inDatabase { db in
+            let statement = try db.makeUpdateStatement(sql: "INSERT INTO persons (name, age) VALUES (?, ?)")
+            try statement.execute(arguments: ["Arthur", 41])
+            // Previous bindings are cleared
+            try statement.execute(bindings: "Barbara", nil)
+            try statement.execute(arguments: ["Craig", 32])
+            let rows = try Row.fetchAll(db, sql: "SELECT name, age FROM persons ORDER BY name")
+            XCTAssertEqual(rows, [
+                ["name": "Arthur", "age": 41],
+                ["name": "Barbara", "age": nil],
+                ["name": "Craig", "age": 32]])
+        }
+    }
 }
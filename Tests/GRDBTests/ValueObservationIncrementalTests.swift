@@ -0,0 +1,179 @@
+import XCTest
+import GRDB
+
+private struct Player: Equatable {
+    var id: Int64
+    var name: String
+    var score: Int
+}
+
+extension Player: TableRecord, FetchableRecord {
+    static let databaseTableName = "t"
+    init(row: Row) {
+        self.init(id: row["id"], name: row["name"], score: row["score"])
+    }
+}
+
+class ValueObservationIncrementalTests: GRDBTestCase {
+    private func setup(_ db: Database) throws {
+        try db.execute(sql: "CREATE TABLE t(id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT, score INTEGER)")
+    }
+    
+    func testAll() throws {
+        try assertValueObservation(
+            ValueObservation
+                .trackingIncrementally(Player.all())
+                .map { $0.recordsByRowID.values.sorted { $0.id < $1.id } },
+            records: [
+                [],
+                [Player(id: 1, name: "foo", score: 0)],
+                [Player(id: 1, name: "foo", score: 0)],
+                [Player(id: 1, name: "foo", score: 0), Player(id: 2, name: "bar", score: 0)],
+                [Player(id: 2, name: "bar", score: 0)]],
+            setup: setup,
+            recordedUpdates: { db in
+                try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (1, 'foo', 0)")
+                try db.execute(sql: "UPDATE t SET name = 'foo' WHERE id = 1")
+                try db.inTransaction {
+                    try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (2, 'bar', 0)")
+                    try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (3, 'baz', 0)")
+                    try db.execute(sql: "DELETE FROM t WHERE id = 3")
+                    return .commit
+                }
+                try db.execute(sql: "DELETE FROM t WHERE id = 1")
+        })
+    }
+    
+    func testFilteredRequest() throws {
+        try assertValueObservation(
+            ValueObservation
+                .trackingIncrementally(Player.filter(Column("score") > 10))
+                .map { $0.recordsByRowID.values.sorted { $0.id < $1.id } },
+            records: [
+                [],
+                [Player(id: 1, name: "foo", score: 20)],
+                [Player(id: 1, name: "foo", score: 20), Player(id: 3, name: "baz", score: 30)],
+                [Player(id: 3, name: "baz", score: 30)]],
+            setup: setup,
+            recordedUpdates: { db in
+                try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (1, 'foo', 20)")
+                // Not notified: the row does not match the request
+                try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (2, 'bar', 0)")
+                try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (3, 'baz', 30)")
+                // The row no longer matches the request
+                try db.execute(sql: "UPDATE t SET score = 0 WHERE id = 1")
+        })
+    }
+    
+    func testUpdatedAndDeletedRowIDs() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write(setup)
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (1, 'foo', 0)")
+            try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (2, 'bar', 0)")
+        }
+        let observation = ValueObservation.trackingIncrementally(Player.all())
+        
+        let recorder = observation.record(in: dbQueue)
+        try dbQueue.writeWithoutTransaction { db in
+            try db.execute(sql: "UPDATE t SET score = 1 WHERE id = 2")
+            try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (3, 'baz', 0)")
+            try db.execute(sql: "DELETE FROM t WHERE id = 1")
+        }
+        let results = try wait(for: recorder.next(4), timeout: 1)
+        
+        XCTAssertEqual(results[0].updatedRowIDs, [1, 2])
+        XCTAssertEqual(results[0].deletedRowIDs, [])
+        
+        XCTAssertEqual(results[1].updatedRowIDs, [2])
+        XCTAssertEqual(results[1].deletedRowIDs, [])
+        XCTAssertEqual(results[1].recordsByRowID[2], Player(id: 2, name: "bar", score: 1))
+        
+        XCTAssertEqual(results[2].updatedRowIDs, [3])
+        XCTAssertEqual(results[2].deletedRowIDs, [])
+        XCTAssertEqual(Set(results[2].recordsByRowID.keys), [1, 2, 3])
+        
+        XCTAssertEqual(results[3].updatedRowIDs, [])
+        XCTAssertEqual(results[3].deletedRowIDs, [1])
+        XCTAssertEqual(Set(results[3].recordsByRowID.keys), [2, 3])
+    }
+    
+    func testRowIDUpdateTriggersFullFetch() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write(setup)
+        try dbQueue.write { db in
+            try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (1, 'foo', 0)")
+            try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (2, 'bar', 0)")
+        }
+        let observation = ValueObservation.trackingIncrementally(Player.all())
+        
+        let recorder = observation.record(in: dbQueue)
+        try dbQueue.write { db in
+            try db.execute(sql: "UPDATE t SET id = 10 WHERE id = 1")
+        }
+        let results = try wait(for: recorder.next(2), timeout: 1)
+        
+        XCTAssertEqual(results[1].updatedRowIDs, [2, 10])
+        XCTAssertEqual(results[1].deletedRowIDs, [1])
+        XCTAssertEqual(results[1].recordsByRowID[10], Player(id: 10, name: "foo", score: 0))
+    }
+    
+    func testRowsDeletedByReplaceConflict() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try db.execute(sql: """
+                CREATE TABLE t(id INTEGER PRIMARY KEY AUTOINCREMENT, name TEXT UNIQUE, score INTEGER);
+                INSERT INTO t (id, name, score) VALUES (1, 'foo', 0);
+                INSERT INTO t (id, name, score) VALUES (2, 'bar', 0);
+                """)
+        }
+        let observation = ValueObservation.trackingIncrementally(Player.all())
+        
+        let recorder = observation.record(in: dbQueue)
+        try dbQueue.write { db in
+            // Deletes the row 1 without notifying the deletion
+            try db.execute(sql: "INSERT OR REPLACE INTO t (id, name, score) VALUES (3, 'foo', 1)")
+        }
+        let results = try wait(for: recorder.next(2), timeout: 1)
+        
+        XCTAssertEqual(results[1].updatedRowIDs, [3])
+        XCTAssertEqual(results[1].deletedRowIDs, [1])
+        XCTAssertEqual(Set(results[1].recordsByRowID.keys), [2, 3])
+    }
+    
+    func testUntrackableRequest() throws {
+        // Limited requests are fully refetched
+        try assertValueObservation(
+            ValueObservation
+                .trackingIncrementally(Player.order(Column("id")).limit(1))
+                .map { $0.recordsByRowID.values.sorted { $0.id < $1.id } },
+            records: [
+                [],
+                [Player(id: 2, name: "bar", score: 0)],
+                [Player(id: 1, name: "foo", score: 0)]],
+            setup: setup,
+            recordedUpdates: { db in
+                try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (2, 'bar', 0)")
+                try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (1, 'foo', 0)")
+        })
+    }
+    
+    func testCoalescedChanges() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write(setup)
+        let observation = ValueObservation.trackingIncrementally(Player.all())
+        
+        let recorder = observation.record(
+            in: dbQueue,
+            scheduling: .async(onQueue: .main).coalescing(.init(window: 0.5)))
+        try dbQueue.writeWithoutTransaction { db in
+            try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (1, 'foo', 0)")
+            try db.execute(sql: "INSERT INTO t (id, name, score) VALUES (2, 'bar', 0)")
+            try db.execute(sql: "UPDATE t SET score = 1 WHERE id = 1")
+        }
+        let results = try wait(for: recorder.next(2), timeout: 2)
+        
+        XCTAssertEqual(results[1].updatedRowIDs, [1, 2])
+        XCTAssertEqual(results[1].recordsByRowID[1], Player(id: 1, name: "foo", score: 1))
+    }
+}
@@ -341,6 +341,80 @@ class ValueObservationTests: GRDBTestCase {
         #endif
     }
     
+    // MARK: - Coalescing
+    
+    func testTrailingCoalescing() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try db.execute(sql: "CREATE TABLE t(id INTEGER PRIMARY KEY AUTOINCREMENT)")
+        }
+        
+        var fetchCount = 0
+        let observation = ValueObservation.trackingConstantRegion { db -> Int in
+            fetchCount += 1
+            return try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM t")!
+        }
+        let recorder = observation.record(
+            in: dbQueue,
+            scheduling: .async(onQueue: .main).coalescing(.init(window: 0.5)))
+        try dbQueue.writeWithoutTransaction { db in
+            for _ in 0..<10 {
+                try db.execute(sql: "INSERT INTO t DEFAULT VALUES")
+            }
+        }
+        let results = try wait(for: recorder.next(2), timeout: 2)
+        XCTAssertEqual(results, [0, 10])
+        XCTAssertEqual(fetchCount, 2)
+    }
+    
+    func testLeadingCoalescing() throws {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try db.execute(sql: "CREATE TABLE t(id INTEGER PRIMARY KEY AUTOINCREMENT)")
+        }
+        
+        let observation = ValueObservation.trackingConstantRegion { db in
+            try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM t")!
+        }
+        let recorder = observation.record(
+            in: dbQueue,
+            scheduling: .async(onQueue: .main).coalescing(.init(window: 0.5, edge: .leading)))
+        try dbQueue.writeWithoutTransaction { db in
+            for _ in 0..<5 {
+                try db.execute(sql: "INSERT INTO t DEFAULT VALUES")
+            }
+        }
+        let results = try wait(for: recorder.next(3), timeout: 2)
+        XCTAssertEqual(results, [0, 1, 5])
+    }
+    
+    func testCoalescingMaximumPendingChangeCount() throws {
+        func test(_ dbWriter: DatabaseWriter) throws {
+            try dbWriter.write { db in
+                try db.execute(sql: "CREATE TABLE t(id INTEGER PRIMARY KEY AUTOINCREMENT)")
+            }
+            
+            let observation = ValueObservation.trackingConstantRegion { db in
+                try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM t")!
+            }
+            let recorder = observation.record(
+                in: dbWriter,
+                scheduling: .async(onQueue: .main).coalescing(.init(
+                    window: 60,
+                    maximumPendingChangeCount: 3)))
+            try dbWriter.writeWithoutTransaction { db in
+                for _ in 0..<6 {
+                    try db.execute(sql: "INSERT INTO t DEFAULT VALUES")
+                }
+            }
+            let results = try wait(for: recorder.next(3), timeout: 2)
+            XCTAssertEqual(results.last, 6)
+        }
+        
+        try test(makeDatabaseQueue())
+        try test(makeDatabasePool())
+    }
+    
     // MARK: - Cancellation
     
     func testCancellableLifetime() throws {
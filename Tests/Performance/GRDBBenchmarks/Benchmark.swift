@@ -0,0 +1,163 @@
+import Foundation
+
+/// A benchmark measures the duration of an operation.
+struct Benchmark {
+    /// The name of the benchmark, used to match baselines
+    var name: String
+    
+    /// The number of operations performed by each run
+    var operationCount: Int
+    
+    /// Prepares the benchmark, and returns a closure that performs one run
+    /// and returns its duration, in seconds.
+    ///
+    /// Preparation is not measured.
+    var setUp: () throws -> () throws -> TimeInterval
+    
+    init(
+        name: String,
+        operationCount: Int,
+        setUp: @escaping () throws -> () throws -> TimeInterval)
+    {
+        self.name = name
+        self.operationCount = operationCount
+        self.setUp = setUp
+    }
+    
+    /// Creates a benchmark which measures the duration of the closure
+    /// returned by `setUp`.
+    static func timing(
+        name: String,
+        operationCount: Int,
+        setUp: @escaping () throws -> () throws -> Void)
+    -> Benchmark
+    {
+        Benchmark(name: name, operationCount: operationCount) {
+            let operation = try setUp()
+            return { try measure(operation) }
+        }
+    }
+    
+    /// Runs the benchmark several times, and returns the measured durations.
+    func run(iterations: Int, warmUpIterations: Int) throws -> BenchmarkResult {
+        let run = try setUp()
+        for _ in 0..<warmUpIterations {
+            _ = try run()
+        }
+        var durations: [TimeInterval] = []
+        durations.reserveCapacity(iterations)
+        for _ in 0..<iterations {
+            try durations.append(run())
+        }
+        return BenchmarkResult(name: name, operationCount: operationCount, durations: durations)
+    }
+}
+
+/// Returns the duration of the operation, in seconds.
+func measure(_ operation: () throws -> Void) rethrows -> TimeInterval {
+    let start = DispatchTime.now().uptimeNanoseconds
+    try operation()
+    let end = DispatchTime.now().uptimeNanoseconds
+    return TimeInterval(end - start) / 1_000_000_000
+}
+
+// MARK: - Results
+
+/// The result of a benchmark.
+struct BenchmarkResult: Codable {
+    var name: String
+    var operationCount: Int
+    
+    /// The median duration of a run, in seconds
+    var median: TimeInterval
+    
+    /// The shortest duration of a run, in seconds
+    var min: TimeInterval
+    
+    /// The longest duration of a run, in seconds
+    var max: TimeInterval
+    
+    /// The number of operations per second, based on the median duration
+    var operationsPerSecond: Double
+    
+    init(name: String, operationCount: Int, durations: [TimeInterval]) {
+        let sortedDurations = durations.sorted()
+        let median: TimeInterval
+        if sortedDurations.count % 2 == 0 {
+            let index = sortedDurations.count / 2
+            median = (sortedDurations[index - 1] + sortedDurations[index]) / 2
+        } else {
+            median = sortedDurations[sortedDurations.count / 2]
+        }
+        self.name = name
+        self.operationCount = operationCount
+        self.median = median
+        self.min = sortedDurations.first!
+        self.max = sortedDurations.last!
+        self.operationsPerSecond = median > 0 ? Double(operationCount) / median : 0
+    }
+}
+
+/// A benchmark report, encoded as JSON.
+struct BenchmarkReport: Codable {
+    /// The SQLite version
+    var sqliteVersion: String
+    
+    /// The number of active processors
+    var processorCount: Int
+    
+    /// The number of measured runs of each benchmark
+    var iterations: Int
+    
+    var results: [BenchmarkResult]
+    
+    static func load(from url: URL) throws -> BenchmarkReport {
+        let data = try Data(contentsOf: url)
+        return try JSONDecoder().decode(BenchmarkReport.self, from: data)
+    }
+    
+    func write(to url: URL) throws {
+        let encoder = JSONEncoder()
+        encoder.outputFormatting = .prettyPrinted
+        try encoder.encode(self).write(to: url)
+    }
+}
+
+// MARK: - Baseline Comparison
+
+/// The comparison of a benchmark result with its baseline.
+struct BenchmarkComparison {
+    var result: BenchmarkResult
+    var baseline: BenchmarkResult?
+    
+    /// The ratio of the median duration to the baseline median duration.
+    /// Greater than one when the benchmark got slower.
+    var ratio: Double? {
+        guard let baseline = baseline, baseline.median > 0 else {
+            return nil
+        }
+        return result.median / baseline.median
+    }
+    
+    /// Returns whether the benchmark is slower than its baseline, beyond
+    /// the tolerance (0.1 means 10% slower).
+    func isRegression(tolerance: Double) -> Bool {
+        guard let ratio = ratio else {
+            return false
+        }
+        return ratio > 1 + tolerance
+    }
+}
+
+extension BenchmarkReport {
+    /// Compares results with the results of a baseline report.
+    func compare(to baseline: BenchmarkReport) -> [BenchmarkComparison] {
+        var baselineResults: [String: BenchmarkResult] = [:]
+        for result in baseline.results {
+            baselineResults[result.name] = result
+        }
+        return results.map { result in
+            BenchmarkComparison(result: result, baseline: baselineResults[result.name])
+        }
+    }
+}
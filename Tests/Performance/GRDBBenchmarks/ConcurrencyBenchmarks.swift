@@ -0,0 +1,186 @@
+import Foundation
+import GRDB
+
+/// Benchmarks of concurrent database accesses.
+enum ConcurrencyBenchmarks {
+    static var all: [Benchmark] {
+        poolReadScaling + writeThroughputWithObservers + [observationLatency]
+    }
+    
+    /// Reads performed by as many concurrent readers as the number of
+    /// active processors allows.
+    static var poolReadScaling: [Benchmark] {
+        let processorCount = ProcessInfo.processInfo.activeProcessorCount
+        var readerCounts = [1, 2, 4, 8, 16].filter { $0 < processorCount }
+        readerCounts.append(processorCount)
+        
+        let readCount = 2000
+        return readerCounts.map { readerCount in
+            Benchmark.timing(name: "pool.read.readers\(readerCount)", operationCount: readCount) {
+                var configuration = Configuration()
+                configuration.maximumReaderCount = readerCount
+                let dbPool = try makeDatabasePool(configuration: configuration)
+                try dbPool.write { db in
+                    try createItems(db, count: 100)
+                }
+                return {
+                    DispatchQueue.concurrentPerform(iterations: readCount) { _ in
+                        _ = try! dbPool.read { db in
+                            try Int.fetchAll(db, sql: "SELECT i0 FROM item")
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    /// Insertions in a database observed by transaction observers.
+    static var writeThroughputWithObservers: [Benchmark] {
+        let transactionCount = 100
+        let insertCount = 10
+        return [0, 10, 100].map { observerCount in
+            Benchmark.timing(
+                name: "queue.write.observers\(observerCount)",
+                operationCount: transactionCount * insertCount)
+            {
+                let dbQueue = try makeDatabaseQueue()
+                try dbQueue.write { db in
+                    try createItems(db, count: 0)
+                }
+                for _ in 0..<observerCount {
+                    dbQueue.add(transactionObserver: ItemObserver(), extent: .databaseLifetime)
+                }
+                return {
+                    for _ in 0..<transactionCount {
+                        try dbQueue.write { db in
+                            let statement = try db.cachedUpdateStatement(sql: """
+                                INSERT INTO item (i0, i1, i2, i3, i4, i5, i6, i7, i8, i9) \
+                                VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+                                """)
+                            for i in 0..<insertCount {
+                                try statement.execute(arguments: [i, i, i, i, i, i, i, i, i, i])
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+    
+    /// The duration between a commit and the notification of a
+    /// ValueObservation, while concurrent writes are committed in
+    /// unobserved tables.
+    static var observationLatency: Benchmark {
+        let commitCount = 100
+        return Benchmark(name: "observation.latency", operationCount: commitCount) {
+            let dbPool = try makeDatabasePool()
+            try dbPool.write { db in
+                try createItems(db, count: 0)
+                try db.execute(sql: "CREATE TABLE other (value INTEGER)")
+            }
+            let observation = ValueObservation.tracking { db in
+                try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM item")!
+            }
+            
+            return {
+                let lock = NSLock()
+                var observedCount = -1
+                let semaphore = DispatchSemaphore(value: 0)
+                let cancellable = observation.start(
+                    in: dbPool,
+                    scheduling: .async(onQueue: DispatchQueue(label: "GRDBBenchmarks.observation")),
+                    onError: { error in fatalError("\(error)") },
+                    onChange: { count in
+                        lock.lock()
+                        observedCount = count
+                        lock.unlock()
+                        semaphore.signal()
+                    })
+                defer { cancellable.cancel() }
+                
+                func waitForCount(_ count: Int) {
+                    while true {
+                        lock.lock()
+                        let isNotified = observedCount >= count
+                        lock.unlock()
+                        if isNotified { return }
+                        semaphore.wait()
+                    }
+                }
+                
+                let initialCount = try dbPool.read { db in
+                    try Int.fetchOne(db, sql: "SELECT COUNT(*) FROM item")!
+                }
+                waitForCount(initialCount)
+                
+                // Commit load
+                let load = CommitLoad(dbPool: dbPool)
+                load.start()
+                defer { load.stop() }
+                
+                return try measure {
+                    for i in 1...commitCount {
+                        try dbPool.write { db in
+                            try db.execute(sql: "INSERT INTO item (i0) VALUES (?)", arguments: [i])
+                        }
+                        waitForCount(initialCount + i)
+                    }
+                }
+            }
+        }
+    }
+}
+
+/// A transaction observer of the item table.
+private class ItemObserver: TransactionObserver {
+    var changeCount = 0
+    
+    func observes(eventsOfKind eventKind: DatabaseEventKind) -> Bool {
+        eventKind.tableName == "item"
+    }
+    
+    func databaseDidChange(with event: DatabaseEvent) {
+        changeCount += 1
+    }
+    
+    func databaseDidCommit(_ db: Database) { }
+    func databaseDidRollback(_ db: Database) { }
+}
+
+/// Writes in the `other` table, in a background thread.
+private final class CommitLoad {
+    private let dbPool: DatabasePool
+    private let lock = NSLock()
+    private var isRunning = false
+    private let group = DispatchGroup()
+    
+    init(dbPool: DatabasePool) {
+        self.dbPool = dbPool
+    }
+    
+    func start() {
+        lock.lock()
+        isRunning = true
+        lock.unlock()
+        DispatchQueue.global().async(group: group) {
+            while self.checkIsRunning() {
+                try! self.dbPool.write { db in
+                    try db.execute(sql: "INSERT INTO other (value) VALUES (1)")
+                }
+            }
+        }
+    }
+    
+    func stop() {
+        lock.lock()
+        isRunning = false
+        lock.unlock()
+        group.wait()
+    }
+    
+    private func checkIsRunning() -> Bool {
+        lock.lock()
+        defer { lock.unlock() }
+        return isRunning
+    }
+}
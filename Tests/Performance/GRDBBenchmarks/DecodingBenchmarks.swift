@@ -0,0 +1,144 @@
+import Foundation
+import GRDB
+
+private struct Author: Decodable, FetchableRecord, TableRecord {
+    static let books = hasMany(Book.self)
+    var id: Int64
+    var name: String
+    var country: String
+}
+
+private struct Book: Decodable, FetchableRecord, TableRecord {
+    static let author = belongsTo(Author.self)
+    var id: Int64
+    var authorId: Int64
+    var title: String
+    var year: Int
+}
+
+/// Decoded from associated rows with Decodable
+private struct BookInfo: Decodable, FetchableRecord {
+    var book: Book
+    var author: Author
+}
+
+/// Decoded from associated rows with row scopes
+private struct BookRowInfo: FetchableRecord {
+    var title: String
+    var authorName: String
+    
+    init(row: Row) {
+        title = row["title"]
+        authorName = row.scopes["author"]!["name"]
+    }
+}
+
+/// Decoded from prefetched rows
+private struct AuthorInfo: Decodable, FetchableRecord {
+    var author: Author
+    var books: [Book]
+}
+
+/// Benchmarks of the decoding of associated records.
+enum DecodingBenchmarks {
+    static let authorCount = 200
+    static let booksPerAuthor = 10
+    
+    static var all: [Benchmark] {
+        [includingDecodable, includingRowScopes, includingAllDecodable, rowAdapter]
+    }
+    
+    static var includingDecodable: Benchmark {
+        Benchmark.timing(
+            name: "decoding.includingRequired.decodable",
+            operationCount: authorCount * booksPerAuthor)
+        {
+            let dbQueue = try makeLibrary()
+            let request = Book.including(required: Book.author).asRequest(of: BookInfo.self)
+            return {
+                _ = try dbQueue.read(request.fetchAll)
+            }
+        }
+    }
+    
+    static var includingRowScopes: Benchmark {
+        Benchmark.timing(
+            name: "decoding.includingRequired.rowScopes",
+            operationCount: authorCount * booksPerAuthor)
+        {
+            let dbQueue = try makeLibrary()
+            let request = Book.including(required: Book.author).asRequest(of: BookRowInfo.self)
+            return {
+                _ = try dbQueue.read(request.fetchAll)
+            }
+        }
+    }
+    
+    static var includingAllDecodable: Benchmark {
+        Benchmark.timing(
+            name: "decoding.includingAll.decodable",
+            operationCount: authorCount * booksPerAuthor)
+        {
+            let dbQueue = try makeLibrary()
+            let request = Author.including(all: Author.books).asRequest(of: AuthorInfo.self)
+            return {
+                _ = try dbQueue.read(request.fetchAll)
+            }
+        }
+    }
+    
+    static var rowAdapter: Benchmark {
+        Benchmark.timing(
+            name: "decoding.rowAdapter.scopes",
+            operationCount: authorCount * booksPerAuthor)
+        {
+            let dbQueue = try makeLibrary()
+            let sql = """
+                SELECT book.*, author.* FROM book JOIN author ON author.id = book.authorId
+                """
+            return {
+                try dbQueue.read { db in
+                    let adapters = try splittingRowAdapters(columnCounts: [
+                        db.columns(in: "book").count,
+                        db.columns(in: "author").count])
+                    let rows = try Row.fetchCursor(
+                        db, sql: sql,
+                        adapter: ScopeAdapter(["book": adapters[0], "author": adapters[1]]))
+                    while let row = try rows.next() {
+                        _ = Book(row: row.scopes["book"]!)
+                        _ = Author(row: row.scopes["author"]!)
+                    }
+                }
+            }
+        }
+    }
+    
+    private static func makeLibrary() throws -> DatabaseQueue {
+        let dbQueue = try makeDatabaseQueue()
+        try dbQueue.write { db in
+            try db.create(table: "author") { t in
+                t.autoIncrementedPrimaryKey("id")
+                t.column("name", .text).notNull()
+                t.column("country", .text).notNull()
+            }
+            try db.create(table: "book") { t in
+                t.autoIncrementedPrimaryKey("id")
+                t.column("authorId", .integer).notNull().indexed().references("author")
+                t.column("title", .text).notNull()
+                t.column("year", .integer).notNull()
+            }
+            for authorIndex in 0..<authorCount {
+                try db.execute(
+                    sql: "INSERT INTO author (name, country) VALUES (?, ?)",
+                    arguments: ["Author \(authorIndex)", "Country \(authorIndex % 10)"])
+                let authorId = db.lastInsertedRowID
+                for bookIndex in 0..<booksPerAuthor {
+                    try db.execute(
+                        sql: "INSERT INTO book (authorId, title, year) VALUES (?, ?, ?)",
+                        arguments: [authorId, "Book \(bookIndex)", 1900 + bookIndex])
+                }
+            }
+        }
+        return dbQueue
+    }
+}
@@ -0,0 +1,97 @@
+import Foundation
+import GRDB
+
+private struct Document: TableRecord { }
+
+/// Benchmarks of full-text indexing and search.
+///
+/// FTS5 benchmarks are only compiled with the SQLITE_ENABLE_FTS5 flag, as in
+/// `make benchmark`.
+enum FTSBenchmarks {
+    static let documentCount = 2000
+    static let wordsPerDocument = 50
+    
+    static var all: [Benchmark] {
+        var benchmarks = [fts4Indexing, fts4Search]
+        #if SQLITE_ENABLE_FTS5
+        benchmarks.append(fts5Indexing(
+            name: "fts5.indexing.unicode61",
+            tokenizer: .unicode61()))
+        benchmarks.append(fts5Indexing(
+            name: "fts5.indexing.latin",
+            tokenizer: FTS5LatinTokenizer.tokenizerDescriptor()))
+        #endif
+        return benchmarks
+    }
+    
+    static var fts4Indexing: Benchmark {
+        Benchmark.timing(name: "fts4.indexing", operationCount: documentCount) {
+            let dbQueue = try makeDatabaseQueue()
+            let texts = makeTexts()
+            return {
+                try dbQueue.write { db in
+                    try db.execute(sql: "DROP TABLE IF EXISTS document")
+                    try db.create(virtualTable: "document", using: FTS4()) { t in
+                        t.column("content")
+                    }
+                    try insert(texts, in: db)
+                }
+            }
+        }
+    }
+    
+    static var fts4Search: Benchmark {
+        let searchCount = 100
+        return Benchmark.timing(name: "fts4.search", operationCount: searchCount) {
+            let dbQueue = try makeDatabaseQueue()
+            try dbQueue.write { db in
+                try db.create(virtualTable: "document", using: FTS4()) { t in
+                    t.column("content")
+                }
+                try insert(makeTexts(), in: db)
+            }
+            let request = Document.matching(FTS3Pattern(matchingAllTokensIn: "lorem dolor"))
+            return {
+                try dbQueue.read { db in
+                    for _ in 0..<searchCount {
+                        _ = try Row.fetchAll(db, request)
+                    }
+                }
+            }
+        }
+    }
+    
+    #if SQLITE_ENABLE_FTS5
+    static func fts5Indexing(name: String, tokenizer: FTS5TokenizerDescriptor) -> Benchmark {
+        Benchmark.timing(name: name, operationCount: documentCount) {
+            var configuration = Configuration()
+            configuration.prepareDatabase { db in
+                db.add(tokenizer: FTS5LatinTokenizer.self)
+            }
+            let dbQueue = try makeDatabaseQueue(configuration: configuration)
+            let texts = makeTexts()
+            return {
+                try dbQueue.write { db in
+                    try db.execute(sql: "DROP TABLE IF EXISTS document")
+                    try db.create(virtualTable: "document", using: FTS5()) { t in
+                        t.tokenizer = tokenizer
+                        t.column("content")
+                    }
+                    try insert(texts, in: db)
+                }
+            }
+        }
+    }
+    #endif
+    
+    private static func makeTexts() -> [String] {
+        (0..<documentCount).map { makeText(wordCount: wordsPerDocument, seed: $0) }
+    }
+    
+    private static func insert(_ texts: [String], in db: Database) throws {
+        let statement = try db.makeUpdateStatement(sql: "INSERT INTO document (content) VALUES (?)")
+        for text in texts {
+            try statement.execute(arguments: [text])
+        }
+    }
+}
@@ -0,0 +1,88 @@
+import Foundation
+import GRDB
+
+private struct Team: TableRecord {
+    static let players = hasMany(Player.self)
+}
+
+private struct Player: TableRecord {
+    static let team = belongsTo(Team.self)
+    static let awards = hasMany(Award.self)
+}
+
+private struct Award: TableRecord { }
+
+/// Benchmarks of SQL generation.
+///
+/// Generated SQL is compiled by SQLite into a prepared statement: the
+/// measured durations include the cost of SQLite compilation.
+enum SQLGenerationBenchmarks {
+    static let requestCount = 1000
+    
+    static var all: [Benchmark] {
+        [queryInterface, associations, sqlInterpolation]
+    }
+    
+    static var queryInterface: Benchmark {
+        benchmark(name: "sqlGeneration.queryInterface") {
+            Player
+                .select(Column("id"), Column("name"), Column("score"))
+                .filter(Column("score") > 1000 && Column("name") != nil)
+                .order(Column("score").desc, Column("name"))
+                .limit(10, offset: 20)
+        }
+    }
+    
+    static var associations: Benchmark {
+        benchmark(name: "sqlGeneration.associations") {
+            Player
+                .including(required: Player.team.filter(Column("name") != nil))
+                .annotated(with: Player.awards.count)
+                .having(!Player.awards.isEmpty)
+                .order(Column("score").desc)
+        }
+    }
+    
+    static var sqlInterpolation: Benchmark {
+        benchmark(name: "sqlGeneration.sqlInterpolation") {
+            let score = 1000
+            let name = "Arthur"
+            let request: SQLRequest<Row> = """
+                SELECT \(Column("id")), \(Column("name")) FROM \(Player.self) \
+                WHERE \(Column("score")) > \(score) AND \(Column("name")) <> \(name)
+                """
+            return request
+        }
+    }
+    
+    private static func benchmark<Request: FetchRequest>(
+        name: String,
+        request makeRequest: @escaping () -> Request)
+    -> Benchmark
+    {
+        Benchmark.timing(name: name, operationCount: requestCount) {
+            let dbQueue = try makeDatabaseQueue()
+            try dbQueue.write { db in
+                try db.execute(sql: """
+                    CREATE TABLE team (id INTEGER PRIMARY KEY, name TEXT);
+                    CREATE TABLE player (
+                        id INTEGER PRIMARY KEY,
+                        teamId INTEGER REFERENCES team(id),
+                        name TEXT,
+                        score INTEGER);
+                    CREATE TABLE award (
+                        id INTEGER PRIMARY KEY,
+                        playerId INTEGER REFERENCES player(id),
+                        name TEXT);
+                    """)
+            }
+            return {
+                try dbQueue.read { db in
+                    for _ in 0..<requestCount {
+                        _ = try makeRequest().makePreparedRequest(db, forSingleResult: false)
+                    }
+                }
+            }
+        }
+    }
+}
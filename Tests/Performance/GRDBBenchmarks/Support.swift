@@ -0,0 +1,63 @@
+import Foundation
+import GRDB
+
+/// The directory of benchmark databases. It is deleted after all
+/// benchmarks have run.
+let databaseDirectoryURL: URL = {
+    let url = URL(fileURLWithPath: NSTemporaryDirectory())
+        .appendingPathComponent("GRDBBenchmarks", isDirectory: true)
+        .appendingPathComponent(ProcessInfo.processInfo.globallyUniqueString, isDirectory: true)
+    try! FileManager.default.createDirectory(at: url, withIntermediateDirectories: true, attributes: nil)
+    return url
+}()
+
+private var databaseCount = 0
+
+/// Returns the path to a new database file.
+func makeDatabasePath() -> String {
+    databaseCount += 1
+    return databaseDirectoryURL.appendingPathComponent("db\(databaseCount).sqlite").path
+}
+
+func makeDatabaseQueue(configuration: Configuration = Configuration()) throws -> DatabaseQueue {
+    try DatabaseQueue(path: makeDatabasePath(), configuration: configuration)
+}
+
+func makeDatabasePool(configuration: Configuration = Configuration()) throws -> DatabasePool {
+    try DatabasePool(path: makeDatabasePath(), configuration: configuration)
+}
+
+/// Creates the item table, filled with `count` rows.
+func createItems(_ db: Database, count: Int) throws {
+    try db.execute(sql: """
+        CREATE TABLE item (
+            id INTEGER PRIMARY KEY,
+            i0 INTEGER, i1 INTEGER, i2 INTEGER, i3 INTEGER, i4 INTEGER,
+            i5 INTEGER, i6 INTEGER, i7 INTEGER, i8 INTEGER, i9 INTEGER)
+        """)
+    let statement = try db.makeUpdateStatement(sql: """
+        INSERT INTO item (i0, i1, i2, i3, i4, i5, i6, i7, i8, i9) \
+        VALUES (?, ?, ?, ?, ?, ?, ?, ?, ?, ?)
+        """)
+    for i in 0..<count {
+        try statement.execute(arguments: [i, i, i, i, i, i, i, i, i, i])
+    }
+}
+
+/// Returns a text made of `wordCount` pseudo-random words.
+func makeText(wordCount: Int, seed: Int) -> String {
+    let words = [
+        "lorem", "ipsum", "dolor", "sit", "amet", "consectetur", "adipiscing",
+        "elit", "sed", "do", "eiusmod", "tempor", "incididunt", "ut", "labore",
+        "et", "dolore", "magna", "aliqua", "enim", "ad", "minim", "veniam",
+        "quis", "nostrud", "exercitation", "ullamco", "laboris", "nisi",
+        "aliquip", "ex", "ea", "commodo", "consequat"]
+    // Linear congruential generator: benchmarks are deterministic
+    var state = UInt32(truncatingIfNeeded: seed)
+    return (0..<wordCount)
+        .map { _ -> String in
+            state = state &* 1_664_525 &+ 1_013_904_223
+            return words[Int(state >> 16) % words.count]
+        }
+        .joined(separator: " ")
+}
@@ -0,0 +1,116 @@
+// GRDBBenchmarks runs GRDB benchmarks, and writes their results as JSON.
+//
+//     swift run -c release GRDBBenchmarks [options]
+//
+// Options:
+//
+//     --filter <string>     Only run benchmarks whose name contains <string>
+//     --iterations <n>      Number of measured runs (default 10)
+//     --output <path>       Write the JSON report to <path>
+//     --baseline <path>     Compare results with the JSON report at <path>
+//     --tolerance <ratio>   Accepted slowdown before a result is reported
+//                           as a regression (default 0.1, for 10%)
+//
+// The process exits with a non-zero status when a benchmark is slower than
+// its baseline, beyond the tolerance.
+import Foundation
+import GRDB
+
+struct Options {
+    var filter: String?
+    var iterations = 10
+    var outputPath: String?
+    var baselinePath: String?
+    var tolerance = 0.1
+    
+    init(arguments: [String]) {
+        var arguments = arguments[...]
+        while let argument = arguments.popFirst() {
+            switch argument {
+            case "--filter":
+                filter = Options.value(of: argument, in: &arguments)
+            case "--iterations":
+                guard let iterations = Int(Options.value(of: argument, in: &arguments)), iterations > 0 else {
+                    Options.exit(withUsageError: "--iterations requires a positive integer")
+                }
+                self.iterations = iterations
+            case "--output":
+                outputPath = Options.value(of: argument, in: &arguments)
+            case "--baseline":
+                baselinePath = Options.value(of: argument, in: &arguments)
+            case "--tolerance":
+                guard let tolerance = Double(Options.value(of: argument, in: &arguments)), tolerance >= 0 else {
+                    Options.exit(withUsageError: "--tolerance requires a non-negative number")
+                }
+                self.tolerance = tolerance
+            default:
+                Options.exit(withUsageError: "unknown argument \(argument)")
+            }
+        }
+    }
+    
+    private static func value(of option: String, in arguments: inout ArraySlice<String>) -> String {
+        guard let value = arguments.popFirst() else {
+            exit(withUsageError: "\(option) requires a value")
+        }
+        return value
+    }
+    
+    private static func exit(withUsageError message: String) -> Never {
+        FileHandle.standardError.write("GRDBBenchmarks: \(message)\n".data(using: .utf8)!)
+        Foundation.exit(2)
+    }
+}
+
+let options = Options(arguments: Array(CommandLine.arguments.dropFirst()))
+
+let benchmarks = (ConcurrencyBenchmarks.all
+    + DecodingBenchmarks.all
+    + FTSBenchmarks.all
+    + SQLGenerationBenchmarks.all)
+    .filter { benchmark in
+        options.filter.map { benchmark.name.contains($0) } ?? true
+    }
+
+var results: [BenchmarkResult] = []
+for benchmark in benchmarks {
+    let result = try benchmark.run(iterations: options.iterations, warmUpIterations: 1)
+    print("\(result.name): median \(String(format: "%.6f", result.median))s, "
+        + "\(String(format: "%.0f", result.operationsPerSecond)) ops/s")
+    results.append(result)
+}
+try? FileManager.default.removeItem(at: databaseDirectoryURL)
+
+let sqliteVersion = try DatabaseQueue().read { db in
+    try String.fetchOne(db, sql: "SELECT sqlite_version()")!
+}
+let report = BenchmarkReport(
+    sqliteVersion: sqliteVersion,
+    processorCount: ProcessInfo.processInfo.activeProcessorCount,
+    iterations: options.iterations,
+    results: results)
+
+if let outputPath = options.outputPath {
+    try report.write(to: URL(fileURLWithPath: outputPath))
+}
+
+if let baselinePath = options.baselinePath {
+    let baseline = try BenchmarkReport.load(from: URL(fileURLWithPath: baselinePath))
+    var regressionCount = 0
+    for comparison in report.compare(to: baseline) {
+        guard let ratio = comparison.ratio else {
+            print("\(comparison.result.name): no baseline")
+            continue
+        }
+        let isRegression = comparison.isRegression(tolerance: options.tolerance)
+        if isRegression {
+            regressionCount += 1
+        }
+        let change = String(format: "%+.1f%%", (ratio - 1) * 100)
+        print("\(comparison.result.name): \(change)\(isRegression ? " REGRESSION" : "")")
+    }
+    if regressionCount > 0 {
+        print("\(regressionCount) regression(s) above \(Int(options.tolerance * 100))% tolerance")
+        exit(1)
+    }
+}
@@ -32,4 +32,35 @@ class DateParsingTests: XCTestCase {
             }
         }
     }
+    
+    func testParseDateFromRow() {
+        measure {
+            try! DatabaseQueue().inDatabase { db in
+                let cursor = try Row.fetchCursor(db, sql: request)
+                while let row = try cursor.next() {
+                    _ = row[0] as Date
+                }
+            }
+        }
+    }
+    
+    func testParseDateFromDatabaseValue() {
+        let dbValue = "2018-04-20 14:47:12.345".databaseValue
+        measure {
+            for _ in 0..<50000 {
+                _ = Date.fromDatabaseValue(dbValue)
+            }
+        }
+    }
+    
+    func testParseNonCanonicalDate() {
+        // Not the storage format: decoded with Calendar
+        let request = self.request.replacingOccurrences(of: "14:47:12.345", with: "14:47:12")
+        measure {
+            try! DatabaseQueue().inDatabase { db in
+                let cursor = try Date.fetchCursor(db, sql: request)
+                while try cursor.next() != nil { }
+            }
+        }
+    }
 }
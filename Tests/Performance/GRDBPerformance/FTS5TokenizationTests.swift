@@ -0,0 +1,66 @@
+// FTS5 is only available when GRDB is compiled with the SQLITE_ENABLE_FTS5
+// flag, as in `make test_performance`.
+#if SQLITE_ENABLE_FTS5
+import XCTest
+import GRDB
+
+private let documentCount = 5_000
+
+// A wrapper tokenizer that notifies tokens of unicode61 unmodified.
+private final class PassThroughTokenizer: FTS5WrapperTokenizer {
+    static let name = "passthrough"
+    let wrappedTokenizer: FTS5Tokenizer
+    
+    init(db: Database, arguments: [String]) throws {
+        wrappedTokenizer = try db.makeTokenizer(.unicode61())
+    }
+    
+    func accept(token: String, flags: FTS5TokenFlags, for tokenization: FTS5Tokenization, tokenCallback: FTS5WrapperTokenCallback) throws {
+        try tokenCallback(token, flags)
+    }
+}
+
+// Measures the throughput of FTS5 tokenizers, by indexing documents.
+//
+// Requires GRDB to be compiled with the SQLITE_ENABLE_FTS5 flag.
+class FTS5TokenizationTests: XCTestCase {
+    let documents: [String] = (0..<documentCount).map { index in
+        """
+        Document \(index): Lorem ipsum dolor sit amet, consectetur adipiscing elit, \
+        sed do eiusmod tempor incididunt ut labore et dolore magna aliqua. \
+        L'élève a mangé une crème brûlée au café, près de la forêt. \
+        Ut enim ad minim veniam, quis nostrud exercitation ullamco laboris.
+        """
+    }
+    
+    func testUnicode61Tokenizer() {
+        measureIndexing(tokenizer: .unicode61())
+    }
+    
+    func testWrapperTokenizer() {
+        measureIndexing(tokenizer: PassThroughTokenizer.tokenizerDescriptor())
+    }
+    
+    func testLatinTokenizer() {
+        measureIndexing(tokenizer: FTS5LatinTokenizer.tokenizerDescriptor())
+    }
+    
+    private func measureIndexing(tokenizer: FTS5TokenizerDescriptor) {
+        measure {
+            let dbQueue = DatabaseQueue()
+            try! dbQueue.write { db in
+                db.add(tokenizer: PassThroughTokenizer.self)
+                db.add(tokenizer: FTS5LatinTokenizer.self)
+                try db.create(virtualTable: "document", using: FTS5()) { t in
+                    t.tokenizer = tokenizer
+                    t.column("content")
+                }
+                let statement = try db.makeUpdateStatement(sql: "INSERT INTO document(content) VALUES (?)")
+                for document in documents {
+                    try statement.execute(arguments: [document])
+                }
+            }
+        }
+    }
+}
+#endif